@@ -22,26 +22,28 @@
 #include "multimutex.h"
 
 #include <QtCore/QMutex>
-#include <QtCore/QReadWriteLock>
+#include <QtCore/QWaitCondition>
+#include <QtCore/QHash>
 #include <QtCore/QThread>
+#include <QtCore/QDebug>
 
 
 class MultiMutex::Private
 {
 public:
     Private()
-        : lockingThread( 0 ),
-          lockCnt( 0 ),
-          lockedForWrite( false ) {
+        : writingThread( 0 ),
+          waitingWriters( 0 ) {
     }
 
-    QReadWriteLock mainMutex;
-    QMutex lockMutex; // protects modification of fields below
-    QMutex readMutex; // makes sure only one thread can lock for read
+    QMutex mutex; // protects the fields below
+    QWaitCondition lockReleased;
 
-    QThread* lockingThread;
-    int lockCnt;
-    bool lockedForWrite;
+    // the number of read locks per thread
+    QHash<QThread*, int> readLocks;
+
+    QThread* writingThread;
+    int waitingWriters;
 };
 
 MultiMutex::MultiMutex()
@@ -58,44 +60,69 @@ MultiMutex::~MultiMutex()
 
 void MultiMutex::lockForRead()
 {
-    d->lockMutex.lock();
-    if ( d->lockingThread == QThread::currentThread() ) {
-        ++d->lockCnt;
-        d->lockMutex.unlock();
+    QThread* thread = QThread::currentThread();
+    QMutexLocker lock( &d->mutex );
+
+    QHash<QThread*, int>::iterator it = d->readLocks.find( thread );
+    if ( it != d->readLocks.end() ) {
+        // nested read locks never wait, otherwise a waiting writer would deadlock us
+        ++it.value();
+    }
+    else if ( d->writingThread == thread ) {
+        d->readLocks.insert( thread, 1 );
     }
     else {
-        d->lockMutex.unlock();
-        d->readMutex.lock();
-        d->mainMutex.lockForRead();
-        d->lockingThread = QThread::currentThread();
-        ++d->lockCnt;
+        // waiting writers take precedence to avoid writer starvation
+        while ( d->writingThread || d->waitingWriters > 0 ) {
+            d->lockReleased.wait( &d->mutex );
+        }
+        d->readLocks.insert( thread, 1 );
     }
 }
 
 
 void MultiMutex::lockForWrite()
 {
-    d->mainMutex.lockForWrite();
-    d->lockedForWrite = true;
+    QThread* thread = QThread::currentThread();
+    QMutexLocker lock( &d->mutex );
+
+    Q_ASSERT( !d->readLocks.contains( thread ) );
+
+    ++d->waitingWriters;
+    while ( d->writingThread || !d->readLocks.isEmpty() ) {
+        d->lockReleased.wait( &d->mutex );
+    }
+    --d->waitingWriters;
+    d->writingThread = thread;
 }
 
 
 void MultiMutex::unlock()
 {
-    d->lockMutex.lock();
-    if ( d->lockedForWrite ) {
-        d->lockedForWrite = false;
-        d->mainMutex.unlock();
-    }
+    unlock( QThread::currentThread() );
+}
 
-    else if ( d->lockingThread == QThread::currentThread() ) {
-        if ( --d->lockCnt == 0 ) {
-            d->lockingThread = 0;
-            d->mainMutex.unlock();
-            d->readMutex.unlock();
+
+void MultiMutex::unlock( QThread* thread )
+{
+    QMutexLocker lock( &d->mutex );
+
+    QHash<QThread*, int>::iterator it = d->readLocks.find( thread );
+    if ( it != d->readLocks.end() ) {
+        if ( --it.value() == 0 ) {
+            d->readLocks.erase( it );
+            if ( d->readLocks.isEmpty() ) {
+                d->lockReleased.wakeAll();
+            }
         }
     }
-    d->lockMutex.unlock();
+    else if ( d->writingThread == thread ) {
+        d->writingThread = 0;
+        d->lockReleased.wakeAll();
+    }
+    else {
+        qDebug() << "(MultiMutex) unlock called for a thread which does not hold a lock.";
+    }
 }
 
 
@@ -22,13 +22,22 @@
 #ifndef _MULTI_MUTEX_H_
 #define _MULTI_MUTEX_H_
 
+class QThread;
+
 /**
- * A MultiMutex is a mutex that can be locked by the same thread
- * an arbitrary number of times for reading. Once the same thread called 
- * unlock() the same number of times it called lock() the mutex
- * is released for real.
+ * A MultiMutex is a read-write lock that can be locked for reading by
+ * any number of threads at the same time. Each thread can lock it for
+ * reading an arbitrary number of times. Once the thread called unlock()
+ * the same number of times it called lockForRead() its read lock is
+ * released for real.
+ *
+ * Writing is only allowed once. A thread waiting for a write lock blocks
+ * new readers but not nested read locks of threads which already hold one.
+ * Thus, a thread can never deadlock on its own nested read locks.
  *
- * Writing is only allowed once.
+ * Read locks may be released from another thread than the locking
+ * one via unlock( QThread* ). This is used by iterators which are closed
+ * in a different thread.
  *
  * \sa QReadWriteLock
  */
@@ -40,8 +49,17 @@ public:
 
     void lockForRead();
     void lockForWrite();
+
+    /**
+     * Release the lock held by the current thread.
+     */
     void unlock();
 
+    /**
+     * Release the lock held by \p thread.
+     */
+    void unlock( QThread* thread );
+
 private:
     class Private;
     Private* const d;
@@ -112,6 +112,7 @@ Soprano::StorageModel* Soprano::Redland::BackendPlugin::createModel( const Backe
 
 //    World* world = new World();
     World* world = World::theWorld();
+    QMutexLocker worldLock( world->mutex() );
     // create a new storage
     librdf_storage* storage = librdf_new_storage( world->worldPtr(),
                                                   storageType.toUtf8().data(),
@@ -179,6 +180,14 @@ Soprano::BackendFeatures Soprano::Redland::BackendPlugin::supportedFeatures() co
              BackendFeatureRemoveStatements|
              BackendFeatureListStatements|
              BackendFeatureQuery|
-             BackendFeatureContext );
+             BackendFeatureContext|
+             BackendFeatureUser );
+}
+
+
+QStringList Soprano::Redland::BackendPlugin::supportedUserFeatures() const
+{
+    return QStringList() << QLatin1String( "batchWrites" )
+                         << QLatin1String( "nodeCacheStatistics" );
 }
 
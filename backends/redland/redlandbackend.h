@@ -56,6 +56,16 @@ namespace Soprano
 
             BackendFeatures supportedFeatures() const;
 
+            /**
+             * Supported user features are:
+             * \li batchWrites - The models provide the invokable methods
+             *     startBatch() and commitBatch() which defer syncing
+             *     the storage until the batch is committed.
+             * \li nodeCacheStatistics - The models provide the invokable methods
+             *     nodeCacheHits(), nodeCacheMisses() and resetNodeCacheStatistics().
+             */
+            QStringList supportedUserFeatures() const;
+
         private:
             mutable QMutex m_mutex;
         };
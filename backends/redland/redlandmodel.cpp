@@ -33,6 +33,9 @@
 #include "multimutex.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
+#include <QtCore/QThread>
+#include <QtCore/QMutexLocker>
 
 
 namespace {
@@ -51,6 +54,13 @@ namespace {
                    !librdf_statement_get_predicate( statement ) &&
                    !librdf_statement_get_object( statement ) ) );
     }
+
+    bool isCompleteStatement( const Soprano::Statement& statement )
+    {
+        return ( statement.subject().isValid() &&
+                 statement.predicate().isValid() &&
+                 statement.object().isValid() );
+    }
 }
 
 
@@ -60,18 +70,34 @@ public:
     Private() :
         world(0),
         model(0),
-        storage(0)
+        storage(0),
+        queryStatement(0),
+        batchLevel(0)
     {}
 
     World *world;
     librdf_model *model;
     librdf_storage *storage;
 
-    MultiMutex readWriteLock; // restricts multiple reads to one thread
+    // Reused for all lookups to avoid allocating a statement on each call.
+    // Calls into librdf are serialized anyway, thus one instance is enough.
+    // Protected by World::mutex().
+    librdf_statement* queryStatement;
 
-    QList<RedlandStatementIterator*> iterators;
-    QList<Redland::NodeIteratorBackend*> nodeIterators;
-    QList<RedlandQueryResult*> results;
+    // The number of open batches. Protected by World::mutex().
+    int batchLevel;
+
+    // Allows any number of concurrent readers. librdf itself is not thread-safe,
+    // thus all calls into it are additionally serialized through World::mutex().
+    // That mutex is only held for single calls, never for the lifetime of an iterator.
+    MultiMutex readWriteLock;
+
+    // Open iterators keep a read lock. We remember the locking thread
+    // since iterators may be closed from another thread.
+    // Protected by World::mutex().
+    QHash<RedlandStatementIterator*, QThread*> iterators;
+    QHash<Redland::NodeIteratorBackend*, QThread*> nodeIterators;
+    QHash<RedlandQueryResult*, QThread*> results;
 
     /**
      * librdf_model_find_statements_in_context does not support empty contexts. All in all
@@ -87,16 +113,75 @@ public:
      */
     int redlandContainsStatement( const Soprano::Statement& statement );
     int redlandContainsStatement( librdf_statement* statement, librdf_node* context );
+
+    /**
+     * Checks if \p statement exists in the default graph, i.e. without a context.
+     * Same return values as redlandContainsStatement.
+     */
+    int redlandContainsStatementInDefaultGraph( const Soprano::Statement& statement );
+
+    /**
+     * Fills queryStatement with the nodes from \p statement.
+     * Call releaseQueryStatement once done with it.
+     */
+    librdf_statement* prepareQueryStatement( const Soprano::Statement& statement );
+    void releaseQueryStatement();
+
+    /**
+     * Make sure we store everything in case we crash.
+     * Does nothing while a batch is open.
+     */
+    void sync();
 };
 
 
+void Soprano::Redland::RedlandModel::Private::sync()
+{
+    if ( batchLevel == 0 ) {
+        librdf_model_sync( model );
+    }
+}
+
+
+librdf_statement* Soprano::Redland::RedlandModel::Private::prepareQueryStatement( const Soprano::Statement& statement )
+{
+    if ( !queryStatement ) {
+        queryStatement = librdf_new_statement( world->worldPtr() );
+        if ( !queryStatement ) {
+            return 0;
+        }
+    }
+
+    // the statement takes ownership of the nodes
+    if ( statement.subject().isValid() ) {
+        librdf_statement_set_subject( queryStatement, world->createNode( statement.subject() ) );
+    }
+    if ( statement.predicate().isValid() ) {
+        librdf_statement_set_predicate( queryStatement, world->createNode( statement.predicate() ) );
+    }
+    if ( statement.object().isValid() ) {
+        librdf_statement_set_object( queryStatement, world->createNode( statement.object() ) );
+    }
+    return queryStatement;
+}
+
+
+void Soprano::Redland::RedlandModel::Private::releaseQueryStatement()
+{
+    if ( queryStatement ) {
+        librdf_statement_clear( queryStatement );
+    }
+}
+
+
 librdf_stream* Soprano::Redland::RedlandModel::Private::redlandFindStatements( const Soprano::Statement& statement )
 {
     librdf_node* ctx = world->createNode( statement.context() );
-    librdf_statement* st = world->createStatement( statement );
+    librdf_statement* st = prepareQueryStatement( statement );
+    // librdf copies the statement, we can release ours right away
     librdf_stream *stream = redlandFindStatements( st, ctx );
     world->freeNode( ctx );
-    world->freeStatement( st );
+    releaseQueryStatement();
     return stream;
 }
 
@@ -126,11 +211,47 @@ librdf_stream* Soprano::Redland::RedlandModel::Private::redlandFindStatements( l
 
 int Soprano::Redland::RedlandModel::Private::redlandContainsStatement( const Soprano::Statement& statement )
 {
-    librdf_statement* s = world->createStatement( statement );
-    librdf_node* c = statement.context().isValid() ? world->createNode( statement.context() ) : 0;
-    int cr = redlandContainsStatement( s, c );
-    world->freeStatement( s );
-    world->freeNode( c );
+    librdf_statement* s = prepareQueryStatement( statement );
+    if ( !s ) {
+        return -1;
+    }
+
+    int cr = 0;
+    if ( !statement.context().isValid() && isCompleteStatement( statement ) ) {
+        // the common "does it exist" check does not need a stream
+        int r = librdf_model_contains_statement( model, s );
+        cr = ( r < 0 ? -1 : r > 0 ? 1 : 0 );
+    }
+    else {
+        librdf_node* c = statement.context().isValid() ? world->createNode( statement.context() ) : 0;
+        cr = redlandContainsStatement( s, c );
+        world->freeNode( c );
+    }
+    releaseQueryStatement();
+    return cr;
+}
+
+
+int Soprano::Redland::RedlandModel::Private::redlandContainsStatementInDefaultGraph( const Soprano::Statement& statement )
+{
+    librdf_statement* s = prepareQueryStatement( statement );
+    if ( !s ) {
+        return -1;
+    }
+
+    int cr = -1;
+    if ( librdf_stream* stream = librdf_model_find_statements( model, s ) ) {
+        cr = 0;
+        while ( !librdf_stream_end( stream ) ) {
+            if ( !librdf_stream_get_context( stream ) ) {
+                cr = 1;
+                break;
+            }
+            librdf_stream_next( stream );
+        }
+        librdf_free_stream( stream );
+    }
+    releaseQueryStatement();
     return cr;
 }
 
@@ -171,19 +292,22 @@ Soprano::Redland::RedlandModel::RedlandModel( const Backend* b, librdf_model *mo
 
 Soprano::Redland::RedlandModel::~RedlandModel()
 {
-    for ( QList<RedlandStatementIterator*>::iterator it = d->iterators.begin();
-          it != d->iterators.end(); ++it ) {
-        ( *it )->close();
+    QMutexLocker lock( d->world->mutex() );
+
+    // closing removes the iterators from the hashes
+    Q_FOREACH( RedlandStatementIterator* it, d->iterators.keys() ) {
+        it->close();
     }
-    for ( QList<Redland::NodeIteratorBackend*>::iterator it = d->nodeIterators.begin();
-          it != d->nodeIterators.end(); ++it ) {
-        ( *it )->close();
+    Q_FOREACH( Redland::NodeIteratorBackend* it, d->nodeIterators.keys() ) {
+        it->close();
     }
-    for ( QList<RedlandQueryResult*>::iterator it = d->results.begin();
-          it != d->results.end(); ++it ) {
-        ( *it )->close();
+    Q_FOREACH( RedlandQueryResult* it, d->results.keys() ) {
+        it->close();
     }
 
+    if ( d->queryStatement ) {
+        librdf_free_statement( d->queryStatement );
+    }
     librdf_free_model( d->model );
     librdf_free_storage( d->storage );
 
@@ -216,6 +340,7 @@ Soprano::Error::ErrorCode Soprano::Redland::RedlandModel::addStatement( const St
     bool added = true;
 
     d->readWriteLock.lockForWrite();
+    QMutexLocker worldLock( d->world->mutex() );
 
     librdf_statement* redlandStatement = d->world->createStatement( statement );
     if ( !redlandStatement ||
@@ -263,9 +388,9 @@ Soprano::Error::ErrorCode Soprano::Redland::RedlandModel::addStatement( const St
 
     d->world->freeStatement( redlandStatement );
 
-    // make sure we store everything in case we crash
-    librdf_model_sync( d->model );
+    d->sync();
 
+    worldLock.unlock();
     d->readWriteLock.unlock();
 
     if ( added ) {
@@ -282,6 +407,7 @@ Soprano::NodeIterator Soprano::Redland::RedlandModel::listContexts() const
     clearError();
 
     d->readWriteLock.lockForRead();
+    QMutexLocker worldLock( d->world->mutex() );
 
     librdf_iterator *iter = librdf_model_get_contexts( d->model );
     if (!iter) {
@@ -292,7 +418,7 @@ Soprano::NodeIterator Soprano::Redland::RedlandModel::listContexts() const
 
     // we do not unlock d->readWriteLock here. That is done once the iterator closes
     NodeIteratorBackend* it = new NodeIteratorBackend( this, iter );
-    d->nodeIterators.append( it );
+    d->nodeIterators.insert( it, QThread::currentThread() );
     return it;
 }
 
@@ -301,17 +427,19 @@ bool Soprano::Redland::RedlandModel::containsStatement( const Statement& stateme
 {
     if ( statement.isValid() ) {
         MultiMutexReadLocker lock( &d->readWriteLock );
+        QMutexLocker worldLock( d->world->mutex() );
+        int c = 0;
         if ( statement.context().isValid() ) {
-            int c = d->redlandContainsStatement( statement );
-            if ( c < 0 )
-                setError( d->world->lastError() );
-            else
-                clearError();
-            return( c > 0 );
+            c = d->redlandContainsStatement( statement );
         }
         else {
-            return StorageModel::containsStatement( statement );
+            c = d->redlandContainsStatementInDefaultGraph( statement );
         }
+        if ( c < 0 )
+            setError( d->world->lastError() );
+        else
+            clearError();
+        return( c > 0 );
     }
     else {
         setError( "Cannot check for invalid statement", Error::ErrorInvalidArgument );
@@ -323,6 +451,7 @@ bool Soprano::Redland::RedlandModel::containsStatement( const Statement& stateme
 bool Soprano::Redland::RedlandModel::containsAnyStatement( const Statement& statement ) const
 {
     MultiMutexReadLocker lock( &d->readWriteLock );
+    QMutexLocker worldLock( d->world->mutex() );
 
     int c = d->redlandContainsStatement( statement );
     if ( c < 0 )
@@ -336,6 +465,7 @@ bool Soprano::Redland::RedlandModel::containsAnyStatement( const Statement& stat
 Soprano::QueryResultIterator Soprano::Redland::RedlandModel::executeQuery( const QString &query, Query::QueryLanguage language, const QString& userQueryLanguage ) const
 {
     d->readWriteLock.lockForRead();
+    QMutexLocker worldLock( d->world->mutex() );
 
     clearError();
 
@@ -360,7 +490,7 @@ Soprano::QueryResultIterator Soprano::Redland::RedlandModel::executeQuery( const
 
     // we do not unlock d->readWriteLock here. That is done once the iterator closes
     RedlandQueryResult* result = new RedlandQueryResult( this, res );
-    d->results.append( result );
+    d->results.insert( result, QThread::currentThread() );
     return QueryResultIterator( result );
 }
 
@@ -368,6 +498,7 @@ Soprano::QueryResultIterator Soprano::Redland::RedlandModel::executeQuery( const
 Soprano::StatementIterator Soprano::Redland::RedlandModel::listStatements( const Statement& partial ) const
 {
     d->readWriteLock.lockForRead();
+    QMutexLocker worldLock( d->world->mutex() );
 
     clearError();
 
@@ -379,7 +510,7 @@ Soprano::StatementIterator Soprano::Redland::RedlandModel::listStatements( const
     }
 
     RedlandStatementIterator* it = new RedlandStatementIterator( this, stream, partial.context() );
-    d->iterators.append( it );
+    d->iterators.insert( it, QThread::currentThread() );
     return StatementIterator( it );
 }
 
@@ -387,13 +518,17 @@ Soprano::StatementIterator Soprano::Redland::RedlandModel::listStatements( const
 Soprano::Error::ErrorCode Soprano::Redland::RedlandModel::removeStatement( const Statement& statement )
 {
     d->readWriteLock.lockForWrite();
+    QMutexLocker worldLock( d->world->mutex() );
     Error::ErrorCode r = removeOneStatement( statement );
 
-    // make sure we store everything in case we crash
-    librdf_model_sync( d->model );
+    d->sync();
 
+    worldLock.unlock();
     d->readWriteLock.unlock();
+
+    // signals are emitted without any lock held, just like in addStatement()
     if ( r == Error::ErrorNone ) {
+        emit statementRemoved( statement );
         emit statementsRemoved();
     }
     return r;
@@ -435,8 +570,6 @@ Soprano::Error::ErrorCode Soprano::Redland::RedlandModel::removeOneStatement( co
 
     d->world->freeStatement( redlandStatement );
 
-    emit statementRemoved( statement );
-
     return Error::ErrorNone;
 }
 
@@ -447,6 +580,7 @@ Soprano::Error::ErrorCode Soprano::Redland::RedlandModel::removeAllStatements( c
 
     if ( isContextOnlyStatement( statement ) ) {
         d->readWriteLock.lockForWrite();
+        QMutexLocker worldLock( d->world->mutex() );
 
         librdf_node *ctx = d->world->createNode( statement.context() );
 
@@ -459,9 +593,9 @@ Soprano::Error::ErrorCode Soprano::Redland::RedlandModel::removeAllStatements( c
 
         d->world->freeNode( ctx );
 
-        // make sure we store everything in case we crash
-        librdf_model_sync( d->model );
+        d->sync();
 
+        worldLock.unlock();
         d->readWriteLock.unlock();
 
         // FIXME: list all the removed statements? That could mean a bad slowdown...
@@ -477,27 +611,38 @@ Soprano::Error::ErrorCode Soprano::Redland::RedlandModel::removeAllStatements( c
         QList<Statement> statementsToRemove = listStatements( statement ).allStatements();
 
         d->readWriteLock.lockForWrite();
+        QMutexLocker worldLock( d->world->mutex() );
 
-        int cnt = 0;
+        QList<Statement> removedStatements;
+        Error::ErrorCode error = Error::ErrorNone;
         for ( QList<Statement>::const_iterator it = statementsToRemove.constBegin();
               it != statementsToRemove.constEnd(); ++it ) {
-            ++cnt;
-            Error::ErrorCode error = removeOneStatement( *it );
+            error = removeOneStatement( *it );
             if ( error != Error::ErrorNone ) {
-                d->readWriteLock.unlock();
-                return error;
+                break;
             }
+            removedStatements.append( *it );
         }
 
-        // make sure we store everything in case we crash
-        librdf_model_sync( d->model );
+        d->sync();
 
+        worldLock.unlock();
         d->readWriteLock.unlock();
 
-        if ( cnt ) {
+        // inform about the statements that were removed before a failure, too.
+        // The slots may reset the error, thus we remember it.
+        const Error::Error lastErr = lastError();
+        if ( !removedStatements.isEmpty() ) {
+            for ( QList<Statement>::const_iterator it = removedStatements.constBegin();
+                  it != removedStatements.constEnd(); ++it ) {
+                emit statementRemoved( *it );
+            }
             emit statementsRemoved();
         }
-        return Error::ErrorNone;
+        if ( error != Error::ErrorNone ) {
+            setError( lastErr );
+        }
+        return error;
     }
 
     else {
@@ -509,6 +654,7 @@ Soprano::Error::ErrorCode Soprano::Redland::RedlandModel::removeAllStatements( c
 int Soprano::Redland::RedlandModel::statementCount() const
 {
     MultiMutexReadLocker lock( &d->readWriteLock );
+    QMutexLocker worldLock( d->world->mutex() );
     clearError();
     int size = librdf_model_size( d->model );
     if ( size < 0 ) {
@@ -518,9 +664,57 @@ int Soprano::Redland::RedlandModel::statementCount() const
 }
 
 
+bool Soprano::Redland::RedlandModel::startBatch()
+{
+    QMutexLocker worldLock( d->world->mutex() );
+    ++d->batchLevel;
+    clearError();
+    return true;
+}
+
+
+bool Soprano::Redland::RedlandModel::commitBatch()
+{
+    QMutexLocker worldLock( d->world->mutex() );
+    if ( d->batchLevel == 0 ) {
+        setError( "No open batch to commit", Error::ErrorInvalidArgument );
+        return false;
+    }
+
+    if ( --d->batchLevel == 0 ) {
+        if ( librdf_model_sync( d->model ) ) {
+            setError( d->world->lastError( Error::Error( "Failed to sync the storage", Error::ErrorUnknown ) ) );
+            return false;
+        }
+    }
+
+    clearError();
+    return true;
+}
+
+
+qint64 Soprano::Redland::RedlandModel::nodeCacheHits() const
+{
+    return d->world->nodeCacheHits();
+}
+
+
+qint64 Soprano::Redland::RedlandModel::nodeCacheMisses() const
+{
+    return d->world->nodeCacheMisses();
+}
+
+
+void Soprano::Redland::RedlandModel::resetNodeCacheStatistics()
+{
+    d->world->resetNodeCacheStatistics();
+}
+
+
 Soprano::Node Soprano::Redland::RedlandModel::createBlankNode()
 {
     clearError();
+    QMutexLocker worldLock( d->world->mutex() );
     Node n = d->world->createNode( librdf_new_node_from_blank_identifier( d->world->worldPtr(), 0 ) );
     if ( n.isEmpty() ) {
         setError( d->world->lastError() );
@@ -531,20 +725,22 @@ Soprano::Node Soprano::Redland::RedlandModel::createBlankNode()
 
 void Soprano::Redland::RedlandModel::removeIterator( RedlandStatementIterator* it ) const
 {
-    d->iterators.removeAll( it );
-    d->readWriteLock.unlock();
+    QMutexLocker lock( d->world->mutex() );
+    d->readWriteLock.unlock( d->iterators.take( it ) );
 }
 
 
 void Soprano::Redland::RedlandModel::removeIterator( Redland::NodeIteratorBackend* it ) const
 {
-    d->nodeIterators.removeAll( it );
-    d->readWriteLock.unlock();
+    QMutexLocker lock( d->world->mutex() );
+    d->readWriteLock.unlock( d->nodeIterators.take( it ) );
 }
 
 
 void Soprano::Redland::RedlandModel::removeQueryResult( RedlandQueryResult* r ) const
 {
-    d->results.removeAll( r );
-    d->readWriteLock.unlock();
+    QMutexLocker lock( d->world->mutex() );
+    d->readWriteLock.unlock( d->results.take( r ) );
 }
+
+#include "moc_redlandmodel.cpp"
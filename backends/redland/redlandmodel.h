@@ -48,6 +48,8 @@ namespace Soprano {
 
         class RedlandModel: public Soprano::StorageModel
         {
+            Q_OBJECT
+
         public:
             RedlandModel( const Backend*, librdf_model *model, librdf_storage *storage, World* world );
             ~RedlandModel();
@@ -75,6 +77,45 @@ namespace Soprano {
 
             Node createBlankNode();
 
+            /**
+             * Start a batch of write operations. As long as a batch is open
+             * changes are not synced to the storage after each single write.
+             * Instead the storage is synced once when the outermost batch is
+             * committed. This speeds up bulk imports into persistent storages
+             * considerably.
+             *
+             * Batches can be nested and apply to the whole model, i.e. to writes
+             * from all threads. There is no rollback, changes are visible to
+             * readers right away.
+             *
+             * Since the header is not installed the methods can be called through
+             * QMetaObject::invokeMethod(). Backends supporting them report the
+             * user feature "batchWrites".
+             *
+             * \sa commitBatch()
+             */
+            Q_INVOKABLE bool startBatch();
+
+            /**
+             * Close a batch opened with startBatch() and sync the storage
+             * if it was the outermost one.
+             *
+             * \return \p false if no batch was open or syncing failed.
+             */
+            Q_INVOKABLE bool commitBatch();
+
+            /**
+             * Node conversion cache statistics since the last call to
+             * resetNodeCacheStatistics(). The caches are shared by all
+             * models of the backend.
+             *
+             * Invokable like startBatch(). Backends supporting them report
+             * the user feature "nodeCacheStatistics".
+             */
+            Q_INVOKABLE qint64 nodeCacheHits() const;
+            Q_INVOKABLE qint64 nodeCacheMisses() const;
+            Q_INVOKABLE void resetNodeCacheStatistics();
+
         private:
             class Private;
             Private *d;
@@ -28,6 +28,7 @@
 #include <QtCore/QtGlobal>
 #include <QtCore/QSharedData>
 #include <QtCore/QDebug>
+#include <QtCore/QMutexLocker>
 
 
 Soprano::Redland::NodeIteratorBackend::NodeIteratorBackend( const RedlandModel* model, librdf_iterator* it )
@@ -46,14 +47,15 @@ Soprano::Redland::NodeIteratorBackend::~NodeIteratorBackend()
 
 bool Soprano::Redland::NodeIteratorBackend::next()
 {
-    if ( m_initialized ) {
-        // Move to the next element
-        librdf_iterator_next( m_iterator );
-    }
+    if ( m_iterator ) {
+        QMutexLocker lock( m_model->world()->mutex() );
+        if ( m_initialized ) {
+            // Move to the next element
+            librdf_iterator_next( m_iterator );
+        }
 
-    m_initialized = true;
+        m_initialized = true;
 
-    if ( m_iterator ) {
         if ( librdf_iterator_end( m_iterator ) ) {
             close();
             return false;
@@ -70,7 +72,12 @@ bool Soprano::Redland::NodeIteratorBackend::next()
 
 Soprano::Node Soprano::Redland::NodeIteratorBackend::current() const
 {
-    if ( !m_iterator || librdf_iterator_end( m_iterator ) ) {
+    if ( !m_iterator ) {
+        return Node();
+    }
+
+    QMutexLocker lock( m_model->world()->mutex() );
+    if ( librdf_iterator_end( m_iterator ) ) {
         return Node();
     }
 
@@ -87,11 +94,13 @@ Soprano::Node Soprano::Redland::NodeIteratorBackend::current() const
 
 void Soprano::Redland::NodeIteratorBackend::close()
 {
-    if( m_iterator ) {
-        librdf_free_iterator( m_iterator );
-        m_iterator = 0;
-    }
+    // the iterator is only valid as long as the model is
     if ( m_model ) {
+        QMutexLocker lock( m_model->world()->mutex() );
+        if( m_iterator ) {
+            librdf_free_iterator( m_iterator );
+            m_iterator = 0;
+        }
         m_model->removeIterator( this );
     }
     m_model = 0;
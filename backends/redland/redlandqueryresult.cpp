@@ -31,6 +31,8 @@
 
 #include <redland.h>
 
+#include <QtCore/QMutexLocker>
+
 class Soprano::Redland::RedlandQueryResult::Private
 {
 public:
@@ -67,13 +69,18 @@ public:
     bool boolResult;
 
     const RedlandModel* model;
+
+    // never reset, used to lock librdf calls
+    World* world;
 };
 
 
 Soprano::Redland::RedlandQueryResult::RedlandQueryResult( const RedlandModel* model, librdf_query_results *result )
 {
+    // the result has been created with the world mutex locked, thus we can access it in Private
     d = new Private( result );
     d->model = model;
+    d->world = model->world();
 
     const char** names = 0;
     int number = librdf_query_results_get_bindings_count(d->result);
@@ -94,6 +101,7 @@ Soprano::Redland::RedlandQueryResult::~RedlandQueryResult()
 
 void Soprano::Redland::RedlandQueryResult::close()
 {
+    QMutexLocker lock( d->world->mutex() );
     if ( d->result ) {
         librdf_free_query_results( d->result );
         if ( d->stream ) {
@@ -118,6 +126,7 @@ bool Soprano::Redland::RedlandQueryResult::next()
         return false;
     }
     else if ( isBinding() ) {
+        QMutexLocker lock( d->world->mutex() );
         bool hasNext = librdf_query_results_finished( d->result ) == 0;
 
         if ( !d->first ) {
@@ -134,6 +143,7 @@ bool Soprano::Redland::RedlandQueryResult::next()
         return hasNext;
     }
     else if ( isGraph() ) {
+        QMutexLocker lock( d->world->mutex() );
         if ( d->first ) {
             d->stream = librdf_query_results_as_stream( d->result );
             d->first = false;
@@ -159,6 +169,7 @@ bool Soprano::Redland::RedlandQueryResult::next()
 
 Soprano::Statement Soprano::Redland::RedlandQueryResult::currentStatement() const
 {
+    QMutexLocker lock( d->world->mutex() );
     if ( d->stream ) {
         librdf_statement *st = librdf_stream_get_object( d->stream );
 
@@ -181,6 +192,7 @@ Soprano::Statement Soprano::Redland::RedlandQueryResult::currentStatement() cons
 
 Soprano::Node Soprano::Redland::RedlandQueryResult::binding( const QString &name ) const
 {
+    QMutexLocker lock( d->world->mutex() );
     if ( d->result ) {
         librdf_node *node = librdf_query_results_get_binding_value_by_name( d->result, (const char *)name.toLatin1().data() );
         if ( !node ) {
@@ -201,6 +213,7 @@ Soprano::Node Soprano::Redland::RedlandQueryResult::binding( const QString &name
 
 Soprano::Node Soprano::Redland::RedlandQueryResult::binding( int offset ) const
 {
+    QMutexLocker lock( d->world->mutex() );
     if ( d->result ) {
         librdf_node *node = librdf_query_results_get_binding_value( d->result, offset );
         if ( !node ) {
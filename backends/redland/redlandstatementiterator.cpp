@@ -29,6 +29,7 @@
 #include <QtCore/QtGlobal>
 #include <QtCore/QSharedData>
 #include <QtCore/QDebug>
+#include <QtCore/QMutexLocker>
 
 
 Soprano::Redland::RedlandStatementIterator::RedlandStatementIterator( const RedlandModel* model, librdf_stream *s, const Node& forceContext )
@@ -51,6 +52,7 @@ bool Soprano::Redland::RedlandStatementIterator::next()
     clearError();
 
     if ( m_stream ) {
+        QMutexLocker lock( m_model->world()->mutex() );
         if ( m_initialized ) {
             // Move to the next element
             librdf_stream_next( m_stream );
@@ -75,7 +77,13 @@ bool Soprano::Redland::RedlandStatementIterator::next()
 
 Soprano::Statement Soprano::Redland::RedlandStatementIterator::current() const
 {
-    if ( !m_stream || librdf_stream_end( m_stream ) ) {
+    if ( !m_stream ) {
+        setError( "Invalid iterator" );
+        return Statement();
+    }
+
+    QMutexLocker lock( m_model->world()->mutex() );
+    if ( librdf_stream_end( m_stream ) ) {
         setError( "Invalid iterator" );
         return Statement();
     }
@@ -105,11 +113,13 @@ void Soprano::Redland::RedlandStatementIterator::close()
 {
     clearError();
 
-    if( m_stream ) {
-        librdf_free_stream( m_stream );
-        m_stream = 0;
-    }
+    // the stream is only valid as long as the model is
     if ( m_model ) {
+        QMutexLocker lock( m_model->world()->mutex() );
+        if( m_stream ) {
+            librdf_free_stream( m_stream );
+            m_stream = 0;
+        }
         m_model->removeIterator( this );
     }
     m_model = 0;
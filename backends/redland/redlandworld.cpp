@@ -28,9 +28,48 @@
 #include <QtCore/QObject>
 #include <QtCore/QStringList>
 #include <QtCore/QDebug>
+#include <QtCore/QMutexLocker>
 
 Q_GLOBAL_STATIC( Soprano::Redland::World, s_theWorld )
 
+namespace {
+    const int s_defaultNodeCacheSize = 10000;
+}
+
+
+/**
+ * Keeps a copy of a librdf node in the node cache.
+ */
+class Soprano::Redland::World::CachedRedlandNode
+{
+public:
+    CachedRedlandNode( librdf_node* n )
+        : node( librdf_new_node_from_node( n ) ) {
+    }
+    ~CachedRedlandNode() {
+        librdf_free_node( node );
+    }
+
+    librdf_node* node;
+};
+
+
+/**
+ * Keeps a librdf uri in the uri cache.
+ */
+class Soprano::Redland::World::CachedRedlandUri
+{
+public:
+    CachedRedlandUri( librdf_uri* u )
+        : uri( u ) {
+    }
+    ~CachedRedlandUri() {
+        librdf_free_uri( uri );
+    }
+
+    librdf_uri* uri;
+};
+
 static QString redlandLogFacilityToString( int facility )
 {
     switch( facility ) {
@@ -126,7 +165,12 @@ int REDLAND_CALLBACK_STDCALL redlandLogHandler( void* user, librdf_log_message*
 
 
 Soprano::Redland::World::World()
+    : m_mutex( QMutex::Recursive ),
+      m_nodeCacheHits( 0 ),
+      m_nodeCacheMisses( 0 )
 {
+    setNodeCacheSize( s_defaultNodeCacheSize );
+
     m_world = librdf_new_world();
     librdf_world_open( m_world );
     librdf_world_set_logger( m_world, this, redlandLogHandler );
@@ -134,6 +178,9 @@ Soprano::Redland::World::World()
 
 Soprano::Redland::World::~World()
 {
+    // the cached librdf objects have to be freed before the world
+    m_redlandNodeCache.clear();
+    m_redlandUriCache.clear();
     librdf_free_world( m_world );
 }
 
@@ -144,23 +191,43 @@ librdf_world* Soprano::Redland::World::worldPtr() const
 }
 
 
+QMutex* Soprano::Redland::World::mutex() const
+{
+    return &m_mutex;
+}
+
+
 librdf_node *Soprano::Redland::World::createNode( const Node& node )
 {
     librdf_world *world = worldPtr();
 
     if ( node.isResource() ) {
-        return librdf_new_node_from_uri_string( world, (unsigned char *)node.uri().toEncoded().data() );
+        QMutexLocker lock( &m_mutex );
+        if ( CachedRedlandNode* cached = m_redlandNodeCache.object( node.uri() ) ) {
+            ++m_nodeCacheHits;
+            return librdf_new_node_from_node( cached->node );
+        }
+        ++m_nodeCacheMisses;
+        librdf_node* n = librdf_new_node_from_uri_string( world, (unsigned char *)node.uri().toEncoded().data() );
+        if ( n ) {
+            m_redlandNodeCache.insert( node.uri(), new CachedRedlandNode( n ) );
+        }
+        return n;
     }
     else if ( node.isBlank() ) {
         return librdf_new_node_from_blank_identifier( world, (unsigned char *) node.identifier().toUtf8().data() );
     }
     else if ( node.isLiteral() ) {
-        return librdf_new_node_from_typed_literal( world,
-                                                   (unsigned char *)node.literal().toString().toUtf8().data(),
-                                                   node.language().toUtf8().data(),
-                                                   !node.literal().isPlain()
-                                                   ? librdf_new_uri( world, (const unsigned char*)node.dataType().toEncoded().data() )
-                                                   : 0 );
+        // librdf keeps its own reference to the datatype
+        librdf_uri* dataType = !node.literal().isPlain() ? cachedUri( node.dataType() ) : 0;
+        librdf_node* n = librdf_new_node_from_typed_literal( world,
+                                                             (unsigned char *)node.literal().toString().toUtf8().data(),
+                                                             node.language().toUtf8().data(),
+                                                             dataType );
+        if ( dataType ) {
+            librdf_free_uri( dataType );
+        }
+        return n;
     }
 
     return 0;
@@ -184,8 +251,7 @@ librdf_statement *Soprano::Redland::World::createStatement( const Statement &sta
 Soprano::Node Soprano::Redland::World::createNode( librdf_node *node )
 {
     if ( librdf_node_is_resource( node ) ) {
-        librdf_uri *uri = librdf_node_get_uri( node );
-        return Soprano::Node( QUrl::fromEncoded( (const char *)librdf_uri_as_string(uri), QUrl::StrictMode ) );
+        return Soprano::Node( cachedUrl( librdf_node_get_uri( node ) ) );
     }
     else if ( librdf_node_is_blank( node ) ) {
         return Soprano::Node( QString::fromUtf8( (const char *)librdf_node_get_blank_identifier( node ) ) );
@@ -198,8 +264,7 @@ Soprano::Node Soprano::Redland::World::createNode( librdf_node *node )
         }
         else {
             return Soprano::Node( Soprano::LiteralValue::fromString( QString::fromUtf8( (const char *)librdf_node_get_literal_value( node ) ),
-                                                                     QUrl::fromEncoded( (const char *)librdf_uri_as_string( datatype ),
-                                                                                        QUrl::StrictMode ) ) );
+                                                                     cachedUrl( datatype ) ) );
         }
     }
 
@@ -236,3 +301,75 @@ Soprano::Redland::World* Soprano::Redland::World::theWorld()
 {
     return s_theWorld();
 }
+
+
+librdf_uri* Soprano::Redland::World::cachedUri( const QUrl& uri )
+{
+    QMutexLocker lock( &m_mutex );
+    if ( CachedRedlandUri* cached = m_redlandUriCache.object( uri ) ) {
+        ++m_nodeCacheHits;
+        return librdf_new_uri_from_uri( cached->uri );
+    }
+    ++m_nodeCacheMisses;
+    librdf_uri* u = librdf_new_uri( m_world, (const unsigned char*)uri.toEncoded().data() );
+    if ( u ) {
+        m_redlandUriCache.insert( uri, new CachedRedlandUri( librdf_new_uri_from_uri( u ) ) );
+    }
+    return u;
+}
+
+
+QUrl Soprano::Redland::World::cachedUrl( librdf_uri* uri )
+{
+    size_t len = 0;
+    const char* data = (const char*)librdf_uri_as_counted_string( uri, &len );
+
+    QMutexLocker lock( &m_mutex );
+    if ( QUrl* cached = m_urlCache.object( QByteArray::fromRawData( data, len ) ) ) {
+        ++m_nodeCacheHits;
+        return *cached;
+    }
+    ++m_nodeCacheMisses;
+    QByteArray encoded( data, len );
+    QUrl url = QUrl::fromEncoded( encoded, QUrl::StrictMode );
+    m_urlCache.insert( encoded, new QUrl( url ) );
+    return url;
+}
+
+
+void Soprano::Redland::World::setNodeCacheSize( int size )
+{
+    QMutexLocker lock( &m_mutex );
+    m_redlandNodeCache.setMaxCost( size );
+    m_redlandUriCache.setMaxCost( size );
+    m_urlCache.setMaxCost( size );
+}
+
+
+int Soprano::Redland::World::nodeCacheSize() const
+{
+    QMutexLocker lock( &m_mutex );
+    return m_urlCache.maxCost();
+}
+
+
+qint64 Soprano::Redland::World::nodeCacheHits() const
+{
+    QMutexLocker lock( &m_mutex );
+    return m_nodeCacheHits;
+}
+
+
+qint64 Soprano::Redland::World::nodeCacheMisses() const
+{
+    QMutexLocker lock( &m_mutex );
+    return m_nodeCacheMisses;
+}
+
+
+void Soprano::Redland::World::resetNodeCacheStatistics()
+{
+    QMutexLocker lock( &m_mutex );
+    m_nodeCacheHits = 0;
+    m_nodeCacheMisses = 0;
+}
@@ -28,6 +28,10 @@
 #include "error.h"
 
 #include <QtCore/QStringList>
+#include <QtCore/QMutex>
+#include <QtCore/QCache>
+#include <QtCore/QByteArray>
+#include <QtCore/QUrl>
 
 
 namespace Soprano {
@@ -47,6 +51,14 @@ namespace Soprano {
 
             librdf_world* worldPtr() const;
 
+            /**
+             * librdf is not thread-safe, not even for concurrent reads since nodes
+             * and URIs are shared through the world. Thus, every call into librdf
+             * has to be protected by this mutex. It is recursive and only held for
+             * the duration of single calls to keep reading threads independent.
+             */
+            QMutex* mutex() const;
+
             // make error methods public
             void setError( const Error::Error& e ) const { ErrorCache::setError( e ); }
             void clearError() const { ErrorCache::clearError(); }
@@ -82,8 +94,41 @@ namespace Soprano {
 
             static Soprano::Redland::World* theWorld();
 
+            /**
+             * Set the maximum number of resources kept in each of the node
+             * conversion caches. The default is 10000.
+             */
+            void setNodeCacheSize( int size );
+            int nodeCacheSize() const;
+
+            /**
+             * Node conversion cache statistics since the last call
+             * to resetNodeCacheStatistics().
+             */
+            qint64 nodeCacheHits() const;
+            qint64 nodeCacheMisses() const;
+            void resetNodeCacheStatistics();
+
         private:
+            /**
+             * \return A new reference to the uri which has to be freed by the caller.
+             */
+            librdf_uri* cachedUri( const QUrl& uri );
+            QUrl cachedUrl( librdf_uri* uri );
+
+            class CachedRedlandNode;
+            class CachedRedlandUri;
+
             librdf_world * m_world;
+            mutable QMutex m_mutex;
+
+            // Resources are converted in both directions over and over again
+            // (predicates, types, datatypes). Encoding and parsing URIs is expensive.
+            QCache<QUrl, CachedRedlandNode> m_redlandNodeCache;
+            QCache<QUrl, CachedRedlandUri> m_redlandUriCache;
+            QCache<QByteArray, QUrl> m_urlCache;
+            qint64 m_nodeCacheHits;
+            qint64 m_nodeCacheMisses;
         };
     }
 }
@@ -19,12 +19,30 @@
  * Boston, MA 02110-1301, USA.
  */
 
+import info.aduna.iteration.Iteration;
+
 import org.openrdf.repository.RepositoryConnection;
 import org.openrdf.repository.RepositoryException;
+import org.openrdf.model.BNode;
+import org.openrdf.model.Literal;
 import org.openrdf.model.Resource;
+import org.openrdf.model.Statement;
 import org.openrdf.model.Value;
+import org.openrdf.model.ValueFactory;
 import org.openrdf.model.URI;
 
+import java.util.ArrayList;
+
+/**
+ * The bulk methods exchange statements as strings to avoid several JNI
+ * calls per node. Each statement is encoded as its subject, predicate,
+ * object, and context. Each node starts with its type:
+ * 'n' (empty), 'u' (URI), 'b' (blank node), 'l' (plain literal), or
+ * 't' (typed literal), followed by its fields. URIs and blank nodes have
+ * one field, literals two: the label and the language or datatype.
+ * Each field is written as its length in UTF-16 code units, a colon,
+ * and the characters.
+ */
 public class SopranoSesame2Wrapper {
 
     private RepositoryConnection m_connection;
@@ -36,4 +54,122 @@ public class SopranoSesame2Wrapper {
     public void removeFromDefaultContext( Resource subject, URI predicate, Value object ) throws RepositoryException {
         m_connection.remove( subject, predicate, object, (Resource)null );
     }
+
+    /**
+     * Adds all encoded statements in one transaction.
+     */
+    public void addStatements( String[] statements ) throws RepositoryException {
+        ValueFactory factory = m_connection.getValueFactory();
+        boolean autoCommit = m_connection.isAutoCommit();
+        m_connection.setAutoCommit( false );
+        try {
+            int[] pos = new int[1];
+            for ( int i = 0; i < statements.length; ++i ) {
+                String s = statements[i];
+                pos[0] = 0;
+                Resource subject = (Resource)decodeValue( factory, s, pos );
+                URI predicate = (URI)decodeValue( factory, s, pos );
+                Value object = decodeValue( factory, s, pos );
+                Resource context = (Resource)decodeValue( factory, s, pos );
+                if ( context != null ) {
+                    m_connection.add( subject, predicate, object, context );
+                }
+                else {
+                    m_connection.add( subject, predicate, object );
+                }
+            }
+            m_connection.commit();
+        }
+        catch ( RepositoryException e ) {
+            m_connection.rollback();
+            throw e;
+        }
+        catch ( RuntimeException e ) {
+            m_connection.rollback();
+            throw e;
+        }
+        finally {
+            m_connection.setAutoCommit( autoCommit );
+        }
+    }
+
+    /**
+     * Fetches up to max statements from it. Fewer statements are only
+     * returned once it is exhausted.
+     */
+    public <X extends Exception> String[] nextStatements( Iteration<? extends Statement, X> it, int max ) throws X {
+        ArrayList<String> statements = new ArrayList<String>();
+        StringBuilder b = new StringBuilder();
+        while ( statements.size() < max && it.hasNext() ) {
+            Statement s = it.next();
+            b.setLength( 0 );
+            encodeValue( b, s.getSubject() );
+            encodeValue( b, s.getPredicate() );
+            encodeValue( b, s.getObject() );
+            encodeValue( b, s.getContext() );
+            statements.add( b.toString() );
+        }
+        return statements.toArray( new String[statements.size()] );
+    }
+
+    private static void encodeField( StringBuilder b, String field ) {
+        b.append( field.length() ).append( ':' ).append( field );
+    }
+
+    private static void encodeValue( StringBuilder b, Value value ) {
+        if ( value == null ) {
+            b.append( 'n' );
+        }
+        else if ( value instanceof URI ) {
+            b.append( 'u' );
+            encodeField( b, value.toString() );
+        }
+        else if ( value instanceof BNode ) {
+            b.append( 'b' );
+            encodeField( b, ( (BNode)value ).getID() );
+        }
+        else {
+            Literal literal = (Literal)value;
+            if ( literal.getDatatype() != null ) {
+                b.append( 't' );
+                encodeField( b, literal.getLabel() );
+                encodeField( b, literal.getDatatype().toString() );
+            }
+            else {
+                b.append( 'l' );
+                encodeField( b, literal.getLabel() );
+                encodeField( b, literal.getLanguage() != null ? literal.getLanguage() : "" );
+            }
+        }
+    }
+
+    private static String decodeField( String s, int[] pos ) {
+        int colon = s.indexOf( ':', pos[0] );
+        int length = Integer.parseInt( s.substring( pos[0], colon ) );
+        pos[0] = colon + 1 + length;
+        return s.substring( colon + 1, pos[0] );
+    }
+
+    private static Value decodeValue( ValueFactory factory, String s, int[] pos ) {
+        char type = s.charAt( pos[0]++ );
+        switch( type ) {
+        case 'n':
+            return null;
+        case 'u':
+            return factory.createURI( decodeField( s, pos ) );
+        case 'b':
+            return factory.createBNode( decodeField( s, pos ) );
+        case 'l': {
+            String label = decodeField( s, pos );
+            String lang = decodeField( s, pos );
+            return lang.length() > 0 ? factory.createLiteral( label, lang ) : factory.createLiteral( label );
+        }
+        case 't': {
+            String label = decodeField( s, pos );
+            return factory.createLiteral( label, factory.createURI( decodeField( s, pos ) ) );
+        }
+        default:
+            throw new IllegalArgumentException( "Malformed statement: " + s );
+        }
+    }
 }
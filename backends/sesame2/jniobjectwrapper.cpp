@@ -46,7 +46,9 @@ JNIObjectWrapper::~JNIObjectWrapper()
 
 jmethodID JNIObjectWrapper::getMethodID( const QString& name, const QString& signature ) const
 {
-    jmethodID id = JNIWrapper::instance()->env()->GetMethodID( JNIWrapper::instance()->env()->GetObjectClass( m_object ),
+    // wrap the class to release the local reference GetObjectClass creates
+    JClassRef clazz = JNIWrapper::instance()->env()->GetObjectClass( m_object );
+    jmethodID id = JNIWrapper::instance()->env()->GetMethodID( clazz,
                                                                name.toUtf8().data(),
                                                                signature.toUtf8().data() );
     if ( !id ) {
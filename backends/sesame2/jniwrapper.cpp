@@ -192,3 +192,21 @@ Soprano::Error::Error JNIWrapper::convertAndClearException()
     }
 }
 
+
+JNILocalFrame::JNILocalFrame( int capacity )
+    : m_pushed( false )
+{
+    m_pushed = ( JNIWrapper::instance()->env()->PushLocalFrame( capacity ) == 0 );
+    if ( !m_pushed ) {
+        qDebug() << "Failed to push local frame with capacity" << capacity;
+        JNIWrapper::instance()->debugException();
+    }
+}
+
+
+JNILocalFrame::~JNILocalFrame()
+{
+    if ( m_pushed ) {
+        JNIWrapper::instance()->env()->PopLocalFrame( 0 );
+    }
+}
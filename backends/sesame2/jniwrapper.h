@@ -73,4 +73,24 @@ private:
     Private* const d;
 };
 
+
+/**
+ * Pushes a new JNI local reference frame on construction and
+ * pops it on destruction, releasing all local references created
+ * in between at once.
+ *
+ * Make sure to create the frame before any JObjectRef that is supposed
+ * to be released with it: all of them need to be destroyed before the
+ * frame is popped.
+ */
+class JNILocalFrame
+{
+public:
+    JNILocalFrame( int capacity = 16 );
+    ~JNILocalFrame();
+
+private:
+    bool m_pushed;
+};
+
 #endif
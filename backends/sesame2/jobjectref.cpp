@@ -157,7 +157,8 @@ JStringRef::JStringRef( const JObjectRef& other )
 JStringRef::JStringRef( const QString& s )
     : JObjectRef()
 {
-    jstring js = JNIWrapper::instance()->env()->NewStringUTF( s.toUtf8().data() );
+    // NewStringUTF expects modified UTF-8 which differs from UTF-8 for characters outside the BMP
+    jstring js = JNIWrapper::instance()->env()->NewString( reinterpret_cast<const jchar*>( s.utf16() ), s.length() );
     if ( js ) {
         JObjectRef::operator=( js );
     }
@@ -196,8 +197,10 @@ JStringRef::operator jstring() const
 QString JStringRef::toQString() const
 {
     if ( data() ) {
+        // java strings are not null-terminated
         const jchar* chars = JNIWrapper::instance()->env()->GetStringChars( JStringRef::data(), 0 );
-        QString qs = QString::fromUtf16( chars );
+        int len = JNIWrapper::instance()->env()->GetStringLength( JStringRef::data() );
+        QString qs = QString::fromUtf16( chars, len );
         JNIWrapper::instance()->env()->ReleaseStringChars( JStringRef::data(), chars );
         return qs;
     }
@@ -22,6 +22,7 @@
 #include "sesame2backend.h"
 #include "sesame2model.h"
 #include "jniwrapper.h"
+#include "sesame2jnicache.h"
 #include "sesame2repository.h"
 #include "jobjectref.h"
 
@@ -43,6 +44,10 @@ Soprano::Sesame2::BackendPlugin::BackendPlugin()
 
 Soprano::Sesame2::BackendPlugin::~BackendPlugin()
 {
+    // the global references need to be released while the VM is still alive
+    if ( m_jniWrapper ) {
+        JNICache::cleanup();
+    }
     delete m_jniWrapper;
 }
 
@@ -76,8 +81,15 @@ Soprano::StorageModel* Soprano::Sesame2::BackendPlugin::createModel( const Backe
         jmethodID id = m_jniWrapper->env()->GetStaticMethodID( clazz, "getInstance", "()Lorg/openrdf/query/parser/QueryParserRegistry;" );
         m_jniWrapper->env()->CallStaticObjectMethod( clazz, id );
     }
+    bool cacheInitialized = JNICache::initialize();
     m_mutex.unlock();
 
+    if ( !cacheInitialized ) {
+        qDebug() << "(Soprano::Sesame2::BackendPlugin) failed to resolve the Sesame2 classes.";
+        setError( "Failed to resolve the Sesame2 classes." );
+        return 0;
+    }
+
     clearError();
 
     QString path;
@@ -173,6 +185,13 @@ Soprano::BackendFeatures Soprano::Sesame2::BackendPlugin::supportedFeatures() co
              BackendFeatureRemoveStatements|
              BackendFeatureListStatements|
              BackendFeatureQuery|
-             BackendFeatureContext );
+             BackendFeatureContext|
+             BackendFeatureUser );
+}
+
+
+QStringList Soprano::Sesame2::BackendPlugin::supportedUserFeatures() const
+{
+    return QStringList() << QLatin1String( "bulkAdd" );
 }
 
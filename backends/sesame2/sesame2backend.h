@@ -50,6 +50,14 @@ namespace Soprano {
 
             BackendFeatures supportedFeatures() const;
 
+            /**
+             * Supported user features are:
+             * \li bulkAdd - The models provide the invokable method
+             *     addStatements() which adds a list of statements in
+             *     blocks, each in one transaction.
+             */
+            QStringList supportedUserFeatures() const;
+
             bool isAvailable() const;
 
         private:
@@ -21,6 +21,7 @@
 
 #include "sesame2bindingset.h"
 #include "sesame2types.h"
+#include "sesame2jnicache.h"
 #include "jniwrapper.h"
 
 
@@ -32,7 +33,7 @@ public:
     }
 
     jmethodID IDgetValue() {
-        return m_parent->getMethodID( "getValue", "(L" JAVA_LANG_STRING ";)L" ORG_OPENRDF_MODEL_VALUE ";" );
+        return JNICache::instance()->methodBindingSetGetValue();
     }
 
 private:
@@ -21,6 +21,7 @@
 
 #include "sesame2iterator.h"
 #include "sesame2types.h"
+#include "sesame2jnicache.h"
 #include "jniwrapper.h"
 
 
@@ -106,7 +107,7 @@ JObjectRef Soprano::Sesame2::Iterator::next()
 void Soprano::Sesame2::Iterator::close()
 {
     // close the result (if this is a closable it)
-    if ( isInstanceOf( JNIWrapper::instance()->env()->FindClass( INFO_ADUNA_ITERATION_CLOSABLEITERATION ) ) ) {
+    if ( JNIWrapper::instance()->env()->IsInstanceOf( object(), JNICache::instance()->classCloseableIteration() ) ) {
         callVoidMethod( d->IDclose() );
     }
 }
@@ -0,0 +1,312 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "sesame2jnicache.h"
+#include "sesame2types.h"
+#include "jniwrapper.h"
+
+#include <QtCore/QDebug>
+
+
+Soprano::Sesame2::JNICache* Soprano::Sesame2::JNICache::s_instance = 0;
+
+namespace {
+    JClassRef findClass( const char* name )
+    {
+        JClassRef clazz = JNIWrapper::instance()->env()->FindClass( name );
+        if ( !clazz ) {
+            qDebug() << "(Soprano::Sesame2::JNICache) failed to find class" << name;
+            JNIWrapper::instance()->debugException();
+            return JClassRef();
+        }
+        return clazz.toGlobalRef();
+    }
+
+    jmethodID findMethod( const JClassRef& clazz, const char* name, const char* signature )
+    {
+        if ( !clazz ) {
+            return 0;
+        }
+        jmethodID id = JNIWrapper::instance()->env()->GetMethodID( clazz, name, signature );
+        if ( !id ) {
+            qDebug() << "(Soprano::Sesame2::JNICache) failed to get method id for" << name << signature;
+            JNIWrapper::instance()->debugException();
+        }
+        return id;
+    }
+}
+
+
+class Soprano::Sesame2::JNICache::Private
+{
+public:
+    Private()
+        : methodURIToString( 0 ),
+          methodBNodeGetID( 0 ),
+          methodLiteralGetLabel( 0 ),
+          methodLiteralGetLanguage( 0 ),
+          methodLiteralGetDatatype( 0 ),
+          methodStatementGetSubject( 0 ),
+          methodStatementGetPredicate( 0 ),
+          methodStatementGetObject( 0 ),
+          methodStatementGetContext( 0 ),
+          methodBindingSetGetValue( 0 ) {
+    }
+
+    JClassRef classString;
+    JClassRef classURI;
+    JClassRef classBNode;
+    JClassRef classLiteral;
+    JClassRef classStatement;
+    JClassRef classBindingSet;
+    JClassRef classCloseableIteration;
+    JClassRef classTupleQuery;
+    JClassRef classGraphQuery;
+    JClassRef classTupleQueryResult;
+    JClassRef classQueryLanguage;
+
+    jmethodID methodURIToString;
+    jmethodID methodBNodeGetID;
+    jmethodID methodLiteralGetLabel;
+    jmethodID methodLiteralGetLanguage;
+    jmethodID methodLiteralGetDatatype;
+    jmethodID methodStatementGetSubject;
+    jmethodID methodStatementGetPredicate;
+    jmethodID methodStatementGetObject;
+    jmethodID methodStatementGetContext;
+    jmethodID methodBindingSetGetValue;
+
+    JObjectRef sparqlQueryLanguage;
+};
+
+
+Soprano::Sesame2::JNICache::JNICache()
+    : d( new Private() )
+{
+}
+
+
+Soprano::Sesame2::JNICache::~JNICache()
+{
+    delete d;
+}
+
+
+bool Soprano::Sesame2::JNICache::initialize()
+{
+    if ( !s_instance ) {
+        JNICache* cache = new JNICache();
+        if ( !cache->resolve() ) {
+            delete cache;
+            return false;
+        }
+        s_instance = cache;
+    }
+    return true;
+}
+
+
+void Soprano::Sesame2::JNICache::cleanup()
+{
+    delete s_instance;
+    s_instance = 0;
+}
+
+
+Soprano::Sesame2::JNICache* Soprano::Sesame2::JNICache::instance()
+{
+    return s_instance;
+}
+
+
+bool Soprano::Sesame2::JNICache::resolve()
+{
+    d->classString = findClass( JAVA_LANG_STRING );
+    d->classURI = findClass( ORG_OPENRDF_MODEL_URI );
+    d->classBNode = findClass( ORG_OPENRDF_MODEL_BNODE );
+    d->classLiteral = findClass( ORG_OPENRDF_MODEL_LITERAL );
+    d->classStatement = findClass( ORG_OPENRDF_MODEL_STATEMENT );
+    d->classBindingSet = findClass( ORG_OPENRDF_QUERY_BINDINGSET );
+    d->classCloseableIteration = findClass( INFO_ADUNA_ITERATION_CLOSABLEITERATION );
+    d->classTupleQuery = findClass( ORG_OPENRDF_QUERY_TUPLEQUERY );
+    d->classGraphQuery = findClass( ORG_OPENRDF_QUERY_GRAPHQUERY );
+    d->classTupleQueryResult = findClass( ORG_OPENRDF_QUERY_TUPLEQUERYRESULT );
+    d->classQueryLanguage = findClass( ORG_OPENRDF_QUERY_QUERYLANGUAGE );
+
+    d->methodURIToString = findMethod( d->classURI, "toString", "()L" JAVA_LANG_STRING ";" );
+    d->methodBNodeGetID = findMethod( d->classBNode, "getID", "()L" JAVA_LANG_STRING ";" );
+    d->methodLiteralGetLabel = findMethod( d->classLiteral, "getLabel", "()L" JAVA_LANG_STRING ";" );
+    d->methodLiteralGetLanguage = findMethod( d->classLiteral, "getLanguage", "()L" JAVA_LANG_STRING ";" );
+    d->methodLiteralGetDatatype = findMethod( d->classLiteral, "getDatatype", "()L" ORG_OPENRDF_MODEL_URI ";" );
+    d->methodStatementGetSubject = findMethod( d->classStatement, "getSubject", "()L" ORG_OPENRDF_MODEL_RESOURCE ";" );
+    d->methodStatementGetPredicate = findMethod( d->classStatement, "getPredicate", "()L" ORG_OPENRDF_MODEL_URI ";" );
+    d->methodStatementGetObject = findMethod( d->classStatement, "getObject", "()L" ORG_OPENRDF_MODEL_VALUE ";" );
+    d->methodStatementGetContext = findMethod( d->classStatement, "getContext", "()L" ORG_OPENRDF_MODEL_RESOURCE ";" );
+    d->methodBindingSetGetValue = findMethod( d->classBindingSet, "getValue", "(L" JAVA_LANG_STRING ";)L" ORG_OPENRDF_MODEL_VALUE ";" );
+
+    if ( d->classQueryLanguage.data() ) {
+        JNIEnv* env = JNIWrapper::instance()->env();
+        jfieldID sparqlID = env->GetStaticFieldID( d->classQueryLanguage,
+                                                   "SPARQL",
+                                                   "L" ORG_OPENRDF_QUERY_QUERYLANGUAGE ";" );
+        if ( sparqlID ) {
+            JObjectRef sparql = env->GetStaticObjectField( d->classQueryLanguage, sparqlID );
+            d->sparqlQueryLanguage = sparql.toGlobalRef();
+        }
+        else {
+            JNIWrapper::instance()->debugException();
+        }
+    }
+
+    return( d->classString.data() &&
+            d->classURI.data() &&
+            d->classBNode.data() &&
+            d->classLiteral.data() &&
+            d->classCloseableIteration.data() &&
+            d->classTupleQuery.data() &&
+            d->classGraphQuery.data() &&
+            d->classTupleQueryResult.data() &&
+            d->methodURIToString &&
+            d->methodBNodeGetID &&
+            d->methodLiteralGetLabel &&
+            d->methodLiteralGetLanguage &&
+            d->methodLiteralGetDatatype &&
+            d->methodStatementGetSubject &&
+            d->methodStatementGetPredicate &&
+            d->methodStatementGetObject &&
+            d->methodStatementGetContext &&
+            d->methodBindingSetGetValue &&
+            d->sparqlQueryLanguage.data() );
+}
+
+
+jclass Soprano::Sesame2::JNICache::classString() const
+{
+    return d->classString;
+}
+
+
+jclass Soprano::Sesame2::JNICache::classURI() const
+{
+    return d->classURI;
+}
+
+
+jclass Soprano::Sesame2::JNICache::classBNode() const
+{
+    return d->classBNode;
+}
+
+
+jclass Soprano::Sesame2::JNICache::classLiteral() const
+{
+    return d->classLiteral;
+}
+
+
+jclass Soprano::Sesame2::JNICache::classCloseableIteration() const
+{
+    return d->classCloseableIteration;
+}
+
+
+jclass Soprano::Sesame2::JNICache::classTupleQuery() const
+{
+    return d->classTupleQuery;
+}
+
+
+jclass Soprano::Sesame2::JNICache::classGraphQuery() const
+{
+    return d->classGraphQuery;
+}
+
+
+jclass Soprano::Sesame2::JNICache::classTupleQueryResult() const
+{
+    return d->classTupleQueryResult;
+}
+
+
+jmethodID Soprano::Sesame2::JNICache::methodURIToString() const
+{
+    return d->methodURIToString;
+}
+
+
+jmethodID Soprano::Sesame2::JNICache::methodBNodeGetID() const
+{
+    return d->methodBNodeGetID;
+}
+
+
+jmethodID Soprano::Sesame2::JNICache::methodLiteralGetLabel() const
+{
+    return d->methodLiteralGetLabel;
+}
+
+
+jmethodID Soprano::Sesame2::JNICache::methodLiteralGetLanguage() const
+{
+    return d->methodLiteralGetLanguage;
+}
+
+
+jmethodID Soprano::Sesame2::JNICache::methodLiteralGetDatatype() const
+{
+    return d->methodLiteralGetDatatype;
+}
+
+
+jmethodID Soprano::Sesame2::JNICache::methodStatementGetSubject() const
+{
+    return d->methodStatementGetSubject;
+}
+
+
+jmethodID Soprano::Sesame2::JNICache::methodStatementGetPredicate() const
+{
+    return d->methodStatementGetPredicate;
+}
+
+
+jmethodID Soprano::Sesame2::JNICache::methodStatementGetObject() const
+{
+    return d->methodStatementGetObject;
+}
+
+
+jmethodID Soprano::Sesame2::JNICache::methodStatementGetContext() const
+{
+    return d->methodStatementGetContext;
+}
+
+
+jmethodID Soprano::Sesame2::JNICache::methodBindingSetGetValue() const
+{
+    return d->methodBindingSetGetValue;
+}
+
+
+JObjectRef Soprano::Sesame2::JNICache::sparqlQueryLanguage() const
+{
+    return d->sparqlQueryLanguage;
+}
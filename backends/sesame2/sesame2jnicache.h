@@ -0,0 +1,103 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _SESAME2_JNI_CACHE_H_
+#define _SESAME2_JNI_CACHE_H_
+
+#include <jni.h>
+
+#include "jobjectref.h"
+
+namespace Soprano {
+    namespace Sesame2 {
+        /**
+         * Global references to the Sesame2 classes and the method ids
+         * used for every converted node and statement. Looking them up
+         * via FindClass and GetMethodID on each call is expensive and
+         * creates local references, thus they are resolved once when
+         * the backend creates its first model.
+         *
+         * jclass and jmethodID values stay valid in all threads as long
+         * as the class is not unloaded which the global references prevent.
+         */
+        class JNICache
+        {
+        public:
+            /**
+             * Resolve all classes and method ids. Does nothing if
+             * the cache has already been initialized.
+             *
+             * \return \p true on success.
+             */
+            static bool initialize();
+
+            /**
+             * Release all global references. Needs to be called before
+             * the Java VM is destroyed.
+             */
+            static void cleanup();
+
+            /**
+             * \return The cache or 0 if initialize() has not been called.
+             */
+            static JNICache* instance();
+
+            jclass classString() const;
+            jclass classURI() const;
+            jclass classBNode() const;
+            jclass classLiteral() const;
+            jclass classCloseableIteration() const;
+            jclass classTupleQuery() const;
+            jclass classGraphQuery() const;
+            jclass classTupleQueryResult() const;
+
+            jmethodID methodURIToString() const;
+            jmethodID methodBNodeGetID() const;
+            jmethodID methodLiteralGetLabel() const;
+            jmethodID methodLiteralGetLanguage() const;
+            jmethodID methodLiteralGetDatatype() const;
+            jmethodID methodStatementGetSubject() const;
+            jmethodID methodStatementGetPredicate() const;
+            jmethodID methodStatementGetObject() const;
+            jmethodID methodStatementGetContext() const;
+            jmethodID methodBindingSetGetValue() const;
+
+            /**
+             * The static QueryLanguage.SPARQL field value as a
+             * global reference.
+             */
+            JObjectRef sparqlQueryLanguage() const;
+
+        private:
+            JNICache();
+            ~JNICache();
+
+            bool resolve();
+
+            static JNICache* s_instance;
+
+            class Private;
+            Private* const d;
+        };
+    }
+}
+
+#endif
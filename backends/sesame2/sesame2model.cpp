@@ -24,6 +24,7 @@
 #include "sesame2repositoryconnection.h"
 #include "sesame2utils.h"
 #include "sesame2types.h"
+#include "sesame2jnicache.h"
 #include "sesame2valuefactory.h"
 #include "sesame2iterator.h"
 #include "sesame2statementiteratorbackend.h"
@@ -44,6 +45,12 @@
 #include <QtCore/QWriteLocker>
 
 
+namespace {
+    /// the number of statements added in one JNI call and transaction
+    const int s_addBlockSize = 500;
+}
+
+
 class Soprano::Sesame2::Model::Private {
 public:
     RepositoryWrapper* repository;
@@ -105,6 +112,58 @@ Soprano::Error::ErrorCode Soprano::Sesame2::Model::addStatement( const Statement
 }
 
 
+Soprano::Error::ErrorCode Soprano::Sesame2::Model::addStatements( const QList<Statement>& statements )
+{
+    for ( int i = 0; i < statements.count(); ++i ) {
+        if ( !statements[i].isValid() ) {
+            setError( "Invalid statement", Error::ErrorInvalidArgument );
+            return Error::ErrorInvalidArgument;
+        }
+    }
+
+    d->readWriteLock.lockForWrite();
+
+    clearError();
+
+    SopranoWrapper* wrapper = d->repository->sopranoWrapper();
+    if ( !wrapper || !wrapper->hasBulkMethods() ) {
+        d->readWriteLock.unlock();
+        return Soprano::Model::addStatements( statements );
+    }
+
+    int added = 0;
+    while ( added < statements.count() ) {
+        QList<Statement> block = statements.mid( added, s_addBlockSize );
+        {
+            JNILocalFrame frame;
+            wrapper->addStatements( block );
+        }
+        if ( JNIWrapper::instance()->exceptionOccured() ) {
+            qDebug() << "(Soprano::Sesame2::Model::addStatements) failed to add" << block.count() << "statements.";
+            setError( JNIWrapper::instance()->convertAndClearException() );
+            break;
+        }
+        added += block.count();
+    }
+
+    d->readWriteLock.unlock();
+
+    if ( added ) {
+        for ( int i = 0; i < added; ++i ) {
+            emit statementAdded( statements[i] );
+        }
+        emit statementsAdded();
+    }
+
+    if ( added < statements.count() ) {
+        return Error::ErrorUnknown;
+    }
+    else {
+        return Error::ErrorNone;
+    }
+}
+
+
 Soprano::NodeIterator Soprano::Sesame2::Model::listContexts() const
 {
     d->readWriteLock.lockForRead();
@@ -141,23 +200,17 @@ Soprano::QueryResultIterator Soprano::Sesame2::Model::executeQuery( const QStrin
         return QueryResultIterator();
     }
 
-    jfieldID sparqlID = JNIWrapper::instance()->env()->GetStaticFieldID( JNIWrapper::instance()->env()->FindClass( ORG_OPENRDF_QUERY_QUERYLANGUAGE ),
-                                                                         "SPARQL",
-                                                                         "L" ORG_OPENRDF_QUERY_QUERYLANGUAGE ";" );
-    JObjectRef sparqlQueryLang = JNIWrapper::instance()->env()->GetStaticObjectField( JNIWrapper::instance()->env()->FindClass( ORG_OPENRDF_QUERY_QUERYLANGUAGE ),
-                                                                                      sparqlID );
-
-    JObjectRef queryObject = d->repository->repositoryConnection()->prepareQuery( sparqlQueryLang, JStringRef( query ) );
+    JObjectRef queryObject = d->repository->repositoryConnection()->prepareQuery( JNICache::instance()->sparqlQueryLanguage(), JStringRef( query ) );
 
     if ( queryObject ) {
         QueryResultIteratorBackend* it = 0;
 
         // evaluate the query
-        if ( JNIWrapper::instance()->env()->IsInstanceOf( queryObject, JNIWrapper::instance()->env()->FindClass( ORG_OPENRDF_QUERY_TUPLEQUERY ) ) ) {
+        if ( JNIWrapper::instance()->env()->IsInstanceOf( queryObject, JNICache::instance()->classTupleQuery() ) ) {
             JNIObjectWrapper queryWrapper( queryObject );
             it = new QueryResultIteratorBackend( queryWrapper.callObjectMethod( queryWrapper.getMethodID( "evaluate", "()L" ORG_OPENRDF_QUERY_TUPLEQUERYRESULT ";" ) ), this );
         }
-        else if ( JNIWrapper::instance()->env()->IsInstanceOf( queryObject, JNIWrapper::instance()->env()->FindClass( ORG_OPENRDF_QUERY_GRAPHQUERY ) ) ) {
+        else if ( JNIWrapper::instance()->env()->IsInstanceOf( queryObject, JNICache::instance()->classGraphQuery() ) ) {
             JNIObjectWrapper queryWrapper( queryObject );
             it = new QueryResultIteratorBackend( queryWrapper.callObjectMethod( queryWrapper.getMethodID( "evaluate", "()L" ORG_OPENRDF_QUERY_GRAPHQUERYRESULT ";" ) ), this );
         }
@@ -222,7 +275,8 @@ Soprano::StatementIterator Soprano::Sesame2::Model::listStatements( const Statem
         return StatementIterator();
     }
     else {
-        StatementIteratorBackend* it = new StatementIteratorBackend( results, this );
+        SopranoWrapper* wrapper = d->repository->sopranoWrapper();
+        StatementIteratorBackend* it = new StatementIteratorBackend( results, this, wrapper && wrapper->hasBulkMethods() ? wrapper : 0 );
         d->statementIterators.append( it );
         return it;
     }
@@ -460,3 +514,5 @@ void Soprano::Sesame2::Model::removeIterator( QueryResultIteratorBackend* r ) co
     d->queryIterators.removeAll( r );
     d->readWriteLock.unlock();
 }
+
+#include "moc_sesame2model.cpp"
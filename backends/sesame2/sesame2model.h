@@ -40,11 +40,22 @@ namespace Soprano {
 
         class Model : public StorageModel
         {
+            Q_OBJECT
+
         public:
             Model( const Backend* backend, RepositoryWrapper* sesame2Repository );
             ~Model();
 
             Error::ErrorCode addStatement( const Statement &statement );
+
+            /**
+             * Hides the generic Model::addStatements which adds statement by statement.
+             * The statements are handed to Java in blocks, each added in one transaction.
+             * Invokable to make it available to clients which do not know the
+             * backend types. The backend reports the user feature "bulkAdd".
+             */
+            Q_INVOKABLE Soprano::Error::ErrorCode addStatements( const QList<Soprano::Statement>& statements );
+
             NodeIterator listContexts() const;
             QueryResultIterator executeQuery( const QString &query, Query::QueryLanguage language, const QString& userQueryLanguage = QString() ) const;
             StatementIterator listStatements( const Statement &partial ) const;
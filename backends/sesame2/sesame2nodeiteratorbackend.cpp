@@ -61,12 +61,16 @@ Soprano::Sesame2::NodeIteratorBackend::~NodeIteratorBackend()
 
 bool Soprano::Sesame2::NodeIteratorBackend::next()
 {
-    if ( d->result.hasNext() ) {
-        JObjectRef next = d->result.next();
-        if ( next ) {
-            clearError();
-            d->current = convertNode( next );
-            return true;
+    {
+        // release the local references created by the conversion at once
+        JNILocalFrame frame;
+        if ( d->result.hasNext() ) {
+            JObjectRef next = d->result.next();
+            if ( next ) {
+                clearError();
+                d->current = convertNode( next );
+                return true;
+            }
         }
     }
 
@@ -23,6 +23,7 @@
 #include "sesame2iterator.h"
 #include "sesame2utils.h"
 #include "sesame2types.h"
+#include "sesame2jnicache.h"
 #include "sesame2bindingset.h"
 #include "sesame2model.h"
 #include "jniwrapper.h"
@@ -49,7 +50,7 @@ public:
           booleanResult( false ),
           isBooleanResult( false ) {
         isTupleResult = JNIWrapper::instance()->env()->IsInstanceOf( result_,
-                                                                     JNIWrapper::instance()->env()->FindClass( ORG_OPENRDF_QUERY_TUPLEQUERYRESULT ) );
+                                                                     JNICache::instance()->classTupleQueryResult() );
 
         // cache the binding names, it is just simpler
         if ( isTupleResult ) {
@@ -105,17 +106,22 @@ bool Soprano::Sesame2::QueryResultIteratorBackend::next()
         return false;
     }
 
-    if ( d->result->hasNext() ) {
-        JObjectRef next = d->result->next();
-        if ( next ) {
-            if ( d->isTupleResult ) {
-                d->currentBindings.setObject( next );
+    {
+        // release the local references created by the conversion at once
+        JNILocalFrame frame;
+        if ( d->result->hasNext() ) {
+            JObjectRef next = d->result->next();
+            if ( next ) {
+                if ( d->isTupleResult ) {
+                    // the binding set outlives the frame
+                    d->currentBindings.setObject( next.toGlobalRef() );
+                }
+                else {
+                    d->currentStatement = convertStatement( next );
+                }
+
+                return true;
             }
-            else {
-                d->currentStatement = convertStatement( next );
-            }
-
-            return true;
         }
     }
 
@@ -22,6 +22,12 @@
 #include "sesame2sopranowrapper.h"
 #include "jniwrapper.h"
 #include "sesame2types.h"
+#include "sesame2jnicache.h"
+#include "sesame2utils.h"
+
+#include "statement.h"
+
+#include <QtCore/QDebug>
 
 
 class Soprano::Sesame2::SopranoWrapper::Private
@@ -29,7 +35,10 @@ class Soprano::Sesame2::SopranoWrapper::Private
 public:
     Private( SopranoWrapper* parent )
         : m_parent( parent ),
-          m_IDremoveFromDefaultContext( 0 ) {
+          m_IDremoveFromDefaultContext( 0 ),
+          m_IDaddStatements( 0 ),
+          m_IDnextStatements( 0 ),
+          m_bulkMethodsResolved( false ) {
     }
 
     jmethodID IDremoveFromDefaultContext() {
@@ -41,10 +50,52 @@ public:
         return m_IDremoveFromDefaultContext;
     }
 
+    /**
+     * Look up a method which might be missing in an old installed wrapper class.
+     * Unlike JNIObjectWrapper::getMethodID() the NoSuchMethodError is cleared
+     * without dumping it.
+     */
+    jmethodID optionalMethodID( const char* name, const char* signature ) {
+        JNIEnv* env = JNIWrapper::instance()->env();
+        JClassRef clazz = env->GetObjectClass( m_parent->object() );
+        jmethodID id = env->GetMethodID( clazz, name, signature );
+        if ( !id ) {
+            env->ExceptionClear();
+        }
+        return id;
+    }
+
+    bool resolveBulkMethods() {
+        if ( !m_bulkMethodsResolved ) {
+            m_IDaddStatements = optionalMethodID( "addStatements",
+                                                  "([L" JAVA_LANG_STRING ";)V" );
+            m_IDnextStatements = optionalMethodID( "nextStatements",
+                                                   "(L" INFO_ADUNA_ITERATION_ITERATION ";I)[L" JAVA_LANG_STRING ";" );
+            if ( !m_IDaddStatements || !m_IDnextStatements ) {
+                qDebug() << "(Soprano::Sesame2::SopranoWrapper) outdated SopranoSesame2Wrapper class. Falling back to single statement transfer.";
+            }
+            m_bulkMethodsResolved = true;
+        }
+        return m_IDaddStatements && m_IDnextStatements;
+    }
+
+    jmethodID IDaddStatements() {
+        resolveBulkMethods();
+        return m_IDaddStatements;
+    }
+
+    jmethodID IDnextStatements() {
+        resolveBulkMethods();
+        return m_IDnextStatements;
+    }
+
 private:
     SopranoWrapper* m_parent;
 
     jmethodID m_IDremoveFromDefaultContext;
+    jmethodID m_IDaddStatements;
+    jmethodID m_IDnextStatements;
+    bool m_bulkMethodsResolved;
 };
 
 
@@ -66,3 +117,56 @@ void Soprano::Sesame2::SopranoWrapper::removeFromDefaultContext( const JObjectRe
 {
     callVoidMethod( d->IDremoveFromDefaultContext(), subject.data(), predicate.data(), object.data() );
 }
+
+
+bool Soprano::Sesame2::SopranoWrapper::hasBulkMethods()
+{
+    return d->resolveBulkMethods();
+}
+
+
+void Soprano::Sesame2::SopranoWrapper::addStatements( const QList<Statement>& statements )
+{
+    JNIEnv* env = JNIWrapper::instance()->env();
+
+    JObjectRef array = env->NewObjectArray( statements.count(), JNICache::instance()->classString(), 0 );
+    if ( !array ) {
+        return;
+    }
+
+    for ( int i = 0; i < statements.count(); ++i ) {
+        JStringRef s( encodeStatement( statements[i] ) );
+        if ( !s ) {
+            return;
+        }
+        env->SetObjectArrayElement( reinterpret_cast<jobjectArray>( array.data() ), i, s.data() );
+    }
+
+    callVoidMethod( d->IDaddStatements(), array.data() );
+}
+
+
+bool Soprano::Sesame2::SopranoWrapper::nextStatements( const JObjectRef& iteration, int max, QList<Statement>& statements )
+{
+    statements.clear();
+
+    JObjectRef array = callObjectMethod( d->IDnextStatements(), iteration.data(), max );
+    if ( !array ) {
+        return true;
+    }
+
+    JNIEnv* env = JNIWrapper::instance()->env();
+    jobjectArray stringArray = reinterpret_cast<jobjectArray>( array.data() );
+    jsize count = env->GetArrayLength( stringArray );
+    for ( jsize i = 0; i < count; ++i ) {
+        JStringRef s( reinterpret_cast<jstring>( env->GetObjectArrayElement( stringArray, i ) ) );
+        Statement statement;
+        if ( !decodeStatement( s.toQString(), statement ) ) {
+            statements.clear();
+            return false;
+        }
+        statements.append( statement );
+    }
+
+    return true;
+}
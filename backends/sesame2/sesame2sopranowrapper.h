@@ -25,14 +25,20 @@
 #include "jniobjectwrapper.h"
 #include "jobjectref.h"
 
+#include <QtCore/QList>
+
 namespace Soprano {
+
+    class Statement;
+
     namespace Sesame2 {
         /**
          * Wrapper class around our own SopranoSesame2Wrapper
-         * which has only one purpose:
+         * which has two purposes:
          * Passing "(Resource)null" as context parameter to
          * RepositoryConnection.remove() since I have no idea
-         * how to cast in JNI (if even possible).
+         * how to cast in JNI (if even possible), and transferring
+         * statements in bulk to save JNI calls.
          */
         class SopranoWrapper : public JNIObjectWrapper
         {
@@ -42,6 +48,30 @@ namespace Soprano {
 
             void removeFromDefaultContext( const JObjectRef& subject, const JObjectRef& predicate, const JObjectRef& object );
 
+            /**
+             * \return \p false if the installed SopranoSesame2Wrapper
+             * class predates the bulk methods.
+             */
+            bool hasBulkMethods();
+
+            /**
+             * Add all statements in one transaction.
+             *
+             * method throws exceptions
+             */
+            void addStatements( const QList<Statement>& statements );
+
+            /**
+             * Fetch up to \p max statements from a Sesame iteration into
+             * \p statements. Fewer statements are only returned once the
+             * iteration is exhausted.
+             *
+             * method throws exceptions
+             *
+             * \return \p false if a statement could not be decoded.
+             */
+            bool nextStatements( const JObjectRef& iteration, int max, QList<Statement>& statements );
+
         private:
             class Private;
             Private* const d;
@@ -23,32 +23,75 @@
 #include "sesame2iterator.h"
 #include "sesame2utils.h"
 #include "sesame2model.h"
+#include "sesame2sopranowrapper.h"
 #include "jniwrapper.h"
 
 #include "statement.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QList>
+
+
+namespace {
+    /// the number of statements fetched with one JNI call
+    const int s_fetchSize = 100;
+}
 
 
 class Soprano::Sesame2::StatementIteratorBackend::Private
 {
 public:
     Private( const JObjectRef& result_ )
-        : result( result_ ) {
+        : result( result_ ),
+          sopranoWrapper( 0 ),
+          exhausted( false ),
+          malformed( false ) {
     }
 
+    bool nextBlock();
+
     Iterator result;
 
     Statement current;
 
+    SopranoWrapper* sopranoWrapper;
+    QList<Statement> buffer;
+    bool exhausted;
+    bool malformed;
+
     const Model* model;
 };
 
 
-Soprano::Sesame2::StatementIteratorBackend::StatementIteratorBackend( const JObjectRef& result, const Model* model )
+bool Soprano::Sesame2::StatementIteratorBackend::Private::nextBlock()
+{
+    if ( exhausted ) {
+        return false;
+    }
+
+    // release the references created while fetching at once
+    JNILocalFrame frame;
+    if ( !sopranoWrapper->nextStatements( result.object(), s_fetchSize, buffer ) ) {
+        exhausted = true;
+        malformed = true;
+        result.close();
+        return false;
+    }
+    if ( buffer.count() < s_fetchSize ) {
+        exhausted = true;
+        if ( !JNIWrapper::instance()->exceptionOccured() ) {
+            result.close();
+        }
+    }
+    return !buffer.isEmpty();
+}
+
+
+Soprano::Sesame2::StatementIteratorBackend::StatementIteratorBackend( const JObjectRef& result, const Model* model, SopranoWrapper* wrapper )
     : d( new Private( result ) )
 {
     d->model = model;
+    d->sopranoWrapper = wrapper;
 }
 
 
@@ -61,13 +104,32 @@ Soprano::Sesame2::StatementIteratorBackend::~StatementIteratorBackend()
 
 bool Soprano::Sesame2::StatementIteratorBackend::next()
 {
-    if ( d->result.hasNext() ) {
-        JObjectRef next = d->result.next();
-        if ( next ) {
+    if ( d->sopranoWrapper ) {
+        if ( !d->buffer.isEmpty() || d->nextBlock() ) {
             clearError();
-            d->current = convertStatement( next );
+            d->current = d->buffer.takeFirst();
             return true;
         }
+        if ( d->malformed ) {
+            setError( "Received a malformed statement from Sesame2", Error::ErrorParsingFailed );
+        }
+        else {
+            setError( JNIWrapper::instance()->convertAndClearException() );
+        }
+        return false;
+    }
+
+    {
+        // release the local references created by the conversion at once
+        JNILocalFrame frame;
+        if ( d->result.hasNext() ) {
+            JObjectRef next = d->result.next();
+            if ( next ) {
+                clearError();
+                d->current = convertStatement( next );
+                return true;
+            }
+        }
     }
 
     // if there is an exception d->result returns false and it
@@ -35,11 +35,16 @@ namespace Soprano {
     namespace Sesame2 {
 
     class Model;
+    class SopranoWrapper;
 
     class StatementIteratorBackend : public Soprano::IteratorBackend<Statement>
     {
     public:
-        StatementIteratorBackend( const JObjectRef& result, const Model* model );
+        /**
+         * \param wrapper If not 0 statements are fetched in blocks through
+         * SopranoWrapper::nextStatements() instead of one by one.
+         */
+        StatementIteratorBackend( const JObjectRef& result, const Model* model, SopranoWrapper* wrapper = 0 );
         ~StatementIteratorBackend();
 
         bool next();
@@ -54,6 +54,7 @@
 #define ORG_OPENRDF_QUERY_GRAPHQUERYRESULT "org/openrdf/query/GraphQueryResult"
 #define ORG_OPENRDF_QUERY_BINDINGSET "org/openrdf/query/BindingSet"
 
+#define INFO_ADUNA_ITERATION_ITERATION "info/aduna/iteration/Iteration"
 #define INFO_ADUNA_ITERATION_CLOSABLEITERATION "info/aduna/iteration/CloseableIteration"
 
 #endif
@@ -22,50 +22,155 @@
 #include "sesame2utils.h"
 #include "jniwrapper.h"
 #include "sesame2types.h"
+#include "sesame2jnicache.h"
 #include "jniobjectwrapper.h"
 
 #include "statement.h"
 #include "node.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QString>
+
+
+namespace {
+    void encodeField( QString& s, const QString& field )
+    {
+        s += QString::number( field.length() );
+        s += QLatin1Char( ':' );
+        s += field;
+    }
+
+    void encodeNode( QString& s, const Soprano::Node& node )
+    {
+        switch( node.type() ) {
+        case Soprano::Node::ResourceNode:
+            s += QLatin1Char( 'u' );
+            encodeField( s, QString::fromLatin1( node.uri().toEncoded() ) );
+            break;
+
+        case Soprano::Node::BlankNode:
+            s += QLatin1Char( 'b' );
+            encodeField( s, node.identifier() );
+            break;
+
+        case Soprano::Node::LiteralNode:
+            if ( node.literal().isPlain() ) {
+                s += QLatin1Char( 'l' );
+                encodeField( s, node.toString() );
+                encodeField( s, node.language() );
+            }
+            else {
+                s += QLatin1Char( 't' );
+                encodeField( s, node.toString() );
+                encodeField( s, QString::fromLatin1( node.dataType().toEncoded() ) );
+            }
+            break;
+
+        default:
+            s += QLatin1Char( 'n' );
+            break;
+        }
+    }
+
+    bool decodeField( const QString& s, int& pos, QString& field )
+    {
+        int colon = s.indexOf( QLatin1Char( ':' ), pos );
+        if ( colon < 0 ) {
+            return false;
+        }
+        bool ok = false;
+        int length = s.mid( pos, colon - pos ).toInt( &ok );
+        if ( !ok || length < 0 || colon + 1 + length > s.length() ) {
+            return false;
+        }
+        field = s.mid( colon + 1, length );
+        pos = colon + 1 + length;
+        return true;
+    }
+
+    bool decodeNode( const QString& s, int& pos, Soprano::Node& node )
+    {
+        if ( pos >= s.length() ) {
+            return false;
+        }
+
+        QString value;
+        QString extra;
+        switch( s[pos++].toLatin1() ) {
+        case 'n':
+            node = Soprano::Node();
+            return true;
+
+        case 'u':
+            if ( !decodeField( s, pos, value ) ) {
+                return false;
+            }
+            node = Soprano::Node( QUrl::fromEncoded( value.toLatin1() ) );
+            return true;
+
+        case 'b':
+            if ( !decodeField( s, pos, value ) ) {
+                return false;
+            }
+            node = Soprano::Node( value );
+            return true;
+
+        case 'l':
+            if ( !decodeField( s, pos, value ) || !decodeField( s, pos, extra ) ) {
+                return false;
+            }
+            node = Soprano::Node( Soprano::LiteralValue::createPlainLiteral( value, extra ) );
+            return true;
+
+        case 't':
+            if ( !decodeField( s, pos, value ) || !decodeField( s, pos, extra ) ) {
+                return false;
+            }
+            node = Soprano::Node( Soprano::LiteralValue::fromString( value, QUrl::fromEncoded( extra.toLatin1() ) ) );
+            return true;
+
+        default:
+            return false;
+        }
+    }
+}
 
 
 QUrl Soprano::Sesame2::convertURI( const JObjectRef& uri )
 {
     JNIObjectWrapper uriWrapper( uri );
-    JStringRef uriString = uriWrapper.callObjectMethod( uriWrapper.getMethodID( "toString", "()L" JAVA_LANG_STRING ";" ) );
+    JStringRef uriString = uriWrapper.callObjectMethod( JNICache::instance()->methodURIToString() );
     return QUrl::fromEncoded( uriString.toAscii() );
 }
 
 
 Soprano::Node Soprano::Sesame2::convertNode( const JObjectRef& resource )
 {
-    JNIObjectWrapper resourceWrapper( resource );
-
-    JClassRef classURI = JNIWrapper::instance()->env()->FindClass( ORG_OPENRDF_MODEL_URI );
-    JClassRef classBNode = JNIWrapper::instance()->env()->FindClass( ORG_OPENRDF_MODEL_BNODE );
-    JClassRef classLiteral = JNIWrapper::instance()->env()->FindClass( ORG_OPENRDF_MODEL_LITERAL );
-
     if ( !resource ) {
         // empty node
         return Node();
     }
-    else if ( JNIWrapper::instance()->env()->IsInstanceOf( resource, classURI ) ) {
+
+    JNIEnv* env = JNIWrapper::instance()->env();
+    JNICache* cache = JNICache::instance();
+    JNIObjectWrapper resourceWrapper( resource );
+
+    if ( env->IsInstanceOf( resource, cache->classURI() ) ) {
         return convertURI( resource );
     }
-    else if ( JNIWrapper::instance()->env()->IsInstanceOf( resource, classBNode ) ) {
-        JStringRef uri = resourceWrapper.callObjectMethod( resourceWrapper.getMethodID( "getID", "()L" JAVA_LANG_STRING ";" ) );
+    else if ( env->IsInstanceOf( resource, cache->classBNode() ) ) {
+        JStringRef uri = resourceWrapper.callObjectMethod( cache->methodBNodeGetID() );
         return Node( uri.toQString() );
     }
-    else if ( JNIWrapper::instance()->env()->IsInstanceOf( resource, classLiteral ) ) {
-        JStringRef value = resourceWrapper.callObjectMethod( resourceWrapper.getMethodID( "getLabel", "()L" JAVA_LANG_STRING ";" ) );
-        JStringRef lang = resourceWrapper.callObjectMethod( resourceWrapper.getMethodID( "getLanguage", "()L" JAVA_LANG_STRING ";" ) );
-        JObjectRef dataType = resourceWrapper.callObjectMethod( resourceWrapper.getMethodID( "getDatatype", "()L" ORG_OPENRDF_MODEL_URI ";" ) );
+    else if ( env->IsInstanceOf( resource, cache->classLiteral() ) ) {
+        JStringRef value = resourceWrapper.callObjectMethod( cache->methodLiteralGetLabel() );
+        JObjectRef dataType = resourceWrapper.callObjectMethod( cache->methodLiteralGetDatatype() );
 
         if ( dataType ) {
             return Node( LiteralValue::fromString( value.toQString(), convertURI( dataType ) ) );
         }
         else {
+            JStringRef lang = resourceWrapper.callObjectMethod( cache->methodLiteralGetLanguage() );
             return Node( LiteralValue::createPlainLiteral( value.toQString(), lang.toQString() ) );
         }
     }
@@ -78,15 +183,46 @@ Soprano::Node Soprano::Sesame2::convertNode( const JObjectRef& resource )
 
 Soprano::Statement Soprano::Sesame2::convertStatement( const JObjectRef& o )
 {
+    JNICache* cache = JNICache::instance();
     JNIObjectWrapper statementWrapper( o );
 
-    JObjectRef subject = statementWrapper.callObjectMethod( statementWrapper.getMethodID( "getSubject", "()L" ORG_OPENRDF_MODEL_RESOURCE ";" ) );
-    JObjectRef predicate = statementWrapper.callObjectMethod( statementWrapper.getMethodID( "getPredicate", "()L" ORG_OPENRDF_MODEL_URI ";" ) );
-    JObjectRef object = statementWrapper.callObjectMethod( statementWrapper.getMethodID( "getObject", "()L" ORG_OPENRDF_MODEL_VALUE ";" ) );
-    JObjectRef context = statementWrapper.callObjectMethod( statementWrapper.getMethodID( "getContext", "()L" ORG_OPENRDF_MODEL_RESOURCE ";" ) );
+    JObjectRef subject = statementWrapper.callObjectMethod( cache->methodStatementGetSubject() );
+    JObjectRef predicate = statementWrapper.callObjectMethod( cache->methodStatementGetPredicate() );
+    JObjectRef object = statementWrapper.callObjectMethod( cache->methodStatementGetObject() );
+    JObjectRef context = statementWrapper.callObjectMethod( cache->methodStatementGetContext() );
 
     return Statement( convertNode( subject ),
                       convertNode( predicate ),
                       convertNode( object ),
                       convertNode( context ) );
 }
+
+
+QString Soprano::Sesame2::encodeStatement( const Statement& statement )
+{
+    QString s;
+    encodeNode( s, statement.subject() );
+    encodeNode( s, statement.predicate() );
+    encodeNode( s, statement.object() );
+    encodeNode( s, statement.context() );
+    return s;
+}
+
+
+bool Soprano::Sesame2::decodeStatement( const QString& s, Statement& statement )
+{
+    int pos = 0;
+    Node subject, predicate, object, context;
+    if ( decodeNode( s, pos, subject ) &&
+         decodeNode( s, pos, predicate ) &&
+         decodeNode( s, pos, object ) &&
+         decodeNode( s, pos, context ) &&
+         pos == s.length() ) {
+        statement = Statement( subject, predicate, object, context );
+        return true;
+    }
+    else {
+        qDebug() << "(Soprano::Sesame2::decodeStatement) malformed statement:" << s;
+        return false;
+    }
+}
@@ -27,6 +27,7 @@
 #include "jobjectref.h"
 
 class QUrl;
+class QString;
 
 namespace Soprano {
 
@@ -37,6 +38,18 @@ namespace Soprano {
     QUrl convertURI( const JObjectRef& uri );
     Node convertNode( const JObjectRef& resource );
     Statement convertStatement( const JObjectRef& o );
+
+    /**
+     * Encode a statement in the string format used by the bulk methods
+     * of SopranoSesame2Wrapper (see SopranoSesame2Wrapper.java).
+     */
+    QString encodeStatement( const Statement& statement );
+
+    /**
+     * Decode a statement encoded by SopranoSesame2Wrapper into \p statement.
+     * \return \p false if \p s is malformed.
+     */
+    bool decodeStatement( const QString& s, Statement& statement );
     }
 }
 
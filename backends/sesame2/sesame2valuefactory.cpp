@@ -28,6 +28,9 @@
 #include "literalvalue.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QCache>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
 
 
 class Soprano::Sesame2::ValueFactory::Private
@@ -41,7 +44,30 @@ public:
           m_IDcreateLiteralWithLang( 0 ),
           m_IDcreateLiteralWithDataType( 0 ),
           m_IDcreateStatement( 0 ),
-          m_IDcreateStatementWithContext( 0 ) {
+          m_IDcreateStatementWithContext( 0 ),
+          m_uriCache( 1000 ) {
+    }
+
+    /**
+     * Predicates, types, contexts, and literal datatypes are converted
+     * over and over again. Reusing the Java URI objects (held as global
+     * references) saves a Java string and a createURI call each time.
+     */
+    JObjectRef convertUri( const QUrl& uri ) {
+        QMutexLocker lock( &m_uriCacheMutex );
+        if ( JObjectRef* cachedUri = m_uriCache.object( uri ) ) {
+            return *cachedUri;
+        }
+
+        JStringRef s( uri.toEncoded() );
+        JObjectRef javaUri = m_parent->callObjectMethod( IDcreateURI(), s.data() );
+        if ( !javaUri ) {
+            return javaUri;
+        }
+
+        JObjectRef globalUri = javaUri.toGlobalRef();
+        m_uriCache.insert( uri, new JObjectRef( globalUri ) );
+        return globalUri;
     }
 
     jmethodID IDcreateURI() {
@@ -117,6 +143,9 @@ private:
     jmethodID m_IDcreateLiteralWithDataType;
     jmethodID m_IDcreateStatement;
     jmethodID m_IDcreateStatementWithContext;
+
+    QCache<QUrl, JObjectRef> m_uriCache;
+    QMutex m_uriCacheMutex;
 };
 
 
@@ -142,10 +171,8 @@ JObjectRef Soprano::Sesame2::ValueFactory::createBNode()
 JObjectRef Soprano::Sesame2::ValueFactory::convertNode( const Node& node )
 {
     switch( node.type() ) {
-    case Node::ResourceNode: {
-        JStringRef s( node.uri().toEncoded() );
-        return callObjectMethod( d->IDcreateURI(), s.data() );
-    }
+    case Node::ResourceNode:
+        return d->convertUri( node.uri() );
 
     case Node::BlankNode:
         return callObjectMethod( d->IDcreateBNodeFromString(), JStringRef( node.identifier() ).data() );
@@ -161,8 +188,7 @@ JObjectRef Soprano::Sesame2::ValueFactory::convertNode( const Node& node )
         }
         else{
             JStringRef ns( node.toString() );
-            JStringRef dtus( node.dataType().toEncoded() );
-            JObjectRef dataTypeUri = callObjectMethod( d->IDcreateURI(), dtus.data() );
+            JObjectRef dataTypeUri = d->convertUri( node.dataType() );
             return callObjectMethod( d->IDcreateLiteralWithDataType(),
                                      ns.data(),
                                      dataTypeUri.data() );
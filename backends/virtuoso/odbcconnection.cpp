@@ -30,7 +30,132 @@
 #include "virtuosotools.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QScopedPointer>
 #include <QtCore/QThread>
+#include <QtCore/QVector>
+
+#include <string.h>
+
+
+namespace {
+    /// the maximum number of rows sent in one parameter array
+    const int s_maxParamSetSize = 500;
+
+    /**
+     * Each node is passed as three parameters as expected by bif:__rdf_long_from_batch_params:
+     * the node type, the value, and the datatype or language.
+     *
+     * All values are stored column-wise which allows to bind any number of
+     * rows at once via ODBC parameter arrays.
+     */
+    class ParameterBuffer
+    {
+    public:
+        ParameterBuffer( const QList<QList<Soprano::Node> >& rows, int start, int count );
+
+        int rowCount() const { return m_rowCount; }
+        void bind( HSTMT hstmt );
+
+    private:
+        class StringColumn
+        {
+        public:
+            void fill( const QVector<QByteArray>& values );
+
+            QByteArray buffer;
+            SQLLEN elementSize;
+            QVector<SQLLEN> lengths;
+        };
+
+        class NodeColumn
+        {
+        public:
+            QVector<SQLSMALLINT> modes;
+            StringColumn values;
+            StringColumn dtOrLangs;
+        };
+
+        int m_rowCount;
+        QVector<NodeColumn> m_columns;
+    };
+
+
+    void ParameterBuffer::StringColumn::fill( const QVector<QByteArray>& values )
+    {
+        elementSize = 1;
+        for ( int i = 0; i < values.count(); ++i ) {
+            elementSize = qMax<SQLLEN>( elementSize, values[i].length() );
+        }
+
+        buffer = QByteArray( elementSize * values.count(), '\0' );
+        lengths.resize( values.count() );
+        for ( int i = 0; i < values.count(); ++i ) {
+            memcpy( buffer.data() + i * elementSize, values[i].constData(), values[i].length() );
+            lengths[i] = values[i].length();
+        }
+    }
+
+
+    ParameterBuffer::ParameterBuffer( const QList<QList<Soprano::Node> >& rows, int start, int count )
+        : m_rowCount( count )
+    {
+        const int nodeCount = rows[start].count();
+        m_columns.resize( nodeCount );
+
+        for ( int c = 0; c < nodeCount; ++c ) {
+            NodeColumn& column = m_columns[c];
+            column.modes.resize( count );
+            QVector<QByteArray> values( count );
+            QVector<QByteArray> dtOrLangs( count );
+
+            for ( int r = 0; r < count; ++r ) {
+                const Soprano::Node& node = rows[start + r][c];
+
+                // We do *not* parameterize blank nodes
+                if ( node.isResource() ) {
+                    column.modes[r] = 1;
+                    values[r] = node.uri().toEncoded();
+                    dtOrLangs[r] = values[r]; // ignored
+                }
+                else if ( node.isLiteral() ) {
+                    values[r] = node.literal().toString().toUtf8();
+                    if ( !node.literal().dataTypeUri().isEmpty() ) {
+                        column.modes[r] = 4;
+                        dtOrLangs[r] = node.literal().dataTypeUri().toEncoded();
+                    }
+                    else if ( node.literal().language().isValid() ) {
+                        column.modes[r] = 5;
+                        dtOrLangs[r] = node.literal().language().toString().toUtf8();
+                    }
+                    else {
+                        column.modes[r] = 3;
+                    }
+                }
+            }
+
+            column.values.fill( values );
+            column.dtOrLangs.fill( dtOrLangs );
+        }
+    }
+
+
+    void ParameterBuffer::bind( HSTMT hstmt )
+    {
+        SQLSetStmtAttr( hstmt, SQL_ATTR_PARAM_BIND_TYPE, ( SQLPOINTER )SQL_PARAM_BIND_BY_COLUMN, 0 );
+        SQLSetStmtAttr( hstmt, SQL_ATTR_PARAMSET_SIZE, ( SQLPOINTER )( SQLULEN )m_rowCount, 0 );
+
+        // counter for the parameter index
+        int i = 1;
+        for ( int c = 0; c < m_columns.count(); ++c ) {
+            NodeColumn& column = m_columns[c];
+            SQLBindParameter( hstmt, i++, SQL_PARAM_INPUT, SQL_C_SSHORT, SQL_SMALLINT, 0, 0, column.modes.data(), 0, 0 );
+            SQLBindParameter( hstmt, i++, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_CHAR, column.values.elementSize, 0,
+                              column.values.buffer.data(), column.values.elementSize, column.values.lengths.data() );
+            SQLBindParameter( hstmt, i++, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_CHAR, column.dtOrLangs.elementSize, 0,
+                              column.dtOrLangs.buffer.data(), column.dtOrLangs.elementSize, column.dtOrLangs.lengths.data() );
+        }
+    }
+}
 
 
 Soprano::ODBC::Connection::Connection()
@@ -45,12 +170,13 @@ Soprano::ODBC::Connection::~Connection()
 {
     qDebug() << Q_FUNC_INFO << QThread::currentThread();
 
-    d->m_pool->m_connectionMutex.lock();
-    d->m_pool->m_openConnections.remove( d->m_pool->m_openConnections.key( this ) );
-    d->m_pool->m_connectionMutex.unlock();
+    d->m_pool->connectionDestroyed( this );
 
     qDeleteAll( d->m_openResults );
 
+    // statement handles need to be freed before disconnecting
+    d->m_preparedStatements.clear();
+
     if ( d->m_hdbc ) {
         SQLDisconnect( d->m_hdbc );
         SQLFreeHandle( SQL_HANDLE_DBC, d->m_hdbc );
@@ -63,7 +189,7 @@ Soprano::ODBC::Connection::~Connection()
 
 void Soprano::ODBC::Connection::cleanup()
 {
-    delete this;
+    d->m_pool->releaseConnection( this );
 }
 
 
@@ -71,14 +197,78 @@ Soprano::Error::ErrorCode Soprano::ODBC::Connection::executeCommand( const QStri
 {
 //    qDebug() << Q_FUNC_INFO << command;
 
-    Error::ErrorCode result = Error::ErrorNone;
-
     HSTMT hstmt = execute( command, params );
     if ( hstmt ) {
         SQLCloseCursor( hstmt );
         SQLFreeHandle( SQL_HANDLE_STMT, hstmt );
+        return Error::ErrorNone;
+    }
+    else {
+        return Error::convertErrorCode( lastError().code() );
+    }
+}
+
+
+Soprano::Error::ErrorCode Soprano::ODBC::Connection::executeBatchCommand( const QString& command, const QList<QList<Soprano::Node> >& paramRows, bool cachePrepared )
+{
+    PreparedStatement* stmt = prepare( command, cachePrepared );
+    if ( !stmt ) {
+        return Error::convertErrorCode( lastError().code() );
+    }
+
+    // uncached statements are ours to delete
+    QScopedPointer<PreparedStatement> oneShotStmt( cachePrepared ? 0 : stmt );
+
+    for ( int start = 0; start < paramRows.count(); start += s_maxParamSetSize ) {
+        // the buffer needs to stay valid until SQLExecute returns
+        ParameterBuffer params( paramRows, start, qMin( s_maxParamSetSize, paramRows.count() - start ) );
+        params.bind( stmt->m_hstmt );
+
+        if ( !SQL_SUCCEEDED( SQLExecute( stmt->m_hstmt ) ) ) {
+            setError( Virtuoso::convertSqlError( SQL_HANDLE_STMT, stmt->m_hstmt, QLatin1String( "SQLExecute failed on command '" ) + command + '\'' ) );
+            // do not reuse a statement in an unknown state
+            if ( cachePrepared ) {
+                d->m_preparedStatements.remove( command );
+            }
+            return Error::convertErrorCode( lastError().code() );
+        }
+
+        // reset the handle for the next execution
+        SQLFreeStmt( stmt->m_hstmt, SQL_CLOSE );
+        SQLFreeStmt( stmt->m_hstmt, SQL_RESET_PARAMS );
+    }
+
+    clearError();
+    return Error::ErrorNone;
+}
+
+
+Soprano::ODBC::PreparedStatement* Soprano::ODBC::Connection::prepare( const QString& command, bool cache )
+{
+    if ( cache ) {
+        if ( PreparedStatement* stmt = d->m_preparedStatements.object( command ) ) {
+            return stmt;
+        }
+    }
+
+    HSTMT hstmt;
+    if ( SQLAllocHandle( SQL_HANDLE_STMT, d->m_hdbc, &hstmt ) != SQL_SUCCESS ) {
+        setError( Virtuoso::convertSqlError( SQL_HANDLE_DBC, d->m_hdbc ) );
+        return 0;
+    }
+
+    QByteArray utf8Command = command.toUtf8();
+    if ( !SQL_SUCCEEDED( SQLPrepare( hstmt, ( UCHAR* )utf8Command.data(), utf8Command.length() ) ) ) {
+        setError( Virtuoso::convertSqlError( SQL_HANDLE_STMT, hstmt, QLatin1String( "SQLPrepare failed on command '" ) + command + '\'' ) );
+        SQLFreeHandle( SQL_HANDLE_STMT, hstmt );
+        return 0;
+    }
+
+    PreparedStatement* stmt = new PreparedStatement( hstmt );
+    if ( cache ) {
+        d->m_preparedStatements.insert( command, stmt );
     }
-    return result;
+    return stmt;
 }
 
 
@@ -108,52 +298,12 @@ HSTMT Soprano::ODBC::Connection::execute( const QString& request, const QList<So
         return 0;
     }
     else {
-        // counter for the parameter index
-        int i = 1;
-        // counter for the node index
-        int ni = 0;
-
-        // each parameter requires its own variable which can be referenced by a pointer
-        // since we never use more than 4 nodes for now (we only use parameters for adding statements)
-        // we can stick to a fixed number of variables
-        SQLSMALLINT mode[4];
-        QVector<QByteArray> values(4);
-        QVector<QByteArray> dtOrLangs(4);
-
-        // the type vars can be shared as they do not change
-        SQLLEN cbInt = 0;
-        SQLLEN cbChar = SQL_NTS;
-
-        // run through all nodes and create the parameters
-        // We do *not* parameterize blank nodes
-        foreach(const Soprano::Node& node, params) {
-            if(node.isResource()) {
-                mode[ni] = 1;
-                values[ni] = node.uri().toEncoded();
-                SQLBindParameter( hstmt, i++, SQL_PARAM_INPUT, SQL_C_SSHORT, SQL_SMALLINT, 0, 0, &(mode[ni]), 0, &cbInt);
-                SQLBindParameter( hstmt, i++, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_CHAR, values[ni].length(), 0, values[ni].data(), 0, &cbChar);
-                SQLBindParameter( hstmt, i++, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_CHAR, values[ni].length(), 0, values[ni].data(), 0, &cbChar); // ignored
-            }
-            else if(node.isLiteral()) {
-                values[ni] = node.literal().toString().toUtf8();
-                if(!node.literal().dataTypeUri().isEmpty()) {
-                    mode[ni] = 4;
-                    dtOrLangs[ni] = node.literal().dataTypeUri().toEncoded();
-                }
-                else if(node.literal().language().isValid()) {
-                    mode[ni] = 5;
-                    dtOrLangs[ni] = node.literal().language().toString().toUtf8();
-                }
-                else {
-                    mode[ni] = 3;
-                }
-                SQLBindParameter( hstmt, i++, SQL_PARAM_INPUT, SQL_C_SSHORT, SQL_SMALLINT, 0, 0, &(mode[ni]), 0, &cbInt);
-                SQLBindParameter( hstmt, i++, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_CHAR, values[ni].length(), 0, values[ni].data(), 0, &cbChar);
-                SQLBindParameter( hstmt, i++, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_CHAR, dtOrLangs[ni].length(), 0, dtOrLangs[ni].data(), 0, &cbChar);
-            }
-
-            ++ni;
+        // the buffer needs to stay valid until SQLExecDirect returns
+        ParameterBuffer paramBuffer( QList<QList<Soprano::Node> >() << params, 0, 1 );
+        if ( !params.isEmpty() ) {
+            paramBuffer.bind( hstmt );
         }
+
         QByteArray utf8Request = request.toUtf8();
         if ( !SQL_SUCCEEDED( SQLExecDirect( hstmt, ( UCHAR* )utf8Request.data(), utf8Request.length() ) ) ) {
             setError( Virtuoso::convertSqlError( SQL_HANDLE_STMT, hstmt, QLatin1String( "SQLExecDirect failed on query '" ) + request + '\'' ) );
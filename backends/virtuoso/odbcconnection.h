@@ -40,6 +40,7 @@ namespace Soprano {
         class Environment;
         class ConnectionPrivate;
         class QueryResult;
+        class PreparedStatement;
 
         class Connection : public QObject, public Soprano::Error::ErrorCache
         {
@@ -48,7 +49,24 @@ namespace Soprano {
         public:
             ~Connection();
 
+            /**
+             * Execute \p command directly. Use executeBatchCommand() for commands
+             * which are executed over and over again.
+             */
             Error::ErrorCode executeCommand( const QString& command, const QList<Soprano::Node>& params = QList<Soprano::Node>() );
+
+            /**
+             * Execute the parameterized \p command once for each of the \p paramRows
+             * which all need to contain the same number of nodes. The rows are sent
+             * to the server in blocks using ODBC parameter arrays.
+             *
+             * The command is prepared once. Unless \p cachePrepared is \p false the
+             * prepared statement is cached for subsequent calls with the same command
+             * text. Commands which will not repeat should not be cached since they
+             * would only evict useful entries.
+             */
+            Error::ErrorCode executeBatchCommand( const QString& command, const QList<QList<Soprano::Node> >& paramRows, bool cachePrepared = true );
+
             QueryResult* executeQuery( const QString& request );
 
         public Q_SLOTS:
@@ -58,6 +76,7 @@ namespace Soprano {
             Connection();
 
             HSTMT execute( const QString& query, const QList<Soprano::Node>& params = QList<Soprano::Node>() );
+            PreparedStatement* prepare( const QString& command, bool cache );
 
             ConnectionPrivate* const d;
 
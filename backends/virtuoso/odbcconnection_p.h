@@ -26,12 +26,32 @@
 
 #include <QtCore/QList>
 #include <QtCore/QUrl>
+#include <QtCore/QCache>
+#include <QtCore/QString>
 
 namespace Soprano {
     namespace ODBC {
 
         class ConnectionPoolPrivate;
         class Environment;
+        class QueryResult;
+
+        /**
+         * A statement handle prepared via SQLPrepare which can be executed
+         * over and over again with different parameters.
+         */
+        class PreparedStatement
+        {
+        public:
+            PreparedStatement( HSTMT hstmt )
+                : m_hstmt( hstmt ) {
+            }
+            ~PreparedStatement() {
+                SQLFreeHandle( SQL_HANDLE_STMT, m_hstmt );
+            }
+
+            HSTMT m_hstmt;
+        };
 
         class ConnectionPrivate
         {
@@ -39,12 +59,16 @@ namespace Soprano {
             ConnectionPrivate()
                 : m_env( 0 ),
                   m_hdbc( SQL_NULL_HANDLE ) {
+                m_preparedStatements.setMaxCost( 50 );
             }
 
             Environment* m_env;
             HDBC m_hdbc;
             ConnectionPoolPrivate* m_pool;
             QList<QueryResult*> m_openResults;
+
+            /// prepared commands, keyed by the command text
+            QCache<QString, PreparedStatement> m_preparedStatements;
         };
     }
 }
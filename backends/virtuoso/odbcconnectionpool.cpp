@@ -32,6 +32,7 @@
 #include <QtCore/QMutexLocker>
 
 #include <sql.h>
+#include <sqlext.h>
 
 
 Soprano::ODBC::Connection* Soprano::ODBC::ConnectionPoolPrivate::createConnection()
@@ -95,6 +96,100 @@ Soprano::ODBC::Connection* Soprano::ODBC::ConnectionPoolPrivate::createConnectio
 }
 
 
+bool Soprano::ODBC::ConnectionPoolPrivate::isConnectionAlive( Connection* conn )
+{
+#ifdef SQL_ATTR_CONNECTION_DEAD
+    SQLUINTEGER dead = SQL_CD_FALSE;
+    if ( SQL_SUCCEEDED( SQLGetConnectAttr( conn->d->m_hdbc, SQL_ATTR_CONNECTION_DEAD, &dead, 0, 0 ) ) ) {
+        return dead != SQL_CD_TRUE;
+    }
+#else
+    Q_UNUSED( conn );
+#endif
+    // assume the best if the driver cannot tell
+    return true;
+}
+
+
+void Soprano::ODBC::ConnectionPoolPrivate::releaseConnection( Connection* conn )
+{
+    QMutexLocker lock( &m_connectionMutex );
+
+    QThread* thread = m_openConnections.key( conn );
+    if ( !thread ) {
+        return;
+    }
+    m_openConnections.remove( thread );
+
+    // the thread may emit more than one of the signals we connected to
+    QObject::disconnect( thread, 0, conn, 0 );
+
+    QList<Connection*> discarded;
+    takeExpiredConnections( discarded );
+
+    // connections with open results are in an unknown state
+    if ( conn->d->m_openResults.isEmpty() &&
+         m_idleConnections.count() < m_maxIdleConnections &&
+         isConnectionAlive( conn ) ) {
+        IdleConnection idle;
+        idle.connection = conn;
+        idle.idleSince = QDateTime::currentDateTime();
+        m_idleConnections.append( idle );
+        m_connectionReleased.wakeOne();
+    }
+    else {
+        discarded.append( conn );
+    }
+
+    // the Connection destructor calls connectionDestroyed()
+    lock.unlock();
+    qDeleteAll( discarded );
+}
+
+
+void Soprano::ODBC::ConnectionPoolPrivate::connectionDestroyed( Connection* conn )
+{
+    QMutexLocker lock( &m_connectionMutex );
+    m_openConnections.remove( m_openConnections.key( conn ) );
+    for ( int i = 0; i < m_idleConnections.count(); ++i ) {
+        if ( m_idleConnections[i].connection == conn ) {
+            m_idleConnections.removeAt( i );
+            break;
+        }
+    }
+    m_connectionReleased.wakeOne();
+}
+
+
+void Soprano::ODBC::ConnectionPoolPrivate::takeExpiredConnections( QList<Connection*>& discarded )
+{
+    const QDateTime now = QDateTime::currentDateTime();
+
+    // the oldest connections are at the front
+    while ( !m_idleConnections.isEmpty() &&
+            m_idleConnections.first().idleSince.msecsTo( now ) > m_idleTimeout ) {
+        discarded.append( m_idleConnections.takeFirst().connection );
+    }
+}
+
+
+Soprano::ODBC::Connection* Soprano::ODBC::ConnectionPoolPrivate::takeIdleConnection( QList<Connection*>& discarded )
+{
+    takeExpiredConnections( discarded );
+
+    // reuse the most recently released connection to let the others expire
+    while ( !m_idleConnections.isEmpty() ) {
+        Connection* conn = m_idleConnections.takeLast().connection;
+        if ( isConnectionAlive( conn ) ) {
+            return conn;
+        }
+        discarded.append( conn );
+    }
+
+    return 0;
+}
+
+
 
 Soprano::ODBC::ConnectionPool::ConnectionPool( const QString& odbcConnectString,
                                                const QStringList& connectionSetupCommands,
@@ -113,6 +208,8 @@ Soprano::ODBC::ConnectionPool::~ConnectionPool()
     // cannot use qDeleteAll since Connection's destructor will change m_openConnections
     while( !d->m_openConnections.isEmpty() )
         delete d->m_openConnections.begin().value();
+    while( !d->m_idleConnections.isEmpty() )
+        delete d->m_idleConnections.first().connection;
     delete d;
 }
 
@@ -129,8 +226,35 @@ Soprano::ODBC::Connection* Soprano::ODBC::ConnectionPool::connection()
         return *it;
     }
 
-    Connection* conn = d->createConnection();
+    QList<Connection*> discarded;
+    Connection* conn = 0;
+    while ( !conn ) {
+        conn = d->takeIdleConnection( discarded );
+        if ( conn ) {
+            ++d->m_connectionsReused;
+            break;
+        }
+        else if ( d->m_maxConnections <= 0 ||
+                  d->m_openConnections.count() + d->m_idleConnections.count() < d->m_maxConnections ) {
+            conn = d->createConnection();
+            if ( !conn ) {
+                setError( d->lastError() );
+                break;
+            }
+            ++d->m_connectionsCreated;
+        }
+        else {
+            ++d->m_connectionWaits;
+            if ( !d->m_connectionReleased.wait( &d->m_connectionMutex, d->m_waitTimeout ) ) {
+                ++d->m_connectionWaitTimeouts;
+                setError( QString::fromLatin1( "Timeout waiting for one of the %1 ODBC connections to be released." ).arg( d->m_maxConnections ) );
+                break;
+            }
+        }
+    }
+
     if(conn) {
+        clearError();
         d->m_openConnections.insert( QThread::currentThread(), conn );
         // using the cleanup slot rather than deleteLater to not depend on any event loop
         connect( QThread::currentThread(), SIGNAL(finished()),
@@ -143,6 +267,80 @@ Soprano::ODBC::Connection* Soprano::ODBC::ConnectionPool::connection()
                  conn, SLOT(cleanup()),
                  Qt::DirectConnection );
     }
+
+    lock.unlock();
+    qDeleteAll( discarded );
+
     return conn;
 }
 
+
+void Soprano::ODBC::ConnectionPool::setMaxConnections( int max )
+{
+    QMutexLocker lock( &d->m_connectionMutex );
+    d->m_maxConnections = max;
+    d->m_connectionReleased.wakeAll();
+}
+
+
+void Soprano::ODBC::ConnectionPool::setMaxIdleConnections( int max )
+{
+    QMutexLocker lock( &d->m_connectionMutex );
+    d->m_maxIdleConnections = max;
+}
+
+
+void Soprano::ODBC::ConnectionPool::setIdleTimeout( int msecs )
+{
+    QMutexLocker lock( &d->m_connectionMutex );
+    d->m_idleTimeout = msecs;
+}
+
+
+void Soprano::ODBC::ConnectionPool::setWaitTimeout( int msecs )
+{
+    QMutexLocker lock( &d->m_connectionMutex );
+    d->m_waitTimeout = msecs;
+}
+
+
+int Soprano::ODBC::ConnectionPool::openConnectionCount() const
+{
+    QMutexLocker lock( &d->m_connectionMutex );
+    return d->m_openConnections.count() + d->m_idleConnections.count();
+}
+
+
+int Soprano::ODBC::ConnectionPool::idleConnectionCount() const
+{
+    QMutexLocker lock( &d->m_connectionMutex );
+    return d->m_idleConnections.count();
+}
+
+
+qint64 Soprano::ODBC::ConnectionPool::connectionsCreated() const
+{
+    QMutexLocker lock( &d->m_connectionMutex );
+    return d->m_connectionsCreated;
+}
+
+
+qint64 Soprano::ODBC::ConnectionPool::connectionsReused() const
+{
+    QMutexLocker lock( &d->m_connectionMutex );
+    return d->m_connectionsReused;
+}
+
+
+qint64 Soprano::ODBC::ConnectionPool::connectionWaits() const
+{
+    QMutexLocker lock( &d->m_connectionMutex );
+    return d->m_connectionWaits;
+}
+
+
+qint64 Soprano::ODBC::ConnectionPool::connectionWaitTimeouts() const
+{
+    QMutexLocker lock( &d->m_connectionMutex );
+    return d->m_connectionWaitTimeouts;
+}
@@ -46,9 +46,50 @@ namespace Soprano {
 
             /**
              * Get the connection for the current thread.
+             *
+             * A thread keeps its connection until it finishes. Then the connection
+             * is kept idle for reuse by other threads. If the maximum number of
+             * connections is reached the call blocks until another thread releases
+             * its connection or the wait timeout is reached.
              */
             Connection* connection();
 
+            /**
+             * The maximum number of open connections. 0, the default, means unlimited.
+             */
+            void setMaxConnections( int max );
+
+            /**
+             * The maximum number of idle connections kept for reuse. Defaults to 10.
+             */
+            void setMaxIdleConnections( int max );
+
+            /**
+             * Idle connections are closed once they have been idle for more than \p msecs
+             * milliseconds. There is no timer, expired connections are closed the next time
+             * a connection is requested or released. Defaults to one minute.
+             */
+            void setIdleTimeout( int msecs );
+
+            /**
+             * The maximum time connection() waits for a free connection. Defaults to 30 seconds.
+             */
+            void setWaitTimeout( int msecs );
+
+            /**
+             * The number of connections currently in use or idle.
+             */
+            int openConnectionCount() const;
+            int idleConnectionCount() const;
+
+            /**
+             * Usage statistics since the pool was created.
+             */
+            qint64 connectionsCreated() const;
+            qint64 connectionsReused() const;
+            qint64 connectionWaits() const;
+            qint64 connectionWaitTimeouts() const;
+
         private:
             ConnectionPoolPrivate* const d;
         };
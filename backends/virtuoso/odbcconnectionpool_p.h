@@ -25,7 +25,10 @@
 #include "error.h"
 
 #include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QMutex>
+#include <QtCore/QWaitCondition>
+#include <QtCore/QDateTime>
 #include <QtCore/QStringList>
 
 class QThread;
@@ -39,14 +42,74 @@ namespace Soprano {
         class ConnectionPoolPrivate : public Error::ErrorCache
         {
         public:
+            ConnectionPoolPrivate()
+                : m_maxConnections( 0 ),
+                  m_maxIdleConnections( 10 ),
+                  m_idleTimeout( 60000 ),
+                  m_waitTimeout( 30000 ),
+                  m_connectionsCreated( 0 ),
+                  m_connectionsReused( 0 ),
+                  m_connectionWaits( 0 ),
+                  m_connectionWaitTimeouts( 0 ) {
+            }
+
+            class IdleConnection
+            {
+            public:
+                Connection* connection;
+                QDateTime idleSince;
+            };
+
             QString m_odbcConnectString;
             QStringList m_connectionSetupCommands;
 
+            /// connections in use, each one belongs to one thread until it finishes
             QHash<QThread*, Connection*> m_openConnections;
 
+            /// connections released by finished threads, the most recently released last
+            QList<IdleConnection> m_idleConnections;
+
+            int m_maxConnections;
+            int m_maxIdleConnections;
+            int m_idleTimeout;
+            int m_waitTimeout;
+
+            qint64 m_connectionsCreated;
+            qint64 m_connectionsReused;
+            qint64 m_connectionWaits;
+            qint64 m_connectionWaitTimeouts;
+
             Connection* createConnection();
 
+            /**
+             * Called once the thread owning \p conn finished. Keeps the
+             * connection for reuse by other threads if possible.
+             */
+            void releaseConnection( Connection* conn );
+
+            /**
+             * Called from the Connection destructor.
+             */
+            void connectionDestroyed( Connection* conn );
+
+            /**
+             * Take a healthy idle connection. Expired and dead idle connections are
+             * moved to \p discarded to be deleted once the mutex is unlocked.
+             * Requires m_connectionMutex to be locked.
+             */
+            Connection* takeIdleConnection( QList<Connection*>& discarded );
+
+            /**
+             * Move the idle connections which exceeded the idle timeout to \p discarded.
+             * There is no timer, this is done whenever a connection is requested or released.
+             * Requires m_connectionMutex to be locked.
+             */
+            void takeExpiredConnections( QList<Connection*>& discarded );
+
+            static bool isConnectionAlive( Connection* conn );
+
             QMutex m_connectionMutex;
+            QWaitCondition m_connectionReleased;
 
             friend class Connection;
         };
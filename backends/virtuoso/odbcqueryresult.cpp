@@ -36,6 +36,20 @@
 #include <QtCore/QScopedPointer>
 #include <QtCore/QDebug>
 
+#include <string.h>
+
+
+namespace {
+    /// the maximum size in bytes of a bound column buffer
+    const SQLULEN s_maxBoundColumnSize = 4096;
+
+    /// the buffer size used for columns with unknown or large sizes
+    const SQLULEN s_defaultBoundColumnSize = 256;
+
+    /// column sizes count characters while SQL_C_CHAR data is UTF-8
+    const SQLULEN s_maxUtf8CharSize = 4;
+}
+
 
 Soprano::ODBC::QueryResult::QueryResult()
     : d( new QueryResultPrivate() )
@@ -67,17 +81,19 @@ QStringList Soprano::ODBC::QueryResult::resultColumns()
                 SQLTCHAR colName[51];
                 colName[50] = 0;
                 SQLSMALLINT colType;
+                SQLULEN colSize = 0;
                 if ( SQLDescribeCol( d->m_hstmt,
                                      col,
                                      (SQLTCHAR *) colName,
                                      50,
                                      0,
                                      &colType,
-                                     0,
+                                     &colSize,
                                      0,
                                      0) == SQL_SUCCESS ) {
                     d->m_columns.append( QString::fromLatin1( ( const char* )colName ) );
                     d->m_columTypes.append( colType );
+                    d->m_columnSizes.append( colSize );
                 }
                 else {
                     setError( Virtuoso::convertSqlError( SQL_HANDLE_STMT, d->m_hstmt, QLatin1String( "SQLDescribeCol failed" ) ) );
@@ -91,8 +107,97 @@ QStringList Soprano::ODBC::QueryResult::resultColumns()
 }
 
 
+bool Soprano::ODBC::QueryResult::enableBlockFetch( int rowCount )
+{
+    if ( rowCount <= 1 || d->m_rowArraySize > 1 ) {
+        return false;
+    }
+
+    const int columnCount = resultColumns().count();
+    if ( lastError() || columnCount == 0 ) {
+        return false;
+    }
+
+    // Any value may exceed its buffer, the column sizes reported by the driver are not
+    // reliable for all types. Truncated values can only be fetched again if the driver
+    // allows SQLGetData on bound columns in a block cursor.
+    SQLUINTEGER getDataExtensions = 0;
+    if ( SQL_SUCCEEDED( SQLGetInfo( d->m_conn->m_hdbc, SQL_GETDATA_EXTENSIONS, &getDataExtensions, sizeof( getDataExtensions ), 0 ) ) ) {
+        d->m_canGetBoundData = ( ( getDataExtensions & SQL_GD_BLOCK ) && ( getDataExtensions & SQL_GD_BOUND ) );
+    }
+    if ( !d->m_canGetBoundData ) {
+        return false;
+    }
+
+    QVector<ColumnBuffer> buffers( columnCount );
+    for ( int i = 0; i < columnCount; ++i ) {
+        SQLULEN size = d->m_columnSizes[i] * s_maxUtf8CharSize;
+        if ( isBlob( i+1 ) || size == 0 || size > s_maxBoundColumnSize ) {
+            size = s_defaultBoundColumnSize;
+        }
+        buffers[i].elementSize = size + 1; // the terminating null char
+        buffers[i].data = QByteArray( buffers[i].elementSize * rowCount, '\0' );
+        buffers[i].indicators.resize( rowCount );
+    }
+
+    if ( !SQL_SUCCEEDED( SQLSetStmtAttr( d->m_hstmt, SQL_ATTR_ROW_BIND_TYPE, ( SQLPOINTER )SQL_BIND_BY_COLUMN, 0 ) ) ||
+         !SQL_SUCCEEDED( SQLSetStmtAttr( d->m_hstmt, SQL_ATTR_ROW_ARRAY_SIZE, ( SQLPOINTER )( SQLULEN )rowCount, 0 ) ) ||
+         !SQL_SUCCEEDED( SQLSetStmtAttr( d->m_hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &d->m_rowsFetched, 0 ) ) ) {
+        SQLSetStmtAttr( d->m_hstmt, SQL_ATTR_ROW_ARRAY_SIZE, ( SQLPOINTER )1, 0 );
+        return false;
+    }
+
+    d->m_columnBuffers = buffers;
+    for ( int i = 0; i < columnCount; ++i ) {
+        ColumnBuffer& buffer = d->m_columnBuffers[i];
+        if ( !SQL_SUCCEEDED( SQLBindCol( d->m_hstmt, i+1, SQL_C_CHAR, buffer.data.data(), buffer.elementSize, buffer.indicators.data() ) ) ) {
+            SQLFreeStmt( d->m_hstmt, SQL_UNBIND );
+            SQLSetStmtAttr( d->m_hstmt, SQL_ATTR_ROW_ARRAY_SIZE, ( SQLPOINTER )1, 0 );
+            SQLSetStmtAttr( d->m_hstmt, SQL_ATTR_ROWS_FETCHED_PTR, 0, 0 );
+            d->m_columnBuffers.clear();
+            return false;
+        }
+    }
+
+    d->m_rowArraySize = rowCount;
+    d->m_rowsFetched = 0;
+    d->m_currentRow = 0;
+    return true;
+}
+
+
 bool Soprano::ODBC::QueryResult::fetchRow()
 {
+    if ( d->m_rowArraySize > 1 ) {
+        if ( ++d->m_currentRow >= d->m_rowsFetched ) {
+            int sts = SQLFetch( d->m_hstmt );
+            d->m_currentRow = 0;
+            if ( sts == SQL_NO_DATA_FOUND ) {
+                d->m_rowsFetched = 0;
+                clearError();
+                return false;
+            }
+            // SQL_SUCCESS_WITH_INFO signals truncated values which are fetched later on
+            else if ( !SQL_SUCCEEDED( sts ) ) {
+                d->m_rowsFetched = 0;
+                setError( Virtuoso::convertSqlError( SQL_HANDLE_STMT, d->m_hstmt, QLatin1String( "SQLFetch failed" ) ) );
+                return false;
+            }
+            else if ( d->m_rowsFetched == 0 ) {
+                clearError();
+                return false;
+            }
+        }
+
+        // The Virtuoso column meta data as well as SQLGetData refer to the current row in the rowset
+        if ( !SQL_SUCCEEDED( SQLSetPos( d->m_hstmt, d->m_currentRow + 1, SQL_POSITION, SQL_LOCK_NO_CHANGE ) ) ) {
+            setError( Virtuoso::convertSqlError( SQL_HANDLE_STMT, d->m_hstmt, QLatin1String( "SQLSetPos failed" ) ) );
+            return false;
+        }
+        clearError();
+        return true;
+    }
+
     int sts = SQLFetch( d->m_hstmt );
     if ( sts == SQL_NO_DATA_FOUND ) {
         clearError();
@@ -112,8 +217,8 @@ Soprano::Node Soprano::ODBC::QueryResult::getData( int colNum )
 {
     SQLCHAR* data = 0;
     SQLLEN length = 0;
-    if ( getCharData( colNum, &data, &length ) ) {
-        SQLHDESC hdesc = 0;
+    bool haveData = ( d->m_rowArraySize > 1 ? getBoundCharData( colNum, &data, &length ) : getCharData( colNum, &data, &length ) );
+    if ( haveData ) {
         int dvtype = 0;
 
         // easy mem cleanup: never care about data again below
@@ -123,8 +228,8 @@ Soprano::Node Soprano::ODBC::QueryResult::getData( int colNum )
         // Before we can retrieve the column meta data using SQLGetDescField,
         // we first needs to retrieve the correct descriptor handle attached to the statement handle
         //
-        if ( !SQL_SUCCEEDED( SQLGetStmtAttr( d->m_hstmt, SQL_ATTR_IMP_ROW_DESC, &hdesc, SQL_IS_POINTER, 0 ) ) ) {
-            setError( Virtuoso::convertSqlError( SQL_HANDLE_STMT, d->m_hstmt, QLatin1String( "SQLGetStmtAttr failed" ) ) );
+        SQLHDESC hdesc = rowDescriptor();
+        if ( !hdesc ) {
             return Node();
         }
 
@@ -305,6 +410,17 @@ Soprano::Node Soprano::ODBC::QueryResult::getData( int colNum )
 }
 
 
+SQLHDESC Soprano::ODBC::QueryResult::rowDescriptor()
+{
+    if ( !d->m_hdesc &&
+         !SQL_SUCCEEDED( SQLGetStmtAttr( d->m_hstmt, SQL_ATTR_IMP_ROW_DESC, &d->m_hdesc, SQL_IS_POINTER, 0 ) ) ) {
+        d->m_hdesc = 0;
+        setError( Virtuoso::convertSqlError( SQL_HANDLE_STMT, d->m_hstmt, QLatin1String( "SQLGetStmtAttr failed" ) ) );
+    }
+    return d->m_hdesc;
+}
+
+
 bool Soprano::ODBC::QueryResult::isBlob( int colNum )
 {
     return ( d->m_columTypes[colNum-1] == SQL_LONGVARCHAR ||
@@ -375,3 +491,34 @@ bool Soprano::ODBC::QueryResult::getCharData( int colNum, SQLCHAR** buffer, SQLL
         return false;
     }
 }
+
+
+bool Soprano::ODBC::QueryResult::getBoundCharData( int colNum, SQLCHAR** buffer, SQLLEN* length )
+{
+    const ColumnBuffer& column = d->m_columnBuffers[colNum-1];
+    SQLLEN indicator = column.indicators[d->m_currentRow];
+
+    //
+    // Treat a 0 length and null data as an empty node
+    //
+    if ( indicator == SQL_NULL_DATA || indicator == 0 ) {
+        *buffer = 0;
+        *length = 0;
+        clearError();
+        return true;
+    }
+
+    // The value did not fit into the bound buffer. Since the row is positioned
+    // we can simply get the whole value the classic way.
+    if ( indicator == SQL_NO_TOTAL || indicator > column.elementSize - 1 ) {
+        return getCharData( colNum, buffer, length );
+    }
+
+    // the caller takes ownership of the data
+    *buffer = new SQLCHAR[ indicator + 1 ];
+    memcpy( *buffer, column.data.constData() + d->m_currentRow * column.elementSize, indicator );
+    (*buffer)[indicator] = 0;
+    *length = indicator;
+    clearError();
+    return true;
+}
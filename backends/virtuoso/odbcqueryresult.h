@@ -44,6 +44,19 @@ namespace Soprano {
             ~QueryResult();
 
             QStringList resultColumns();
+
+            /**
+             * Fetch \p rowCount rows per round trip into bound column buffers
+             * instead of fetching row by row and calling SQLGetData for each value.
+             * Has to be called before the first call to fetchRow().
+             *
+             * \return \p false if the result or the driver does not allow block
+             * fetching, ie. if the driver cannot fetch values exceeding their
+             * bound buffer via SQLGetData. The result can still be used row by
+             * row in that case.
+             */
+            bool enableBlockFetch( int rowCount );
+
             bool fetchRow();
             Node getData( int colNum );
 
@@ -54,6 +67,8 @@ namespace Soprano {
             QueryResult();
 
             bool getCharData( int colNum, SQLCHAR** buffer, SQLLEN* length );
+            bool getBoundCharData( int colNum, SQLCHAR** buffer, SQLLEN* length );
+            SQLHDESC rowDescriptor();
 
             QueryResultPrivate* const d;
 
@@ -26,6 +26,8 @@
 
 #include <QtCore/QStringList>
 #include <QtCore/QUrl>
+#include <QtCore/QVector>
+#include <QtCore/QByteArray>
 
 
 namespace Soprano {
@@ -33,12 +35,29 @@ namespace Soprano {
 
         class ConnectionPrivate;
 
+        /**
+         * The buffer a column is bound to in block fetch mode. It holds
+         * the values of all rows in the current rowset.
+         */
+        class ColumnBuffer
+        {
+        public:
+            QByteArray data;
+            SQLLEN elementSize;
+            QVector<SQLLEN> indicators;
+        };
+
         class QueryResultPrivate
         {
         public:
             QueryResultPrivate()
                 : m_hstmt( 0 ),
-                  m_conn( 0 ) {
+                  m_conn( 0 ),
+                  m_hdesc( 0 ),
+                  m_rowArraySize( 1 ),
+                  m_rowsFetched( 0 ),
+                  m_currentRow( 0 ),
+                  m_canGetBoundData( false ) {
             }
 
             HSTMT m_hstmt;
@@ -46,6 +65,17 @@ namespace Soprano {
 
             QStringList m_columns;
             QList<SQLSMALLINT> m_columTypes;
+            QList<SQLULEN> m_columnSizes;
+
+            /// the implementation row descriptor, cached for the Virtuoso column meta data
+            SQLHDESC m_hdesc;
+
+            // block fetch mode, only used with m_rowArraySize > 1
+            SQLULEN m_rowArraySize;
+            SQLULEN m_rowsFetched;
+            SQLULEN m_currentRow;
+            bool m_canGetBoundData;
+            QVector<ColumnBuffer> m_columnBuffers;
         };
     }
 }
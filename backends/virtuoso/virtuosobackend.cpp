@@ -83,8 +83,13 @@ Soprano::StorageModel* Soprano::Virtuoso::BackendPlugin::createModel( const Back
     bool debugMode = valueInSettings( settings, BackendOptionUser, QLatin1String( "debugmode" ) ).toBool();
     int queryTimeout = valueInSettings( settings, QLatin1String( "QueryTimeout" ), 0 ).toInt();
     bool disableStatementSignals = valueInSettings( settings, QLatin1String( "noStatementSignals" ), false ).toBool();
+    bool enableBulkRemovalAutocommit = valueInSettings( settings, QLatin1String( "bulkRemovalAutocommit" ), false ).toBool();
     bool enableFakeBookleans = valueInSettings( settings, QLatin1String( "fakeBooleans" ), true ).toBool();
     bool enableEmptyGraphs = valueInSettings( settings, QLatin1String( "emptyGraphs" ), true ).toBool();
+    int maxConnections = valueInSettings( settings, QLatin1String( "maxConnections" ), 0 ).toInt();
+    int maxIdleConnections = valueInSettings( settings, QLatin1String( "maxIdleConnections" ), 10 ).toInt();
+    int connectionIdleTimeout = valueInSettings( settings, QLatin1String( "connectionIdleTimeout" ), 60000 ).toInt();
+    int connectionWaitTimeout = valueInSettings( settings, QLatin1String( "connectionWaitTimeout" ), 30000 ).toInt();
 
     VirtuosoController* controller = 0;
     QString virtuosoVersion = QLatin1String("1.0.0"); // a default low version in case we connect to a running server
@@ -141,6 +146,10 @@ Soprano::StorageModel* Soprano::Virtuoso::BackendPlugin::createModel( const Back
     }
 
     ODBC::ConnectionPool* connectionPool = new ODBC::ConnectionPool( connectString, connectionSetupCommands );
+    connectionPool->setMaxConnections( maxConnections );
+    connectionPool->setMaxIdleConnections( maxIdleConnections );
+    connectionPool->setIdleTimeout( connectionIdleTimeout );
+    connectionPool->setWaitTimeout( connectionWaitTimeout );
 
     // FIXME: should configuration only be allowed on spawned servers?
     if ( ODBC::Connection* conn = connectionPool->connection() ) {
@@ -157,6 +166,7 @@ Soprano::StorageModel* Soprano::Virtuoso::BackendPlugin::createModel( const Back
     VirtuosoModel* model = new VirtuosoModel( virtuosoVersion, connectionPool,
                                               enableFakeBookleans, enableEmptyGraphs, this );
     model->d->m_noStatementSignals = disableStatementSignals;
+    model->d->m_bulkRemovalAutocommit = enableBulkRemovalAutocommit;
     // mem mangement the ugly way
     // FIXME: improve
     if ( controller ) {
@@ -212,7 +222,15 @@ Soprano::BackendFeatures Soprano::Virtuoso::BackendPlugin::supportedFeatures() c
             BackendFeatureRemoveStatements|
             BackendFeatureListStatements|
             BackendFeatureQuery|
-            BackendFeatureContext );
+            BackendFeatureContext|
+            BackendFeatureUser );
+}
+
+
+QStringList Soprano::Virtuoso::BackendPlugin::supportedUserFeatures() const
+{
+    return QStringList() << QLatin1String( "bulkAdd" )
+                         << QLatin1String( "connectionPoolStatistics" );
 }
 
 
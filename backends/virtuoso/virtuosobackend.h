@@ -49,6 +49,18 @@ namespace Soprano {
             StorageModel* createModel( const BackendSettings& settings = BackendSettings() ) const;
             bool deleteModelData( const BackendSettings& settings ) const;
             BackendFeatures supportedFeatures() const;
+
+            /**
+             * Supported user features are:
+             * \li bulkAdd - The models provide the invokable method
+             *     addStatements() which adds a list of statements using
+             *     as few server round trips as possible.
+             * \li connectionPoolStatistics - The models provide the invokable
+             *     method connectionPoolStatistics() which reports the usage
+             *     of the ODBC connection pool.
+             */
+            QStringList supportedUserFeatures() const;
+
             bool isAvailable() const;
 
             static QString locateVirtuosoBinary();
@@ -32,6 +32,7 @@
 
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
+#include <QtCore/QStringList>
 
 #include <stdlib.h>
 
@@ -47,6 +48,14 @@ namespace {
         }
     }
 
+    // Blank nodes are not parameterized but put into the command text which
+    // thus will most likely never be used again.
+    bool hasBlankNodes( const Soprano::Statement& s ) {
+        return( s.subject().isBlank() ||
+                s.object().isBlank() ||
+                s.context().isBlank() );
+    }
+
     // there is still a bug in Virtuoso which makes the define prefix unusable: if a query defines the
     // graph the result will be empty if the exclude graph is specified.
     const char* s_queryPrefix =
@@ -122,6 +131,56 @@ QString Soprano::VirtuosoModelPrivate::statementToConstructGraphPattern( const S
 }
 
 
+QString Soprano::VirtuosoModelPrivate::insertCommand( const Soprano::Statement& statement, QList<Soprano::Node>& params )
+{
+    if( !statement.isValid() ) {
+        qDebug() << Q_FUNC_INFO << "Cannot add invalid statement:" << statement;
+        q->setError( "Cannot add invalid statement.", Error::ErrorInvalidArgument );
+        return QString();
+    }
+
+    Statement s( statement );
+    if( !s.context().isValid() ) {
+        if ( m_supportEmptyGraphs ) {
+            s.setContext( Virtuoso::defaultGraph() );
+        }
+        else {
+            qDebug() << Q_FUNC_INFO << "Cannot add invalid statement:" << statement;
+            q->setError( "Cannot add statement with invalid context", Error::ErrorInvalidArgument );
+            return QString();
+        }
+    }
+
+    // for adding statements we use ODBC parameters which are way more efficient than plain query strings, especially for long values
+    if(!s.context().isBlank())
+        params << s.context();
+    if(!s.subject().isBlank())
+        params << s.subject();
+    params << s.predicate();
+    if(!s.object().isBlank())
+        params << s.object();
+
+    return QLatin1String("sparql insert into ") + statementToConstructGraphPattern( s, true, true );
+}
+
+
+QString Soprano::VirtuosoModelPrivate::removeFromGraphQuery( const Soprano::Statement& statement ) const
+{
+    if ( !statement.subject().isValid() &&
+         !statement.predicate().isValid() &&
+         !statement.object().isValid() ) {
+        // Virtuoso docu says this might be faster
+        return QString::fromLatin1( "clear graph %1" ).arg( statement.context().toN3() );
+    }
+    else {
+        return QString::fromLatin1( "delete from %1 { %2 } where { %3 }" )
+            .arg( statement.context().toN3(),
+                  statementToConstructGraphPattern( statement, false ),
+                  statementToConstructGraphPattern( statement, true ) );
+    }
+}
+
+
 Soprano::QueryResultIterator Soprano::VirtuosoModelPrivate::sqlQuery( const QString& query )
 {
     if ( ODBC::Connection* conn = connectionPool->connection() ) {
@@ -184,41 +243,19 @@ Soprano::Error::ErrorCode Soprano::VirtuosoModel::addStatement( const Statement&
 {
 //    qDebug() << Q_FUNC_INFO << statement;
 
-    if( !statement.isValid() ) {
-        qDebug() << Q_FUNC_INFO << "Cannot add invalid statement:" << statement;
-        setError( "Cannot add invalid statement.", Error::ErrorInvalidArgument );
-        return Error::ErrorInvalidArgument;
-    }
-
-    Statement s( statement );
-    if( !s.context().isValid() ) {
-        if ( d->m_supportEmptyGraphs ) {
-            s.setContext( Virtuoso::defaultGraph() );
-        }
-        else {
-            qDebug() << Q_FUNC_INFO << "Cannot add invalid statement:" << statement;
-            setError( "Cannot add statement with invalid context", Error::ErrorInvalidArgument );
-            return Error::ErrorInvalidArgument;
-        }
-    }
-
-    // for adding statements we use ODBC parameters which are way more efficient than plain query strings, especially for long values
-    QString insert = QLatin1String("sparql insert into ") + d->statementToConstructGraphPattern( s, true, true );
     QList<Node> paramNodes;
-    if(statement.context().isValid() && !statement.context().isBlank())
-        paramNodes << statement.context();
-    else
-        paramNodes << Virtuoso::defaultGraph();
-    if(statement.subject().isValid() && !statement.subject().isBlank())
-        paramNodes << statement.subject();
-    if(statement.predicate().isValid())
-        paramNodes << statement.predicate();
-    if(statement.object().isValid() && !statement.object().isBlank())
-        paramNodes << statement.object();
+    const QString insert = d->insertCommand( statement, paramNodes );
+    if ( insert.isEmpty() ) {
+        return Error::convertErrorCode( lastError().code() );
+    }
 
     if ( ODBC::Connection* conn = d->connectionPool->connection() ) {
 
-        if ( conn->executeCommand( insert, paramNodes ) == Error::ErrorNone ) {
+        // only prepare commands which will be used again
+        Error::ErrorCode r = hasBlankNodes( statement )
+                             ? conn->executeCommand( insert, paramNodes )
+                             : conn->executeBatchCommand( insert, QList<QList<Node> >() << paramNodes );
+        if ( r == Error::ErrorNone ) {
             clearError();
 
             if(!d->m_noStatementSignals) {
@@ -239,7 +276,81 @@ Soprano::Error::ErrorCode Soprano::VirtuosoModel::addStatement( const Statement&
 }
 
 
+Soprano::Error::ErrorCode Soprano::VirtuosoModel::addStatements( const QList<Statement>& statements )
+{
+    ODBC::Connection* conn = d->connectionPool->connection();
+    if ( !conn ) {
+        setError( d->connectionPool->lastError() );
+        return Error::convertErrorCode( lastError().code() );
+    }
+
+    // Statements with blank nodes result in different commands. Consecutive statements
+    // sharing one command are sent together, which is the common case for imports.
+    int added = 0;
+    bool failed = false;
+    QString currentInsert;
+    bool currentRepeatable = true;
+    QList<QList<Node> > currentParams;
+    for ( int i = 0; i <= statements.count() && !failed; ++i ) {
+        QString insert;
+        QList<Node> paramNodes;
+        if ( i < statements.count() ) {
+            insert = d->insertCommand( statements[i], paramNodes );
+            failed = insert.isEmpty();
+        }
+
+        // flush the pending statements once the command changes, errors, or we are done
+        if ( insert != currentInsert && !currentParams.isEmpty() ) {
+            Error::ErrorCode r = ( !currentRepeatable && currentParams.count() == 1 )
+                                 ? conn->executeCommand( currentInsert, currentParams.first() )
+                                 : conn->executeBatchCommand( currentInsert, currentParams, currentRepeatable );
+            if ( r == Error::ErrorNone ) {
+                added += currentParams.count();
+                currentParams.clear();
+            }
+            else {
+                setError( conn->lastError() );
+                failed = true;
+            }
+        }
+
+        if ( !failed && i < statements.count() ) {
+            currentInsert = insert;
+            currentRepeatable = !hasBlankNodes( statements[i] );
+            currentParams.append( paramNodes );
+        }
+    }
+
+    if ( added && !d->m_noStatementSignals ) {
+        for ( int i = 0; i < added; ++i ) {
+            emit statementAdded( statements[i] );
+        }
+        emit statementsAdded();
+    }
+
+    if ( added < statements.count() ) {
+        return Error::convertErrorCode( lastError().code() );
+    }
+
+    clearError();
+    return Error::ErrorNone;
+}
+
+
 // TODO: use "select GRAPH_IRI from DB.DBA.SPARQL_SELECT_KNOWN_GRAPHS_T"
+QVariantMap Soprano::VirtuosoModel::connectionPoolStatistics() const
+{
+    QVariantMap stats;
+    stats.insert( QLatin1String( "openConnections" ), d->connectionPool->openConnectionCount() );
+    stats.insert( QLatin1String( "idleConnections" ), d->connectionPool->idleConnectionCount() );
+    stats.insert( QLatin1String( "connectionsCreated" ), d->connectionPool->connectionsCreated() );
+    stats.insert( QLatin1String( "connectionsReused" ), d->connectionPool->connectionsReused() );
+    stats.insert( QLatin1String( "connectionWaits" ), d->connectionPool->connectionWaits() );
+    stats.insert( QLatin1String( "connectionWaitTimeouts" ), d->connectionPool->connectionWaitTimeouts() );
+    return stats;
+}
+
+
 Soprano::NodeIterator Soprano::VirtuosoModel::listContexts() const
 {
 //    qDebug() << Q_FUNC_INFO;
@@ -368,27 +479,14 @@ Soprano::Error::ErrorCode Soprano::VirtuosoModel::removeAllStatements( const Sta
 {
 //    qDebug() << Q_FUNC_INFO << statement;
 
-    QString query;
+    QStringList queries;
     if ( statement.context().isValid() ) {
         if ( statement.context().uri() == Virtuoso::openlinkVirtualGraph() ) {
             setError( "Cannot remove statements from the virtual openlink graph. Virtuoso would not like that.", Error::ErrorInvalidArgument );
             return Error::ErrorInvalidArgument;
         }
 
-        if ( statement.context().isValid() &&
-             !statement.subject().isValid() &&
-             !statement.predicate().isValid() &&
-             !statement.object().isValid() ) {
-            // Virtuoso docu says this might be faster
-            query = QString::fromLatin1( "clear graph %1" ).arg( statement.context().toN3() );
-        }
-        else {
-            query = QString::fromLatin1( "delete from %1 { %2 } where { %3 }" )
-                    .arg( statement.context().isValid() ? statement.context().toN3() : QString( "?g" ),
-                          d->statementToConstructGraphPattern( statement, false ),
-                          d->statementToConstructGraphPattern( statement, true ) );
-
-        }
+        queries << d->removeFromGraphQuery( statement );
     }
     else {
         //
@@ -397,7 +495,7 @@ Soprano::Error::ErrorCode Soprano::VirtuosoModel::removeAllStatements( const Sta
         // For versions before we need to use the old hacky method which requires iterating all graph candidates.
         //
         if( d->m_virtuosoVersion >= QLatin1String("6.1.5") ) {
-            query = QString::fromLatin1("delete { %1 } where { %1 }").arg( d->statementToConstructGraphPattern(statement, true) );
+            queries << QString::fromLatin1("delete { %1 } where { %1 }").arg( d->statementToConstructGraphPattern(statement, true) );
         }
         else {
             QList<Node> allContexts = d->sparqlQuery( QString::fromLatin1( "select distinct ?g where { %1 . FILTER(?g != <%2>) . }" )
@@ -417,34 +515,63 @@ Soprano::Error::ErrorCode Soprano::VirtuosoModel::removeAllStatements( const Sta
                         return Error::ErrorInvalidArgument;
                     }
                 }
-                Error::ErrorCode c = removeAllStatements( s );
-                if ( c != Error::ErrorNone )
-                    return c;
+                queries << d->removeFromGraphQuery( s );
+            }
+            if ( queries.isEmpty() ) {
+                clearError();
+                return Error::ErrorNone;
             }
-            return Error::ErrorNone;
         }
     }
 
+    // Deleting a large number of triples in one transaction makes Virtuoso keep
+    // all of them in memory. In row autocommit mode the deletion runs in chunks
+    // on the server. This costs two additional round trips and the removal is
+    // not atomic anymore. Thus, it is only used if enabled and for patterns which
+    // can match many statements, i.e. those with wildcards or several graphs.
+    const bool autocommit = d->m_bulkRemovalAutocommit &&
+                            ( queries.count() > 1 ||
+                              !statement.subject().isValid() ||
+                              !statement.predicate().isValid() ||
+                              !statement.object().isValid() );
+
     if ( ODBC::Connection* conn = d->connectionPool->connection() ) {
-        if ( conn->executeCommand( "sparql " + query ) == Error::ErrorNone ) {
-            if(!d->m_noStatementSignals) {
-                // FIXME: can this be done with SQL/RDF views?
-                emit statementsRemoved();
-                Statement signalStatement( statement );
-                if( signalStatement.context() == Virtuoso::defaultGraph() ) {
-                    if( d->m_supportEmptyGraphs ) {
-                        signalStatement.setContext( Node() );
-                    } else {
-                        qDebug() << Q_FUNC_INFO << "Cannot remove invalid statement:" << statement;
-                        setError( "Cannot remove statement with invalid context", Error::ErrorInvalidArgument );
-                        return Error::ErrorInvalidArgument;
-                    }
-                }
+        if ( autocommit ) {
+            // We ignore the result since older servers might not support it.
+            conn->executeCommand( QLatin1String( "log_enable(3,1)" ) );
+        }
 
-                emit statementRemoved( signalStatement );
+        Error::Error error;
+        foreach( const QString& query, queries ) {
+            conn->executeCommand( QLatin1String( "sparql " ) + query );
+            if ( conn->lastError() ) {
+                error = conn->lastError();
+                break;
             }
         }
-        setError( conn->lastError() );
+
+        if ( autocommit ) {
+            // back to the default transaction mode
+            conn->executeCommand( QLatin1String( "log_enable(1)" ) );
+        }
+
+        setError( error );
+        if( !error && !d->m_noStatementSignals ) {
+            // FIXME: can this be done with SQL/RDF views?
+            emit statementsRemoved();
+            Statement signalStatement( statement );
+            if( signalStatement.context() == Virtuoso::defaultGraph() ) {
+                if( d->m_supportEmptyGraphs ) {
+                    signalStatement.setContext( Node() );
+                } else {
+                    qDebug() << Q_FUNC_INFO << "Cannot remove invalid statement:" << statement;
+                    setError( "Cannot remove statement with invalid context", Error::ErrorInvalidArgument );
+                    return Error::ErrorInvalidArgument;
+                }
+            }
+
+            emit statementRemoved( signalStatement );
+        }
     }
     else {
         setError( d->connectionPool->lastError() );
@@ -25,6 +25,8 @@
 #include "storagemodel.h"
 #include "virtuosocontroller.h"
 
+#include <QtCore/QVariantMap>
+
 namespace Soprano {
     namespace ODBC {
         class ConnectionPool;
@@ -48,6 +50,26 @@ namespace Soprano {
         ~VirtuosoModel();
 
         Error::ErrorCode addStatement( const Statement &statement );
+
+        /**
+         * Adds all \p statements using as few server round trips as possible.
+         * Hides the generic Model::addStatements which adds statement by statement.
+         * Invokable to make it available to clients which do not know the
+         * backend types. The backend reports the user feature "bulkAdd".
+         */
+        Q_INVOKABLE Soprano::Error::ErrorCode addStatements( const QList<Soprano::Statement>& statements );
+
+        /**
+         * Usage statistics of the ODBC connection pool: the current \p openConnections
+         * and \p idleConnections and, since the model was created, the number of
+         * \p connectionsCreated, \p connectionsReused, \p connectionWaits, and
+         * \p connectionWaitTimeouts.
+         *
+         * Invokable like addStatements(). The backend reports the user feature
+         * "connectionPoolStatistics".
+         */
+        Q_INVOKABLE QVariantMap connectionPoolStatistics() const;
+
         NodeIterator listContexts() const;
         bool containsStatement( const Statement& statement ) const;
         bool containsAnyStatement( const Statement &statement ) const;
@@ -41,6 +41,7 @@ namespace Soprano {
         VirtuosoModelPrivate()
             : connectionPool( 0 ),
               m_noStatementSignals( false ),
+              m_bulkRemovalAutocommit( false ),
               m_fakeBooleanRegExp( QLatin1String("([\"'])(true|false)\\1\\^\\^(<http\\://www\\.w3\\.org/2001/XMLSchema#boolean>|\\w+\\:boolean)"),
                                    Qt::CaseInsensitive,
                                    QRegExp::RegExp2 ),
@@ -68,6 +69,18 @@ namespace Soprano {
 
         QString statementToConstructGraphPattern( const Soprano::Statement& s, bool withContext = false, bool parameterized = false ) const;
 
+        /**
+         * Create the parameterized insert command for \p statement and the nodes to bind to it.
+         * Sets an error on q and returns an empty string if the statement cannot be added.
+         */
+        QString insertCommand( const Soprano::Statement& statement, QList<Soprano::Node>& params );
+
+        /**
+         * Create the query removing all statements matching \p statement
+         * which needs to have a valid context.
+         */
+        QString removeFromGraphQuery( const Soprano::Statement& statement ) const;
+
         QueryResultIterator sqlQuery( const QString& query );
         QueryResultIterator sparqlQuery( const QString& query );
 
@@ -79,6 +92,7 @@ namespace Soprano {
         QString m_virtuosoVersion;
 
         bool m_noStatementSignals;
+        bool m_bulkRemovalAutocommit;
         bool m_fakeBooleans;
         bool m_supportEmptyGraphs;
 
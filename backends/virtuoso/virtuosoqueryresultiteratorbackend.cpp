@@ -112,6 +112,9 @@ Soprano::Virtuoso::QueryResultIteratorBackend::QueryResultIteratorBackend( Virtu
 
     else {
         d->m_resultType = QueryResultIteratorBackendPrivate::BindingResult;
+
+        // fetch the rows in blocks to save on per-row and per-value round trips
+        d->m_queryResult->enableBlockFetch( 100 );
     }
 }
 
@@ -27,8 +27,13 @@
 
 
 Soprano::Client::DBusClientNodeIteratorBackend::DBusClientNodeIteratorBackend( const QString& serviceName, const QString& objectPath )
-    : m_done( false )
+    : m_done( false ),
+      m_batchSupported( true ),
+      m_exhausted( false )
 {
+    qDBusRegisterMetaType<Soprano::Node>();
+    qDBusRegisterMetaType<QList<Soprano::Node> >();
+
     m_interface = new DBusNodeIteratorInterface( serviceName, objectPath, QDBusConnection::sessionBus(), 0 );
 }
 
@@ -39,8 +44,43 @@ Soprano::Client::DBusClientNodeIteratorBackend::~DBusClientNodeIteratorBackend()
 }
 
 
+bool Soprano::Client::DBusClientNodeIteratorBackend::fetchBatch()
+{
+    if ( m_exhausted ) {
+        return false;
+    }
+
+    QDBusReply<QList<Node> > reply = m_interface->nextBatch( DBus::DefaultBatchSize );
+    if ( reply.error().type() == QDBusError::UnknownMethod ) {
+        // an older server
+        m_batchSupported = false;
+        return false;
+    }
+
+    setError( DBus::convertError( reply.error() ) );
+    if ( lastError() ) {
+        m_exhausted = true;
+        return false;
+    }
+
+    m_buffer = reply.value();
+    m_exhausted = ( m_buffer.count() < DBus::DefaultBatchSize );
+    return !m_buffer.isEmpty();
+}
+
+
 bool Soprano::Client::DBusClientNodeIteratorBackend::next()
 {
+    if ( m_batchSupported ) {
+        if ( !m_buffer.isEmpty() || fetchBatch() ) {
+            m_current = m_buffer.takeFirst();
+            return true;
+        }
+        else if ( m_batchSupported ) {
+            return false;
+        }
+    }
+
     QDBusReply<bool> reply = m_interface->next();
     setError( DBus::convertError( reply.error() ) );
     if ( lastError() ) {
@@ -54,6 +94,10 @@ bool Soprano::Client::DBusClientNodeIteratorBackend::next()
 
 Soprano::Node Soprano::Client::DBusClientNodeIteratorBackend::current() const
 {
+    if ( m_batchSupported ) {
+        return m_current;
+    }
+
     QDBusReply<Node> reply = m_interface->current();
     setError( DBus::convertError( reply.error() ) );
     return reply.value();
@@ -69,4 +113,8 @@ void Soprano::Client::DBusClientNodeIteratorBackend::close()
         QDBusReply<void> reply = m_interface->close();
         setError( DBus::convertError( reply.error() ) );
     }
+
+    // rows fetched ahead must not be returned after closing
+    m_buffer.clear();
+    m_exhausted = true;
 }
@@ -23,6 +23,9 @@
 #define _SOPRANO_SERVER_DBUS_CLIENT_NODE_ITERATOR_BACKEND_H_
 
 #include "iteratorbackend.h"
+#include "node.h"
+
+#include <QtCore/QList>
 
 namespace Soprano {
 
@@ -43,8 +46,19 @@ namespace Soprano {
         void close();
 
     private:
+        /**
+         * Fetch the next rows via nextBatch. Falls back to
+         * single row calls if the server does not support it.
+         */
+        bool fetchBatch();
+
         DBusNodeIteratorInterface* m_interface;
         bool m_done;
+
+        bool m_batchSupported;
+        bool m_exhausted;
+        QList<Node> m_buffer;
+        Node m_current;
     };
     }
 }
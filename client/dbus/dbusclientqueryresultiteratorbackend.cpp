@@ -28,8 +28,17 @@
 
 
 Soprano::Client::DBusClientQueryResultIteratorBackend::DBusClientQueryResultIteratorBackend( const QString& serviceName, const QString& objectPath )
-    : m_done( false )
+    : m_done( false ),
+      m_batchSupported( true ),
+      m_exhausted( false ),
+      m_graphResult( -1 )
 {
+    qDBusRegisterMetaType<Soprano::Node>();
+    qDBusRegisterMetaType<Soprano::Statement>();
+    qDBusRegisterMetaType<Soprano::BindingSet>();
+    qDBusRegisterMetaType<QList<Soprano::Statement> >();
+    qDBusRegisterMetaType<QList<Soprano::BindingSet> >();
+
     m_interface = new DBusQueryResultIteratorInterface( serviceName, objectPath, QDBusConnection::sessionBus(), 0 );
 }
 
@@ -40,8 +49,69 @@ Soprano::Client::DBusClientQueryResultIteratorBackend::~DBusClientQueryResultIte
 }
 
 
+bool Soprano::Client::DBusClientQueryResultIteratorBackend::fetchBatch()
+{
+    if ( m_exhausted ) {
+        return false;
+    }
+
+    if ( m_graphResult < 0 ) {
+        m_graphResult = isGraph() ? 1 : 0;
+        if ( lastError() ) {
+            m_exhausted = true;
+            return false;
+        }
+    }
+
+    QDBusError error;
+    int count = 0;
+    if ( m_graphResult ) {
+        QDBusReply<QList<Statement> > reply = m_interface->nextStatementBatch( DBus::DefaultBatchSize );
+        error = reply.error();
+        m_statementBuffer = reply.value();
+        count = m_statementBuffer.count();
+    }
+    else {
+        QDBusReply<QList<BindingSet> > reply = m_interface->nextBatch( DBus::DefaultBatchSize );
+        error = reply.error();
+        m_bindingBuffer = reply.value();
+        count = m_bindingBuffer.count();
+    }
+
+    if ( error.type() == QDBusError::UnknownMethod ) {
+        // an older server
+        m_batchSupported = false;
+        return false;
+    }
+
+    setError( DBus::convertError( error ) );
+    if ( lastError() ) {
+        m_exhausted = true;
+        return false;
+    }
+
+    m_exhausted = ( count < DBus::DefaultBatchSize );
+    return count > 0;
+}
+
+
 bool Soprano::Client::DBusClientQueryResultIteratorBackend::next()
 {
+    if ( m_batchSupported ) {
+        if ( !m_bindingBuffer.isEmpty() || !m_statementBuffer.isEmpty() || fetchBatch() ) {
+            if ( m_graphResult ) {
+                m_currentStatement = m_statementBuffer.takeFirst();
+            }
+            else {
+                m_currentBindings = m_bindingBuffer.takeFirst();
+            }
+            return true;
+        }
+        else if ( m_batchSupported ) {
+            return false;
+        }
+    }
+
     QDBusReply<bool> reply = m_interface->next();
     setError( DBus::convertError( reply.error() ) );
     if ( lastError() ) {
@@ -55,6 +125,10 @@ bool Soprano::Client::DBusClientQueryResultIteratorBackend::next()
 
 Soprano::BindingSet Soprano::Client::DBusClientQueryResultIteratorBackend::current() const
 {
+    if ( m_batchSupported ) {
+        return m_currentBindings;
+    }
+
     QDBusReply<BindingSet> reply = m_interface->current();
     setError( DBus::convertError( reply.error() ) );
     return reply.value();
@@ -70,11 +144,20 @@ void Soprano::Client::DBusClientQueryResultIteratorBackend::close()
         QDBusReply<void> reply = m_interface->close();
         setError( DBus::convertError( reply.error() ) );
     }
+
+    // rows fetched ahead must not be returned after closing
+    m_bindingBuffer.clear();
+    m_statementBuffer.clear();
+    m_exhausted = true;
 }
 
 
 Soprano::Statement Soprano::Client::DBusClientQueryResultIteratorBackend::currentStatement() const
 {
+    if ( m_batchSupported ) {
+        return m_currentStatement;
+    }
+
     QDBusReply<Statement> reply = m_interface->currentStatement();
     setError( DBus::convertError( reply.error() ) );
     return reply.value();
@@ -83,6 +166,10 @@ Soprano::Statement Soprano::Client::DBusClientQueryResultIteratorBackend::curren
 
 Soprano::Node Soprano::Client::DBusClientQueryResultIteratorBackend::binding( const QString &name ) const
 {
+    if ( m_batchSupported ) {
+        return m_currentBindings[name];
+    }
+
     QDBusReply<Node> reply = m_interface->bindingByName( name );
     setError( DBus::convertError( reply.error() ) );
     return reply.value();
@@ -91,6 +178,10 @@ Soprano::Node Soprano::Client::DBusClientQueryResultIteratorBackend::binding( co
 
 Soprano::Node Soprano::Client::DBusClientQueryResultIteratorBackend::binding( int offset ) const
 {
+    if ( m_batchSupported ) {
+        return m_currentBindings[offset];
+    }
+
     QDBusReply<Node> reply = m_interface->bindingByIndex( offset );
     setError( DBus::convertError( reply.error() ) );
     return reply.value();
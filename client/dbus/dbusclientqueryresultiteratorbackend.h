@@ -23,6 +23,10 @@
 #define _SOPRANO_SERVER_DBUS_CLIENT_QUERYRESULT_ITERATOR_BACKEND_H_
 
 #include "queryresultiteratorbackend.h"
+#include "bindingset.h"
+#include "statement.h"
+
+#include <QtCore/QList>
 
 namespace Soprano {
 
@@ -54,8 +58,22 @@ namespace Soprano {
         bool boolValue() const;
 
     private:
+        /**
+         * Fetch the next rows via nextBatch or nextStatementBatch. Falls
+         * back to single row calls if the server does not support them.
+         */
+        bool fetchBatch();
+
         DBusQueryResultIteratorInterface* m_interface;
         bool m_done;
+
+        bool m_batchSupported;
+        bool m_exhausted;
+        int m_graphResult;
+        QList<BindingSet> m_bindingBuffer;
+        QList<Statement> m_statementBuffer;
+        BindingSet m_currentBindings;
+        Statement m_currentStatement;
     };
     }
 }
@@ -23,6 +23,9 @@
 #define _SOPRANO_SERVER_DBUS_CLIENT_STATEMENT_ITERATOR_BACKEND_H_
 
 #include "iteratorbackend.h"
+#include "statement.h"
+
+#include <QtCore/QList>
 
 namespace Soprano {
 
@@ -43,8 +46,19 @@ namespace Soprano {
         void close();
 
     private:
+        /**
+         * Fetch the next rows via nextBatch. Falls back to
+         * single row calls if the server does not support it.
+         */
+        bool fetchBatch();
+
         DBusStatementIteratorInterface* m_interface;
         bool m_done;
+
+        bool m_batchSupported;
+        bool m_exhausted;
+        QList<Statement> m_buffer;
+        Statement m_current;
     };
     }
 }
@@ -33,14 +33,46 @@
 #include "queryresultiterator.h"
 #include "dbusoperators.h"
 
+#include <QtCore/QMetaMethod>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSet>
+
+
 class Soprano::Client::DBusModel::Private
 {
 public:
     DBusModelInterface* interface;
     QDBus::CallMode callMode;
+
+    /// the normalized signatures of the change signals connected to the interface so far
+    QSet<QByteArray> forwardedSignals;
+    QMutex forwardMutex;
+
+    void forwardSignal( DBusModel* q, const QByteArray& signature );
 };
 
 
+void Soprano::Client::DBusModel::Private::forwardSignal( DBusModel* q, const QByteArray& signature )
+{
+    if ( signature != "statementAdded(Soprano::Statement)" &&
+         signature != "statementRemoved(Soprano::Statement)" &&
+         signature != "statementsAddedBatch(QList<Soprano::Statement>)" &&
+         signature != "statementsRemovedBatch(QList<Soprano::Statement>)" &&
+         signature != "statementsChanged(int,int)" ) {
+        return;
+    }
+
+    QMutexLocker lock( &forwardMutex );
+    if ( !forwardedSignals.contains( signature ) ) {
+        forwardedSignals.insert( signature );
+        // the same encoding the SIGNAL macro uses
+        const QByteArray signal = '2' + signature;
+        QObject::connect( interface, signal.constData(), q, signal.constData() );
+    }
+}
+
+
 Soprano::Client::DBusModel::DBusModel( const QString& serviceName, const QString& dbusObject, const Backend* backend )
     : StorageModel( backend ),
       d( new Private() )
@@ -48,6 +80,7 @@ Soprano::Client::DBusModel::DBusModel( const QString& serviceName, const QString
     qDBusRegisterMetaType<Soprano::Node>();
     qDBusRegisterMetaType<Soprano::Statement>();
     qDBusRegisterMetaType<Soprano::BindingSet>();
+    qDBusRegisterMetaType<QList<Soprano::Statement> >();
 
     d->interface = new DBusModelInterface( serviceName, dbusObject, QDBusConnection::sessionBus(), this );
     d->callMode = QDBus::Block;
@@ -55,10 +88,7 @@ Soprano::Client::DBusModel::DBusModel( const QString& serviceName, const QString
              this, SIGNAL(statementsAdded()) );
     connect( d->interface, SIGNAL(statementsRemoved()),
              this, SIGNAL(statementsRemoved()) );
-    connect( d->interface, SIGNAL(statementAdded(Soprano::Statement)),
-             this, SIGNAL(statementAdded(Soprano::Statement)) );
-    connect( d->interface, SIGNAL(statementRemoved(Soprano::Statement)),
-             this, SIGNAL(statementRemoved(Soprano::Statement)) );
+    // the other change signals are forwarded in connectNotify()
 }
 
 
@@ -68,6 +98,22 @@ Soprano::Client::DBusModel::~DBusModel()
 }
 
 
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+void Soprano::Client::DBusModel::connectNotify( const QMetaMethod& signal )
+{
+    StorageModel::connectNotify( signal );
+    d->forwardSignal( this, signal.methodSignature() );
+}
+#else
+void Soprano::Client::DBusModel::connectNotify( const char* signal )
+{
+    StorageModel::connectNotify( signal );
+    // skip the signal code prepended by the SIGNAL macro
+    d->forwardSignal( this, QMetaObject::normalizedSignature( signal + 1 ) );
+}
+#endif
+
+
 void Soprano::Client::DBusModel::setAsyncCalls( bool b )
 {
     d->callMode = b ? QDBus::BlockWithGui : QDBus::Block;
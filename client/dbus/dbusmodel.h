@@ -113,6 +113,47 @@ namespace Soprano {
             using StorageModel::containsStatement;
             using StorageModel::containsAnyStatement;
 
+        Q_SIGNALS:
+            /**
+             * Emitted with all statements the server reported as added
+             * in one coalesced notification. Only emitted if the server
+             * enabled Server::DBusExportModel::StatementBatchSignals.
+             *
+             * \since 2.10
+             */
+            void statementsAddedBatch( const QList<Soprano::Statement>& statements );
+
+            /**
+             * Emitted with all statements the server reported as removed
+             * in one coalesced notification. Only emitted if the server
+             * enabled Server::DBusExportModel::StatementBatchSignals.
+             *
+             * \since 2.10
+             */
+            void statementsRemovedBatch( const QList<Soprano::Statement>& statements );
+
+            /**
+             * Emitted with the number of statements added and removed since
+             * the last notification. Only emitted if the server enabled
+             * Server::DBusExportModel::SummarySignals.
+             *
+             * \since 2.10
+             */
+            void statementsChanged( int added, int removed );
+
+        protected:
+            /**
+             * Forwards the per-statement and coalesced change signals of the
+             * server only once they are connected to. Each of them installs
+             * a D-Bus match rule which would otherwise route all forms enabled
+             * on the server to every client.
+             */
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+            void connectNotify( const QMetaMethod& signal );
+#else
+            void connectNotify( const char* signal );
+#endif
+
         private:
             class Private;
             Private* const d;
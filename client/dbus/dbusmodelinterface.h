@@ -126,6 +126,9 @@ namespace Soprano {
             void statementsRemoved();
             void statementAdded( const Soprano::Statement& statement );
             void statementRemoved( const Soprano::Statement& statement );
+            void statementsAddedBatch( const QList<Soprano::Statement>& statements );
+            void statementsRemovedBatch( const QList<Soprano::Statement>& statements );
+            void statementsChanged( int added, int removed );
         };
     }
 }
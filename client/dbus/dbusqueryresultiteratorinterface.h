@@ -29,10 +29,7 @@
 #include "node.h"
 #include "statement.h"
 #include "dbusabstractinterface.h"
-
-Q_DECLARE_METATYPE(Soprano::BindingSet)
-Q_DECLARE_METATYPE(Soprano::Statement)
-Q_DECLARE_METATYPE(Soprano::Node)
+#include "dbusoperators.h"
 
 namespace Soprano {
 
@@ -116,6 +113,20 @@ namespace Soprano {
                 return callWithArgumentListAndBigTimeout(QDBus::Block, QLatin1String("next"), argumentList);
             }
 
+            inline QDBusReply<QList<Soprano::BindingSet> > nextBatch( int max )
+            {
+                QList<QVariant> argumentList;
+                argumentList << qVariantFromValue(max);
+                return callWithArgumentListAndBigTimeout(QDBus::Block, QLatin1String("nextBatch"), argumentList);
+            }
+
+            inline QDBusReply<QList<Soprano::Statement> > nextStatementBatch( int max )
+            {
+                QList<QVariant> argumentList;
+                argumentList << qVariantFromValue(max);
+                return callWithArgumentListAndBigTimeout(QDBus::Block, QLatin1String("nextStatementBatch"), argumentList);
+            }
+
             inline QDBusReply<void> close()
             {
                 QList<QVariant> argumentList;
@@ -27,8 +27,7 @@
 
 #include "statement.h"
 #include "dbusabstractinterface.h"
-
-Q_DECLARE_METATYPE(Soprano::Statement)
+#include "dbusoperators.h"
 
 namespace Soprano {
 
@@ -56,6 +55,13 @@ namespace Soprano {
                 return callWithArgumentListAndBigTimeout(QDBus::Block, QLatin1String("next"), argumentList);
             }
 
+            inline QDBusReply<QList<Soprano::Statement> > nextBatch( int max )
+            {
+                QList<QVariant> argumentList;
+                argumentList << qVariantFromValue(max);
+                return callWithArgumentListAndBigTimeout(QDBus::Block, QLatin1String("nextBatch"), argumentList);
+            }
+
             inline QDBusReply<void> close()
             {
                 QList<QVariant> argumentList;
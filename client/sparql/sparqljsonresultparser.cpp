@@ -0,0 +1,579 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "sparqljsonresultparser.h"
+
+#include <QtCore/QList>
+#include <QtCore/QDebug>
+
+
+namespace {
+    inline bool isSpace( char c ) {
+        return( c == ' ' || c == '\t' || c == '\n' || c == '\r' );
+    }
+
+    inline int hexValue( char c ) {
+        if ( c >= '0' && c <= '9' )
+            return c - '0';
+        else if ( c >= 'a' && c <= 'f' )
+            return c - 'a' + 10;
+        else if ( c >= 'A' && c <= 'F' )
+            return c - 'A' + 10;
+        else
+            return -1;
+    }
+}
+
+
+namespace Soprano {
+    namespace Client {
+        namespace SparqlParser {
+            class JsonStreamReader::Private
+            {
+            public:
+                Private( JsonStreamReader* parent )
+                    : pos( 0 ),
+                      atEnd( false ),
+                      inBindings( false ),
+                      firstResult( true ),
+                      headSeen( false ),
+                      q( parent ) {
+                }
+
+                bool fill();
+                char peek();
+                char readToken();
+                char peekToken();
+                bool fail( const QString& message );
+
+                bool parseString( QString* s );
+                bool parseWord( QByteArray* word );
+                bool nextMember( QString* name, bool* first );
+                bool nextElement( bool* first );
+                bool skipValue();
+                bool parseHead( Head* head );
+                bool parseTerm( Binding* binding );
+                bool parseResult( Result* result );
+
+                QByteArray buffer;
+                int pos;
+                bool atEnd;
+
+                bool inBindings;
+                bool firstResult;
+
+                // results which precede the head are buffered until the head has been read
+                bool headSeen;
+                QList<Result> pendingResults;
+
+            private:
+                JsonStreamReader* q;
+            };
+
+
+            bool JsonStreamReader::Private::fill()
+            {
+                if ( atEnd ) {
+                    return false;
+                }
+
+                QByteArray chunk = q->fetchData();
+                if ( chunk.isEmpty() ) {
+                    atEnd = true;
+                    return false;
+                }
+
+                if ( pos >= buffer.size() ) {
+                    buffer = chunk;
+                }
+                else {
+                    buffer = buffer.mid( pos ) + chunk;
+                }
+                pos = 0;
+                return true;
+            }
+
+
+            // the next character without consuming it, 0 at the end of the data
+            char JsonStreamReader::Private::peek()
+            {
+                while ( pos >= buffer.size() ) {
+                    if ( !fill() ) {
+                        return 0;
+                    }
+                }
+                return buffer[pos];
+            }
+
+
+            // the next non-whitespace character without consuming it
+            char JsonStreamReader::Private::peekToken()
+            {
+                char c = peek();
+                while ( isSpace( c ) ) {
+                    ++pos;
+                    c = peek();
+                }
+                return c;
+            }
+
+
+            // consume and return the next non-whitespace character
+            char JsonStreamReader::Private::readToken()
+            {
+                char c = peekToken();
+                if ( c ) {
+                    ++pos;
+                }
+                return c;
+            }
+
+
+            bool JsonStreamReader::Private::fail( const QString& message )
+            {
+                if ( !q->hasError() ) {
+                    q->setError( QString::fromLatin1( "Invalid SPARQL JSON result: %1" ).arg( message ) );
+                }
+                inBindings = false;
+                return false;
+            }
+
+
+            // parse a string whose opening quote has already been consumed
+            bool JsonStreamReader::Private::parseString( QString* s )
+            {
+                // collect the raw utf8 data and only decode it once. That way
+                // multi-byte characters may be split between chunks
+                QByteArray raw;
+                QString result;
+                while ( true ) {
+                    if ( pos >= buffer.size() && !fill() ) {
+                        return fail( QLatin1String( "unterminated string" ) );
+                    }
+
+                    int start = pos;
+                    while ( pos < buffer.size() && buffer[pos] != '"' && buffer[pos] != '\\' ) {
+                        ++pos;
+                    }
+                    raw.append( buffer.constData() + start, pos - start );
+                    if ( pos >= buffer.size() ) {
+                        continue;
+                    }
+
+                    if ( buffer[pos++] == '"' ) {
+                        if ( s ) {
+                            result.append( QString::fromUtf8( raw.constData(), raw.size() ) );
+                            *s = result;
+                        }
+                        return true;
+                    }
+
+                    char c = peek();
+                    ++pos;
+                    switch( c ) {
+                    case '"':
+                    case '\\':
+                    case '/':
+                        raw.append( c );
+                        break;
+                    case 'b':
+                        raw.append( '\b' );
+                        break;
+                    case 'f':
+                        raw.append( '\f' );
+                        break;
+                    case 'n':
+                        raw.append( '\n' );
+                        break;
+                    case 'r':
+                        raw.append( '\r' );
+                        break;
+                    case 't':
+                        raw.append( '\t' );
+                        break;
+                    case 'u': {
+                        ushort code = 0;
+                        for ( int i = 0; i < 4; ++i ) {
+                            int v = hexValue( peek() );
+                            if ( v < 0 ) {
+                                return fail( QLatin1String( "invalid unicode escape" ) );
+                            }
+                            ++pos;
+                            code = ( code << 4 ) | v;
+                        }
+                        // surrogate pairs are simply appended as two QChars
+                        result.append( QString::fromUtf8( raw.constData(), raw.size() ) );
+                        raw.clear();
+                        result.append( QChar( code ) );
+                        break;
+                    }
+                    default:
+                        return fail( QLatin1String( "invalid escape sequence" ) );
+                    }
+                }
+            }
+
+
+            // parse a number or one of true, false, and null
+            bool JsonStreamReader::Private::parseWord( QByteArray* word )
+            {
+                char c = peekToken();
+                while ( c && c != ',' && c != '}' && c != ']' && !isSpace( c ) ) {
+                    if ( word ) {
+                        word->append( c );
+                    }
+                    ++pos;
+                    c = peek();
+                }
+                return true;
+            }
+
+
+            // read the name of the next member of an object whose opening brace has already been
+            // consumed. Returns false at the end of the object and on error.
+            bool JsonStreamReader::Private::nextMember( QString* name, bool* first )
+            {
+                char c = readToken();
+                if ( c == '}' ) {
+                    return false;
+                }
+                if ( !*first ) {
+                    if ( c != ',' ) {
+                        return fail( QLatin1String( "expected ',' or '}'" ) );
+                    }
+                    c = readToken();
+                }
+                *first = false;
+
+                if ( c != '"' ) {
+                    return fail( QLatin1String( "expected member name" ) );
+                }
+                if ( !parseString( name ) ) {
+                    return false;
+                }
+                if ( readToken() != ':' ) {
+                    return fail( QLatin1String( "expected ':'" ) );
+                }
+                return true;
+            }
+
+
+            // check if another element follows in an array whose opening bracket has already
+            // been consumed. Returns false at the end of the array and on error.
+            bool JsonStreamReader::Private::nextElement( bool* first )
+            {
+                char c = peekToken();
+                if ( c == ']' ) {
+                    ++pos;
+                    return false;
+                }
+                else if ( !c ) {
+                    return fail( QLatin1String( "unexpected end of data" ) );
+                }
+                if ( !*first ) {
+                    if ( c != ',' ) {
+                        return fail( QLatin1String( "expected ',' or ']'" ) );
+                    }
+                    ++pos;
+                }
+                *first = false;
+                return true;
+            }
+
+
+            bool JsonStreamReader::Private::skipValue()
+            {
+                char c = peekToken();
+                if ( c == '"' ) {
+                    ++pos;
+                    return parseString( 0 );
+                }
+                else if ( c == '{' ) {
+                    ++pos;
+                    bool first = true;
+                    QString name;
+                    while ( nextMember( &name, &first ) ) {
+                        if ( !skipValue() ) {
+                            return false;
+                        }
+                    }
+                    return !q->hasError();
+                }
+                else if ( c == '[' ) {
+                    ++pos;
+                    bool first = true;
+                    while ( nextElement( &first ) ) {
+                        if ( !skipValue() ) {
+                            return false;
+                        }
+                    }
+                    return !q->hasError();
+                }
+                else if ( !c ) {
+                    return fail( QLatin1String( "unexpected end of data" ) );
+                }
+                else {
+                    return parseWord( 0 );
+                }
+            }
+
+
+            bool JsonStreamReader::Private::parseHead( Head* head )
+            {
+                if ( readToken() != '{' ) {
+                    return fail( QLatin1String( "expected head object" ) );
+                }
+
+                bool first = true;
+                QString name;
+                while ( nextMember( &name, &first ) ) {
+                    if ( name == QLatin1String( "vars" ) ) {
+                        if ( readToken() != '[' ) {
+                            return fail( QLatin1String( "expected vars array" ) );
+                        }
+                        bool firstVar = true;
+                        while ( nextElement( &firstVar ) ) {
+                            QString varName;
+                            if ( readToken() != '"' ) {
+                                return fail( QLatin1String( "expected variable name" ) );
+                            }
+                            if ( !parseString( &varName ) ) {
+                                return false;
+                            }
+                            Variable v;
+                            v.setName( varName );
+                            head->addVariable( v );
+                        }
+                    }
+                    // link and other members are ignored
+                    else if ( !skipValue() ) {
+                        return false;
+                    }
+                }
+                return !q->hasError();
+            }
+
+
+            bool JsonStreamReader::Private::parseTerm( Binding* binding )
+            {
+                if ( readToken() != '{' ) {
+                    return fail( QLatin1String( "expected RDF term object" ) );
+                }
+
+                QString type;
+                QString value;
+                QString lang;
+                QString datatype;
+
+                bool first = true;
+                QString name;
+                while ( nextMember( &name, &first ) ) {
+                    QString* target = 0;
+                    if ( name == QLatin1String( "type" ) )
+                        target = &type;
+                    else if ( name == QLatin1String( "value" ) )
+                        target = &value;
+                    else if ( name == QLatin1String( "xml:lang" ) )
+                        target = &lang;
+                    else if ( name == QLatin1String( "datatype" ) )
+                        target = &datatype;
+
+                    if ( target ) {
+                        if ( readToken() != '"' ) {
+                            return fail( QString::fromLatin1( "expected string value for %1" ).arg( name ) );
+                        }
+                        if ( !parseString( target ) ) {
+                            return false;
+                        }
+                    }
+                    else if ( !skipValue() ) {
+                        return false;
+                    }
+                }
+                if ( q->hasError() ) {
+                    return false;
+                }
+
+                if ( type == QLatin1String( "uri" ) ) {
+                    Uri uri;
+                    uri.setUri( QUrl::fromEncoded( value.toUtf8() ) );
+                    binding->setUri( uri );
+                }
+                else if ( type == QLatin1String( "bnode" ) ) {
+                    Bnode bnode;
+                    bnode.setId( value );
+                    binding->setBnode( bnode );
+                }
+                // typed-literal is used by older versions of the format
+                else if ( type == QLatin1String( "literal" ) || type == QLatin1String( "typed-literal" ) ) {
+                    Literal literal;
+                    literal.setDatatype( datatype );
+                    literal.setXml_lang( lang );
+                    literal.setData( value );
+                    binding->setLiteral( literal );
+                }
+                else {
+                    return fail( QString::fromLatin1( "unknown term type %1" ).arg( type ) );
+                }
+                return true;
+            }
+
+
+            bool JsonStreamReader::Private::parseResult( Result* result )
+            {
+                if ( readToken() != '{' ) {
+                    return fail( QLatin1String( "expected result object" ) );
+                }
+
+                *result = Result();
+                bool first = true;
+                QString name;
+                while ( nextMember( &name, &first ) ) {
+                    Binding binding;
+                    if ( !parseTerm( &binding ) ) {
+                        return false;
+                    }
+                    binding.setName( name );
+                    result->addBinding( binding );
+                }
+
+                return !q->hasError();
+            }
+
+
+            JsonStreamReader::JsonStreamReader( DataSource* source )
+                : StreamReader( source ),
+                  d( new Private( this ) )
+            {
+            }
+
+
+            JsonStreamReader::~JsonStreamReader()
+            {
+                delete d;
+            }
+
+
+            bool JsonStreamReader::readHead()
+            {
+                if ( d->readToken() != '{' ) {
+                    return false;
+                }
+
+                bool first = true;
+                bool isResult = false;
+                QString name;
+                while ( d->nextMember( &name, &first ) ) {
+                    if ( name == QLatin1String( "head" ) ) {
+                        // from here on we do not need to keep a copy of the data anymore
+                        setKeepData( false );
+                        isResult = true;
+                        Head head;
+                        if ( !d->parseHead( &head ) ) {
+                            return false;
+                        }
+                        setHead( head );
+                        d->headSeen = true;
+                    }
+                    else if ( name == QLatin1String( "boolean" ) ) {
+                        setKeepData( false );
+                        QByteArray word;
+                        d->parseWord( &word );
+                        Boolean b;
+                        b.setValue( word == "true" );
+                        setBoolean( b );
+                        return true;
+                    }
+                    else if ( name == QLatin1String( "results" ) ) {
+                        setKeepData( false );
+                        isResult = true;
+                        if ( d->readToken() != '{' ) {
+                            return d->fail( QLatin1String( "expected results object" ) );
+                        }
+                        bool firstMember = true;
+                        QString resultsName;
+                        while ( d->nextMember( &resultsName, &firstMember ) ) {
+                            if ( resultsName == QLatin1String( "bindings" ) ) {
+                                if ( d->readToken() != '[' ) {
+                                    return d->fail( QLatin1String( "expected bindings array" ) );
+                                }
+                                if ( d->headSeen ) {
+                                    // the results are read one by one via readResult
+                                    d->inBindings = true;
+                                    return true;
+                                }
+
+                                // JSON does not guarantee the order of members. Without the head
+                                // the binding names are unknown. Thus, we buffer the results.
+                                bool firstResult = true;
+                                while ( d->nextElement( &firstResult ) ) {
+                                    Result result;
+                                    if ( !d->parseResult( &result ) ) {
+                                        return false;
+                                    }
+                                    d->pendingResults.append( result );
+                                }
+                                if ( hasError() ) {
+                                    return false;
+                                }
+                            }
+                            else if ( !d->skipValue() ) {
+                                return false;
+                            }
+                        }
+                        if ( hasError() ) {
+                            return false;
+                        }
+                    }
+                    else if ( !d->skipValue() ) {
+                        return false;
+                    }
+                }
+
+                if ( isResult && !d->headSeen ) {
+                    return d->fail( QLatin1String( "missing head" ) );
+                }
+                return isResult && !hasError();
+            }
+
+
+            bool JsonStreamReader::readResult( Result* result )
+            {
+                if ( !d->pendingResults.isEmpty() ) {
+                    *result = d->pendingResults.takeFirst();
+                    return true;
+                }
+
+                if ( !d->inBindings ) {
+                    return false;
+                }
+
+                if ( !d->nextElement( &d->firstResult ) ) {
+                    d->inBindings = false;
+                    return false;
+                }
+
+                return d->parseResult( result );
+            }
+        }
+    }
+}
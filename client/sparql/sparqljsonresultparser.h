@@ -0,0 +1,57 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef _SPARQL_JSON_RESULT_PARSER_H_
+#define _SPARQL_JSON_RESULT_PARSER_H_
+
+#include "sparqlxmlresultparser.h"
+
+namespace Soprano {
+    namespace Client {
+        namespace SparqlParser {
+            /**
+             * Incremental parser for the SPARQL query results JSON format
+             * (application/sparql-results+json).
+             *
+             * Results are streamed if the head member precedes the results
+             * member which is what all known endpoints produce. Otherwise
+             * the binding names are not known before the results are read
+             * and all results are buffered until the head has been read.
+             */
+            class JsonStreamReader : public StreamReader
+            {
+            public:
+                JsonStreamReader( DataSource* source );
+                ~JsonStreamReader();
+
+                bool readHead();
+                bool readResult( Result* result );
+
+            private:
+                class Private;
+                Private* const d;
+            };
+        }
+    }
+}
+
+#endif
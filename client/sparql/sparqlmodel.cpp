@@ -23,6 +23,8 @@
 #include "sparqlmodel.h"
 #include "sparqlqueryresult.h"
 #include "sparqlprotocol.h"
+#include "sparqljsonresultparser.h"
+#include "sparqltsvresultparser.h"
 
 #include "queryresultiterator.h"
 #include "statementiterator.h"
@@ -31,6 +33,7 @@
 #include "parser.h"
 #include "pluginmanager.h"
 
+#include <QtCore/QPointer>
 #include <QtCore/QDebug>
 
 
@@ -144,15 +147,83 @@ namespace {
         Soprano::StatementIterator m_iterator;
     };
 
-    Soprano::QueryResultIterator iteratorFromData( const QByteArray& data )
+    class BufferDataSource : public Soprano::Client::SparqlParser::StreamReader::DataSource
+    {
+    public:
+        BufferDataSource( const QByteArray& data )
+            : m_data( data ) {
+        }
+
+        QByteArray waitForData() {
+            QByteArray data = m_data;
+            m_data.clear();
+            return data;
+        }
+
+    private:
+        QByteArray m_data;
+    };
+
+    class ProtocolDataSource : public Soprano::Client::SparqlParser::StreamReader::DataSource
+    {
+    public:
+        ProtocolDataSource( Soprano::Client::SparqlProtocol* client, int id )
+            : m_client( client ),
+              m_id( id ) {
+        }
+
+        ~ProtocolDataSource() {
+            if ( m_client ) {
+                m_client->closeStreamingQuery( m_id );
+            }
+        }
+
+        QByteArray waitForData() {
+            if ( m_client ) {
+                return m_client->waitForData( m_id );
+            }
+            else {
+                return QByteArray();
+            }
+        }
+
+    private:
+        QPointer<Soprano::Client::SparqlProtocol> m_client;
+        int m_id;
+    };
+
+    Soprano::Client::SparqlParser::StreamReader* createReader( Soprano::Client::SparqlParser::StreamReader::DataSource* source,
+                                                               const QString& contentType )
+    {
+        if ( contentType.contains( QLatin1String( "sparql-results+json" ) ) ) {
+            return new Soprano::Client::SparqlParser::JsonStreamReader( source );
+        }
+        else if ( contentType.contains( QLatin1String( "tab-separated-values" ) ) ) {
+            return new Soprano::Client::SparqlParser::TsvStreamReader( source );
+        }
+        else {
+            // XML is also used for unknown content types since the reader
+            // hands out the data for the graph parsers if it is no result document
+            return new Soprano::Client::SparqlParser::XmlStreamReader( source );
+        }
+    }
+
+    Soprano::QueryResultIterator iteratorFromSource( Soprano::Client::SparqlParser::StreamReader::DataSource* source,
+                                                     const QString& contentType )
     {
         // try parsing the response
-        bool ok = false;
-        Soprano::Client::SparqlParser::Sparql queryResult = Soprano::Client::SparqlParser::Sparql::parseByteArray( data, &ok );
+        Soprano::Client::SparqlParser::StreamReader* reader = createReader( source, contentType );
+
+        // seems to be a binding or boolean result. The results are parsed while iterating
+        if ( reader->readHead() ) {
+            return new Soprano::Client::SparqlQueryResult( reader );
+        }
 
-        // seems to be a binding or boolean result
-        if ( ok ) {
-            return new Soprano::Client::SparqlQueryResult( queryResult );
+        QByteArray data = reader->readAll();
+        delete reader;
+
+        if ( data.isEmpty() ) {
+            return Soprano::QueryResultIterator();
         }
 
         // try parsing it as graph
@@ -176,6 +247,11 @@ namespace {
         return Soprano::QueryResultIterator();
     }
 
+    Soprano::QueryResultIterator iteratorFromData( const QByteArray& data, const QString& contentType )
+    {
+        return iteratorFromSource( new BufferDataSource( data ), contentType );
+    }
+
     enum CommandType {
         QueryCommand,
         ListStatementsCommand,
@@ -245,6 +321,18 @@ void Soprano::Client::SparqlModel::setPath( const QString& path )
 }
 
 
+void Soprano::Client::SparqlModel::setResultFormat( ResultFormat format )
+{
+    d->client->setResultFormat( format );
+}
+
+
+Soprano::Client::SparqlModel::ResultFormat Soprano::Client::SparqlModel::resultFormat() const
+{
+    return d->client->resultFormat();
+}
+
+
 // QString Soprano::Client::SparqlModel::host() const
 // {
 //     return
@@ -331,12 +419,15 @@ Soprano::QueryResultIterator Soprano::Client::SparqlModel::executeQuery( const Q
         setError( "Unsupported query language: " + Query::queryLanguageToString( language, userQueryLanguage ), Error::ErrorInvalidArgument );
     }
     else {
-        QByteArray response = d->client->blockingQuery( query );
-        setError( d->client->lastError() );
-
-        if( !lastError() && !response.isEmpty() ) {
-            return iteratorFromData( response );
+        // the iterator is handed out as soon as the head of the response has been parsed
+        int id = d->client->streamingQuery( query );
+        QString contentType = d->client->waitForContentType( id );
+        QueryResultIterator it = iteratorFromSource( new ProtocolDataSource( d->client, id ), contentType );
+        if ( it.isValid() ) {
+            clearError();
+            return it;
         }
+        setError( d->client->lastError() );
     }
 
     // client returned error
@@ -456,6 +547,8 @@ Soprano::Util::AsyncResult* Soprano::Client::SparqlModel::listContextsAsync() co
 void Soprano::Client::SparqlModel::slotRequestFinished( int id, bool error, const QByteArray& data )
 {
     if ( d->commands.contains( id ) ) {
+        // while the signal is emitted the last response is the one of this request
+        const QString contentType = d->client->lastResponse().contentType();
         Command cmd = d->commands[id];
         if ( error ) {
             cmd.result->setResult( QVariant(), d->client->lastError() );
@@ -463,12 +556,12 @@ void Soprano::Client::SparqlModel::slotRequestFinished( int id, bool error, cons
         else {
             switch( cmd.commandType ) {
             case QueryCommand:
-                cmd.result->setResult( QVariant::fromValue( iteratorFromData( data ) ), Error::Error() );
+                cmd.result->setResult( QVariant::fromValue( iteratorFromData( data, contentType ) ), Error::Error() );
                 break;
 
             case ListStatementsCommand:
                 cmd.result->setResult( QVariant::fromValue(
-                                           iteratorFromData( data )
+                                           iteratorFromData( data, contentType )
                                            .iterateStatementsFromBindings( cmd.partialListStatement.subject().isValid() ? QString() : QString( 's' ),
                                                                            cmd.partialListStatement.predicate().isValid() ? QString() : QString( 'p' ),
                                                                            cmd.partialListStatement.object().isValid() ? QString() : QString( 'o' ),
@@ -478,7 +571,7 @@ void Soprano::Client::SparqlModel::slotRequestFinished( int id, bool error, cons
                 break;
 
             case ListContextsCommand:
-                cmd.result->setResult( QVariant::fromValue( iteratorFromData( data ).iterateBindings( "g" ) ), Error::Error() );
+                cmd.result->setResult( QVariant::fromValue( iteratorFromData( data, contentType ).iterateBindings( "g" ) ), Error::Error() );
                 break;
 
             default:
@@ -73,6 +73,34 @@ namespace Soprano {
              */
             ~SparqlModel();
 
+            /**
+             * The result formats SparqlModel can request from the server
+             * for binding and boolean query results.
+             *
+             * \sa setResultFormat
+             *
+             * \since 2.10
+             */
+            enum ResultFormat {
+                /**
+                 * SPARQL Query Results XML Format (application/sparql-results+xml).
+                 * Supported by all endpoints.
+                 */
+                XmlResultFormat,
+
+                /**
+                 * SPARQL Query Results JSON Format (application/sparql-results+json).
+                 */
+                JsonResultFormat,
+
+                /**
+                 * SPARQL Query Results TSV Format (text/tab-separated-values).
+                 * The most compact format. Since it cannot represent boolean
+                 * results, the server is asked to fall back to XML for those.
+                 */
+                TsvResultFormat
+            };
+
             //@{
             /**
              * Set the host to connect to.
@@ -100,6 +128,28 @@ namespace Soprano {
              * \since 2.2.1
              */
             void setPath( const QString& path );
+
+            /**
+             * Set the result format to request from the server. The format
+             * is negotiated via the Accept header. Thus, servers which do
+             * not support it reply with another format which is
+             * handled transparently.
+             *
+             * JSON and TSV results are considerably smaller and faster to
+             * parse than XML results.
+             *
+             * Default value is XmlResultFormat.
+             *
+             * \since 2.10
+             */
+            void setResultFormat( ResultFormat format );
+
+            /**
+             * \sa setResultFormat
+             *
+             * \since 2.10
+             */
+            ResultFormat resultFormat() const;
             //@}
 
             //@{
@@ -33,10 +33,15 @@
 
 Soprano::Client::SparqlProtocol::SparqlProtocol( QObject* parent )
     : QHttp( parent ),
-      m_path( QLatin1String( "/sparql" ) )
+      m_path( QLatin1String( "/sparql" ) ),
+      m_resultFormat( SparqlModel::XmlResultFormat )
 {
     connect( this, SIGNAL(requestFinished(int,bool)),
              this, SLOT(slotRequestFinished(int,bool)) );
+    connect( this, SIGNAL(readyRead(QHttpResponseHeader)),
+             this, SLOT(slotReadyRead(QHttpResponseHeader)) );
+    connect( this, SIGNAL(responseHeaderReceived(QHttpResponseHeader)),
+             this, SLOT(slotResponseHeaderReceived(QHttpResponseHeader)) );
 }
 
 
@@ -49,6 +54,9 @@ Soprano::Client::SparqlProtocol::~SparqlProtocol()
 void Soprano::Client::SparqlProtocol::cancel()
 {
     QHttp::abort();
+    for ( QHash<int, Stream>::iterator it = m_streams.begin(); it != m_streams.end(); ++it ) {
+        it.value().finished = true;
+    }
     foreach( QEventLoop* loop, m_loops ) {
         loop->exit();
     }
@@ -58,6 +66,7 @@ void Soprano::Client::SparqlProtocol::cancel()
 void Soprano::Client::SparqlProtocol::setHost( const QString& hostname, quint16 port )
 {
     QHttp::setHost( hostname, port );
+    m_host = ( port == 80 ? hostname : QString( "%1:%2" ).arg( hostname ).arg( port ) );
 }
 
 
@@ -73,13 +82,52 @@ void Soprano::Client::SparqlProtocol::setPath( const QString& path )
 }
 
 
-int Soprano::Client::SparqlProtocol::query( const QString& queryS )
+void Soprano::Client::SparqlProtocol::setResultFormat( SparqlModel::ResultFormat format )
+{
+    m_resultFormat = format;
+}
+
+
+Soprano::Client::SparqlModel::ResultFormat Soprano::Client::SparqlProtocol::resultFormat() const
+{
+    return m_resultFormat;
+}
+
+
+int Soprano::Client::SparqlProtocol::sendQuery( const QString& queryS, QIODevice* to )
 {
     QUrl url = QUrl( m_path );
     url.addQueryItem( "query", queryS );
 
+    // Graph results are requested as RDF/XML or Turtle, boolean results
+    // fall back to XML in case the preferred format cannot represent them
+    QString accept;
+    switch( m_resultFormat ) {
+    case SparqlModel::JsonResultFormat:
+        accept = QLatin1String( "application/sparql-results+json, application/sparql-results+xml;q=0.9, " );
+        break;
+    case SparqlModel::TsvResultFormat:
+        accept = QLatin1String( "text/tab-separated-values, application/sparql-results+xml;q=0.9, " );
+        break;
+    default:
+        accept = QLatin1String( "application/sparql-results+xml, " );
+        break;
+    }
+    accept += QLatin1String( "application/rdf+xml;q=0.8, text/turtle;q=0.7, */*;q=0.1" );
+
+    QHttpRequestHeader header( QLatin1String( "GET" ), QString::fromLatin1( url.toEncoded() ) );
+    header.setValue( QLatin1String( "Host" ), m_host );
+    header.setValue( QLatin1String( "Connection" ), QLatin1String( "Keep-Alive" ) );
+    header.setValue( QLatin1String( "Accept" ), accept );
+
+    return request( header, ( QIODevice* )0, to );
+}
+
+
+int Soprano::Client::SparqlProtocol::query( const QString& queryS )
+{
     QBuffer* buffer = new QBuffer();
-    int id = get( url.toEncoded(), buffer );
+    int id = sendQuery( queryS, buffer );
     m_resultsData[id] = buffer;
 
 //    qDebug() << Q_FUNC_INFO << url << id;
@@ -88,6 +136,65 @@ int Soprano::Client::SparqlProtocol::query( const QString& queryS )
 }
 
 
+int Soprano::Client::SparqlProtocol::streamingQuery( const QString& queryS )
+{
+    // without a device QHttp emits readyRead for each received chunk
+    int id = sendQuery( queryS, 0 );
+    m_streams[id] = Stream();
+
+    return id;
+}
+
+
+QByteArray Soprano::Client::SparqlProtocol::waitForData( int id )
+{
+    while ( m_streams.contains( id ) ) {
+        Stream& stream = m_streams[id];
+        if ( !stream.data.isEmpty() ) {
+            QByteArray data = stream.data;
+            stream.data.clear();
+            return data;
+        }
+        else if ( stream.finished ) {
+            break;
+        }
+        else {
+            waitForRequest( id );
+        }
+    }
+    return QByteArray();
+}
+
+
+void Soprano::Client::SparqlProtocol::closeStreamingQuery( int id )
+{
+    if ( m_streams.contains( id ) ) {
+        if ( m_streams[id].finished ) {
+            m_streams.remove( id );
+        }
+        else {
+            // QHttp cannot abort a single request. Thus, we keep the entry
+            // until the request finished and drop the remaining data
+            m_streams[id].closed = true;
+            m_streams[id].data.clear();
+        }
+    }
+}
+
+
+QString Soprano::Client::SparqlProtocol::waitForContentType( int id )
+{
+    while ( m_streams.contains( id ) ) {
+        Stream& stream = m_streams[id];
+        if ( stream.headerReceived || stream.finished ) {
+            return stream.contentType;
+        }
+        waitForRequest( id );
+    }
+    return QString();
+}
+
+
 QByteArray Soprano::Client::SparqlProtocol::blockingQuery( const QString& queryString )
 {
     int id = query( queryString );
@@ -117,10 +224,70 @@ void Soprano::Client::SparqlProtocol::waitForRequest( int id )
 }
 
 
+void Soprano::Client::SparqlProtocol::slotReadyRead( const QHttpResponseHeader& response )
+{
+    int id = currentId();
+    QByteArray data = readAll();
+    if ( m_streams.contains( id ) ) {
+        Stream& stream = m_streams[id];
+        if ( response.statusCode() != 200 ) {
+            // never hand out error pages as result data
+            if ( !stream.finished ) {
+                setError( QString( "Server did respond with %2 (%3)" ).arg( response.statusCode() ).arg( errorString() ) );
+            }
+            stream.finished = true;
+            stream.data.clear();
+        }
+        else if ( !stream.closed && !stream.finished ) {
+            stream.data.append( data );
+        }
+
+        if ( m_loops.contains( id ) ) {
+            m_loops[id]->quit();
+        }
+    }
+}
+
+
+void Soprano::Client::SparqlProtocol::slotResponseHeaderReceived( const QHttpResponseHeader& response )
+{
+    int id = currentId();
+    if ( m_streams.contains( id ) ) {
+        Stream& stream = m_streams[id];
+        stream.contentType = response.contentType();
+        stream.headerReceived = true;
+
+        if ( m_loops.contains( id ) ) {
+            m_loops[id]->quit();
+        }
+    }
+}
+
+
 void Soprano::Client::SparqlProtocol::slotRequestFinished( int id, bool error )
 {
 //    qDebug() << Q_FUNC_INFO << id << error;
 
+    if ( m_streams.contains( id ) ) {
+        Stream& stream = m_streams[id];
+        if ( !error && lastResponse().statusCode() == 200 ) {
+            clearError();
+        }
+        else if ( !stream.finished ) {
+            setError( QString( "Server did respond with %2 (%3)" ).arg( lastResponse().statusCode() ).arg( errorString() ) );
+            stream.data.clear();
+        }
+        stream.finished = true;
+
+        if ( stream.closed ) {
+            m_streams.remove( id );
+        }
+        else if ( m_loops.contains( id ) ) {
+            m_loops[id]->quit();
+        }
+        return;
+    }
+
     // we ignore all the other requests such as setting the user and so on
     if ( m_resultsData.contains( id ) ) {
         QHttpResponseHeader h = lastResponse();
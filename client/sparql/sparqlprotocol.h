@@ -25,6 +25,7 @@
 #define _SPARQL_UTIL_H_
 
 #include <soprano/error.h>
+#include "sparqlmodel.h"
 #include <QtNetwork/QHttp>
 #include <QtCore/QHash>
 
@@ -50,6 +51,13 @@ namespace Soprano {
              */
             void setPath( const QString& path );
 
+            /**
+             * The result format to request via the Accept header.
+             * Default is SparqlModel::XmlResultFormat.
+             */
+            void setResultFormat( SparqlModel::ResultFormat format );
+            SparqlModel::ResultFormat resultFormat() const;
+
             /**
              * \returns the response data. An emtpy QByteArray
              * on error. Check lastError() for details.
@@ -58,6 +66,38 @@ namespace Soprano {
 
             int query( const QString& query );
 
+            /**
+             * Start a query whose response is consumed incrementally
+             * via waitForData() while it is still being received.
+             * The request has to be released via closeStreamingQuery().
+             *
+             * \returns the id of the request.
+             */
+            int streamingQuery( const QString& query );
+
+            /**
+             * Block until new data of the streaming request \p id arrived.
+             *
+             * \returns the data received since the last call or an empty
+             * QByteArray once the response is complete or on error. Check
+             * lastError() for details.
+             */
+            QByteArray waitForData( int id );
+
+            /**
+             * Release the streaming request \p id. Data still arriving
+             * for it will be dropped.
+             */
+            void closeStreamingQuery( int id );
+
+            /**
+             * Block until the response header of the streaming request
+             * \p id has been received.
+             *
+             * \returns the content type of the response.
+             */
+            QString waitForContentType( int id );
+
         Q_SIGNALS:
             void requestFinished( int id, bool error, const QByteArray& data );
 
@@ -66,14 +106,34 @@ namespace Soprano {
 
         private Q_SLOTS:
             void slotRequestFinished( int id, bool error );
+            void slotReadyRead( const QHttpResponseHeader& response );
+            void slotResponseHeaderReceived( const QHttpResponseHeader& response );
 
         private:
             void waitForRequest( int id );
+            int sendQuery( const QString& query, QIODevice* to );
+
+            class Stream {
+            public:
+                Stream()
+                    : headerReceived( false ),
+                      finished( false ),
+                      closed( false ) {}
+
+                QByteArray data;
+                QString contentType;
+                bool headerReceived;
+                bool finished;
+                bool closed;
+            };
 
             QHash<int, QEventLoop*> m_loops;
             QHash<int, bool> m_results;
             QHash<int, QBuffer*> m_resultsData;
+            QHash<int, Stream> m_streams;
             QString m_path;
+            QString m_host;
+            SparqlModel::ResultFormat m_resultFormat;
         };
     }
 }
@@ -52,13 +52,14 @@ namespace {
  }
 
 
-Soprano::Client::SparqlQueryResult::SparqlQueryResult( const SparqlParser::Sparql& result )
+Soprano::Client::SparqlQueryResult::SparqlQueryResult( SparqlParser::StreamReader* reader )
     : Soprano::QueryResultIteratorBackend(),
-      m_result( result ),
-      m_currentResultIndex( -1 )
+      m_reader( reader ),
+      m_boolean( reader->boolean() ),
+      m_hasCurrent( false )
 {
     // cache binding names
-    foreach( const SparqlParser::Variable& v, m_result.head().variableList() ) {
+    foreach( const SparqlParser::Variable& v, m_reader->head().variableList() ) {
         m_bindingNames << v.name();
     }
 }
@@ -66,14 +67,24 @@ Soprano::Client::SparqlQueryResult::SparqlQueryResult( const SparqlParser::Sparq
 
 Soprano::Client::SparqlQueryResult::~SparqlQueryResult()
 {
+    close();
 }
 
 
 bool Soprano::Client::SparqlQueryResult::next()
 {
-    if( isBinding()) {
-        ++m_currentResultIndex;
-        return( m_currentResultIndex < m_result.results().resultList().count() );
+    if( isBinding() && m_reader ) {
+        m_hasCurrent = m_reader->readResult( &m_currentResult );
+        if ( m_reader->hasError() ) {
+            setError( m_reader->errorString() );
+        }
+        else {
+            clearError();
+        }
+        if ( !m_hasCurrent ) {
+            close();
+        }
+        return m_hasCurrent;
     }
     else {
         // boolean result always needs to return false
@@ -91,8 +102,8 @@ Soprano::Statement Soprano::Client::SparqlQueryResult::currentStatement() const
 
 Soprano::Node Soprano::Client::SparqlQueryResult::binding( const QString& name ) const
 {
-    if ( m_currentResultIndex != -1 && m_currentResultIndex < m_result.results().resultList().count() ) {
-        foreach ( const SparqlParser::Binding& b, m_result.results().resultList()[m_currentResultIndex].bindingList() ) {
+    if ( m_hasCurrent ) {
+        foreach ( const SparqlParser::Binding& b, m_currentResult.bindingList() ) {
             if( b.name() == name ) {
                 return bindingToNode( b );
             }
@@ -150,17 +161,20 @@ bool Soprano::Client::SparqlQueryResult::isBinding() const
 
 bool Soprano::Client::SparqlQueryResult::isBool() const
 {
-    return m_result.boolean().isValid();
+    return m_boolean.isValid();
 }
 
 
 bool Soprano::Client::SparqlQueryResult::boolValue() const
 {
-    return m_result.boolean().value();
+    return m_boolean.value();
 }
 
 
 void Soprano::Client::SparqlQueryResult::close()
 {
-    // do nothing
+    // deleting the reader releases the underlying request
+    delete m_reader;
+    m_reader = 0;
+    m_hasCurrent = false;
 }
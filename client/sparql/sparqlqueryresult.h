@@ -28,10 +28,19 @@
 
 namespace Soprano {
     namespace Client {
+        /**
+         * Hands out the results of a SparqlParser::StreamReader as they are
+         * parsed. Thus, iteration can start while the response is still
+         * being received.
+         */
         class SparqlQueryResult : public Soprano::QueryResultIteratorBackend
         {
         public:
-            SparqlQueryResult( const SparqlParser::Sparql& result );
+            /**
+             * \param reader The reader the head has already been read from.
+             * The result takes ownership of it.
+             */
+            SparqlQueryResult( SparqlParser::StreamReader* reader );
             ~SparqlQueryResult();
 
             bool next();
@@ -47,9 +56,11 @@ namespace Soprano {
             void close();
 
         private:
-            SparqlParser::Sparql m_result;
+            SparqlParser::StreamReader* m_reader;
+            SparqlParser::Boolean m_boolean;
+            SparqlParser::Result m_currentResult;
             QStringList m_bindingNames;
-            int m_currentResultIndex;
+            bool m_hasCurrent;
         };
     }
 }
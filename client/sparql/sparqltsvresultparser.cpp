@@ -0,0 +1,239 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "sparqltsvresultparser.h"
+
+#include "node.h"
+#include "literalvalue.h"
+#include "languagetag.h"
+#include "vocabulary/xsd.h"
+
+#include <QtCore/QList>
+#include <QtCore/QDebug>
+
+
+namespace Soprano {
+    namespace Client {
+        namespace SparqlParser {
+            class TsvStreamReader::Private
+            {
+            public:
+                Private( TsvStreamReader* parent )
+                    : pos( 0 ),
+                      atEnd( false ),
+                      q( parent ) {
+                }
+
+                bool fill();
+                bool readLine( QByteArray* line );
+                bool parseTerm( const QByteArray& field, Binding* binding );
+
+                QByteArray buffer;
+                int pos;
+                bool atEnd;
+
+                QStringList variables;
+
+            private:
+                TsvStreamReader* q;
+            };
+
+
+            bool TsvStreamReader::Private::fill()
+            {
+                if ( atEnd ) {
+                    return false;
+                }
+
+                QByteArray chunk = q->fetchData();
+                if ( chunk.isEmpty() ) {
+                    atEnd = true;
+                    return false;
+                }
+
+                if ( pos >= buffer.size() ) {
+                    buffer = chunk;
+                }
+                else {
+                    buffer = buffer.mid( pos ) + chunk;
+                }
+                pos = 0;
+                return true;
+            }
+
+
+            bool TsvStreamReader::Private::readLine( QByteArray* line )
+            {
+                int start = pos;
+                while ( true ) {
+                    int end = buffer.indexOf( '\n', start );
+                    if ( end >= 0 ) {
+                        *line = buffer.mid( pos, end - pos );
+                        pos = end + 1;
+                        break;
+                    }
+
+                    // only search the new data after filling the buffer
+                    start = buffer.size() - pos;
+                    if ( !fill() ) {
+                        if ( pos >= buffer.size() ) {
+                            return false;
+                        }
+                        *line = buffer.mid( pos );
+                        pos = buffer.size();
+                        break;
+                    }
+                }
+
+                if ( line->endsWith( '\r' ) ) {
+                    line->chop( 1 );
+                }
+                return true;
+            }
+
+
+            bool TsvStreamReader::Private::parseTerm( const QByteArray& field, Binding* binding )
+            {
+                const char c = field[0];
+
+                // URIs and blank nodes are the most common terms and are handled directly
+                if ( c == '<' && field.endsWith( '>' ) ) {
+                    Uri uri;
+                    uri.setUri( QUrl::fromEncoded( field.mid( 1, field.length() - 2 ) ) );
+                    binding->setUri( uri );
+                    return true;
+                }
+                else if ( field.startsWith( "_:" ) ) {
+                    Bnode bnode;
+                    bnode.setId( QString::fromUtf8( field.constData() + 2, field.length() - 2 ) );
+                    binding->setBnode( bnode );
+                    return true;
+                }
+
+                // numbers and booleans may be written without quotes
+                Literal literal;
+                if ( field == "true" || field == "false" ) {
+                    literal.setDatatype( Vocabulary::XMLSchema::boolean().toString() );
+                    literal.setData( QString::fromLatin1( field ) );
+                }
+                else if ( ( c >= '0' && c <= '9' ) || c == '+' || c == '-' || c == '.' ) {
+                    if ( field.contains( 'e' ) || field.contains( 'E' ) )
+                        literal.setDatatype( Vocabulary::XMLSchema::xsdDouble().toString() );
+                    else if ( field.contains( '.' ) )
+                        literal.setDatatype( Vocabulary::XMLSchema::decimal().toString() );
+                    else
+                        literal.setDatatype( Vocabulary::XMLSchema::integer().toString() );
+                    literal.setData( QString::fromLatin1( field ) );
+                }
+
+                // quoted literals may contain escape sequences, language tags, and datatypes
+                else {
+                    Node node = Node::fromN3( QString::fromUtf8( field.constData(), field.length() ) );
+                    if ( !node.isLiteral() ) {
+                        q->setError( QString::fromLatin1( "Invalid SPARQL TSV result: cannot parse term %1" )
+                                     .arg( QString::fromUtf8( field.constData(), field.length() ) ) );
+                        return false;
+                    }
+                    if ( !node.literal().isPlain() ) {
+                        literal.setDatatype( node.dataType().toString() );
+                    }
+                    literal.setXml_lang( node.language() );
+                    literal.setData( node.literal().toString() );
+                }
+
+                binding->setLiteral( literal );
+                return true;
+            }
+
+
+            TsvStreamReader::TsvStreamReader( DataSource* source )
+                : StreamReader( source ),
+                  d( new Private( this ) )
+            {
+            }
+
+
+            TsvStreamReader::~TsvStreamReader()
+            {
+                delete d;
+            }
+
+
+            bool TsvStreamReader::readHead()
+            {
+                QByteArray line;
+                if ( !d->readLine( &line ) ) {
+                    return false;
+                }
+
+                Head head;
+                foreach( const QByteArray& field, line.split( '\t' ) ) {
+                    // all variables are written with their leading question mark
+                    if ( !field.startsWith( '?' ) && !field.startsWith( '$' ) ) {
+                        return false;
+                    }
+                    Variable v;
+                    v.setName( QString::fromUtf8( field.constData() + 1, field.length() - 1 ) );
+                    head.addVariable( v );
+                    d->variables << v.name();
+                }
+
+                // from here on we do not need to keep a copy of the data anymore
+                setKeepData( false );
+                setHead( head );
+                return true;
+            }
+
+
+            bool TsvStreamReader::readResult( Result* result )
+            {
+                QByteArray line;
+                if ( hasError() || !d->readLine( &line ) ) {
+                    return false;
+                }
+
+                *result = Result();
+                QList<QByteArray> fields = line.split( '\t' );
+                if ( fields.count() != d->variables.count() ) {
+                    setError( QString::fromLatin1( "Invalid SPARQL TSV result: expected %1 fields, got %2" )
+                              .arg( d->variables.count() )
+                              .arg( fields.count() ) );
+                    return false;
+                }
+
+                for ( int i = 0; i < fields.count(); ++i ) {
+                    // unbound variables are simply left out
+                    if ( !fields[i].isEmpty() ) {
+                        Binding binding;
+                        if ( !d->parseTerm( fields[i], &binding ) ) {
+                            return false;
+                        }
+                        binding.setName( d->variables[i] );
+                        result->addBinding( binding );
+                    }
+                }
+
+                return true;
+            }
+        }
+    }
+}
@@ -24,11 +24,9 @@
 #include "sparqlxmlresultparser.h"
 
 #include <qfile.h>
-#include <QtXml/QDomElement>
-#include <QtXml/QDomNode>
 #include <qtextstream.h>
 #include <QTextStream>
-#include <QtCore/QBuffer>
+#include <QtCore/QXmlStreamReader>
 #include <QtCore/QDebug>
 
 QString indent( int n = 0 )
@@ -42,26 +40,6 @@ QString indent( int n = 0 )
 namespace Soprano {
     namespace Client {
         namespace SparqlParser {
-            Unbound Unbound::parseElement( const QDomElement &element, bool *ok )
-            {
-                if ( element.tagName() != "unbound" ) {
-                    //kError()() << "Expected 'unbound', got '" <<element.tagName() << "'.";
-                    if ( ok ) *ok = false;
-                    return Unbound();
-                }
-
-                Unbound result = Unbound();
-
-                QDomNode n;
-                for( n = element.firstChild(); !n.isNull(); n = n.nextSibling() ) {
-                    QDomElement e = n.toElement();
-                }
-
-
-                if ( ok ) *ok = true;
-                return result;
-            }
-
             QString Unbound::writeElement() const
             {
                 QString xml;
@@ -100,32 +78,6 @@ namespace Soprano {
                 return mXml_lang;
             }
 
-            Literal Literal::parseElement( const QDomElement &element, bool *ok )
-            {
-                if ( element.tagName() != "literal" ) {
-                    //kError()() << "Expected 'literal', got '" <<element.tagName() << "'.";
-                    if ( ok ) *ok = false;
-                    return Literal();
-                }
-
-                Literal result = Literal();
-
-                QDomNode n;
-                for( n = element.firstChild(); !n.isNull(); n = n.nextSibling() ) {
-                    QDomElement e = n.toElement();
-                }
-
-                result.setDatatype( element.attribute( "datatype" ) );
-                result.setXsi_type( element.attribute( "xsi:type" ) );
-                result.setXml_lang( element.attribute( "xml:lang" ) );
-                result.setData( element.text());
-
-                if ( ok ) *ok = true;
-                return result;
-            }
-
-
-
             QString Literal::writeElement() const
             {
                 QString xml;
@@ -137,23 +89,6 @@ namespace Soprano {
             }
 
 
-            Bnode Bnode::parseElement( const QDomElement &element, bool *ok )
-            {
-                if ( element.tagName() != "bnode" ) {
-                    //kError()() << "Expected 'bnode', got '" <<element.tagName() << "'.";
-                    if ( ok ) *ok = false;
-                    return Bnode();
-                }
-
-                Bnode result = Bnode();
-                result.setId(element.text());
-
-
-
-                if ( ok ) *ok = true;
-                return result;
-            }
-
             QString Bnode::writeElement() const
             {
                 QString xml;
@@ -165,23 +100,6 @@ namespace Soprano {
             }
 
 
-            Uri Uri::parseElement( const QDomElement &element, bool *ok )
-            {
-                if ( element.tagName() != "uri" ) {
-                    //kError()() << "Expected 'uri', got '" <<element.tagName() << "'.";
-                    if ( ok ) *ok = false;
-                    return Uri();
-                }
-
-                Uri result = Uri();
-                result.setUri(QUrl::fromEncoded(element.text().toUtf8()));
-
-
-
-                if ( ok ) *ok = true;
-                return result;
-            }
-
             QString Uri::writeElement() const
             {
                 QString xml;
@@ -210,6 +128,7 @@ namespace Soprano {
             void Binding::setUri( const Uri &v )
             {
                 mUri = v;
+                mType = Binding::URI;
             }
 
             Uri Binding::uri() const
@@ -220,6 +139,7 @@ namespace Soprano {
             void Binding::setBnode( const Bnode &v )
             {
                 mBnode = v;
+                mType = Binding::BNODE;
             }
 
             Bnode Binding::bnode() const
@@ -230,6 +150,7 @@ namespace Soprano {
             void Binding::setLiteral( const Literal &v )
             {
                 mLiteral = v;
+                mType = Binding::LITERAL;
             }
 
             Literal Binding::literal() const
@@ -240,6 +161,7 @@ namespace Soprano {
             void Binding::setUnbound( const Unbound &v )
             {
                 mUnbound = v;
+                mType = Binding::UNBOUND;
             }
 
             Unbound Binding::unbound() const
@@ -247,51 +169,6 @@ namespace Soprano {
                 return mUnbound;
             }
 
-            Binding Binding::parseElement( const QDomElement &element, bool *ok )
-            {
-                if ( element.tagName() != "binding" ) {
-                    //kError()() << "Expected 'binding', got '" <<element.tagName() << "'.";
-                    if ( ok ) *ok = false;
-                    return Binding();
-                }
-
-                Binding result = Binding();
-                result.mType = Binding::NONE;
-                QDomNode n;
-                for( n = element.firstChild(); !n.isNull(); n = n.nextSibling() ) {
-                    QDomElement e = n.toElement();
-                    if ( e.tagName() == "uri" ) {
-                        bool ok;
-                        Uri o = Uri::parseElement( e, &ok );
-                        if ( ok ) result.setUri( o );
-                        result.mType = Binding::URI;
-                    }
-                    else if ( e.tagName() == "bnode" ) {
-                        bool ok;
-                        Bnode o = Bnode::parseElement( e, &ok );
-                        if ( ok ) result.setBnode( o );
-                        result.mType = Binding::BNODE;
-                    }
-                    else if ( e.tagName() == "literal" ) {
-                        bool ok;
-                        Literal o = Literal::parseElement( e, &ok );
-                        if ( ok ) result.setLiteral( o );
-                        result.mType = Binding::LITERAL;
-                    }
-                    else if ( e.tagName() == "unbound" ) {
-                        bool ok;
-                        Unbound o = Unbound::parseElement( e, &ok );
-                        if ( ok ) result.setUnbound( o );
-                        result.mType = Binding::UNBOUND;
-                    }
-                }
-
-                result.setName( element.attribute( "name" ) );
-
-                if ( ok ) *ok = true;
-                return result;
-            }
-
             QString Binding::writeElement() const
             {
                 QString xml;
@@ -346,33 +223,6 @@ namespace Soprano {
                 return mBindingList;
             }
 
-            Result Result::parseElement( const QDomElement &element, bool *ok )
-            {
-                if ( element.tagName() != "result" ) {
-                    //kError()() << "Expected 'result', got '" <<element.tagName() << "'.";
-                    if ( ok ) *ok = false;
-                    return Result();
-                }
-
-                Result result = Result();
-
-                QDomNode n;
-                for( n = element.firstChild(); !n.isNull(); n = n.nextSibling() ) {
-                    QDomElement e = n.toElement();
-                    if ( e.tagName() == "binding" ) {
-                        bool ok;
-                        Binding o = Binding::parseElement( e, &ok );
-                        if ( ok ) result.addBinding( o );
-                    }
-                }
-
-                result.setXml_lang( element.attribute( "xml:lang" ) );
-                result.setIndex( element.attribute( "index" ) );
-
-                if ( ok ) *ok = true;
-                return result;
-            }
-
             QString Result::writeElement() const
             {
                 QString xml;
@@ -387,31 +237,6 @@ namespace Soprano {
             }
 
 
-            Boolean Boolean::parseElement( const QDomElement &element, bool *ok )
-            {
-                if ( element.tagName() != "boolean" ) {
-                    //kError()() << "Expected 'boolean', got '" <<element.tagName() << "'.";
-                    if ( ok ) *ok = false;
-                    return Boolean();
-                }
-
-                Boolean result = Boolean();
-                result.mValue = false;
-                if(element.text().simplified() == QString("true")) {
-                    result.mValue = true;
-                }
-
-                QDomNode n;
-                for( n = element.firstChild(); !n.isNull(); n = n.nextSibling() ) {
-                    QDomElement e = n.toElement();
-                }
-
-
-                if ( ok ) *ok = true;
-                result.mIsValid = true;
-                return result;
-            }
-
             QString Boolean::writeElement() const
             {
                 QString xml;
@@ -435,31 +260,6 @@ namespace Soprano {
                 return mResultList;
             }
 
-            Results Results::parseElement( const QDomElement &element, bool *ok )
-            {
-                if ( element.tagName() != "results" ) {
-                    //kError()() << "Expected 'results', got '" <<element.tagName() << "'.";
-                    if ( ok ) *ok = false;
-                    return Results();
-                }
-
-                Results result = Results();
-
-                QDomNode n;
-                for( n = element.firstChild(); !n.isNull(); n = n.nextSibling() ) {
-                    QDomElement e = n.toElement();
-                    if ( e.tagName() == "result" ) {
-                        bool ok;
-                        Result o = Result::parseElement( e, &ok );
-                        if ( ok ) result.addResult( o );
-                    }
-                }
-
-
-                if ( ok ) *ok = true;
-                return result;
-            }
-
             QString Results::writeElement() const
             {
                 QString xml;
@@ -485,27 +285,6 @@ namespace Soprano {
                 return mName;
             }
 
-            Variable Variable::parseElement( const QDomElement &element, bool *ok )
-            {
-                if ( element.tagName() != "variable" ) {
-                    //kError()() << "Expected 'variable', got '" <<element.tagName() << "'.";
-                    if ( ok ) *ok = false;
-                    return Variable();
-                }
-
-                Variable result = Variable();
-
-                QDomNode n;
-                for( n = element.firstChild(); !n.isNull(); n = n.nextSibling() ) {
-                    QDomElement e = n.toElement();
-                }
-
-                result.setName( element.attribute( "name" ) );
-
-                if ( ok ) *ok = true;
-                return result;
-            }
-
             QString Variable::writeElement() const
             {
                 QString xml;
@@ -529,31 +308,6 @@ namespace Soprano {
                 return mVariableList;
             }
 
-            Head Head::parseElement( const QDomElement &element, bool *ok )
-            {
-                if ( element.tagName() != "head" ) {
-                    //kError()() << "Expected 'head', got '" <<element.tagName() << "'.";
-                    if ( ok ) *ok = false;
-                    return Head();
-                }
-
-                Head result = Head();
-
-                QDomNode n;
-                for( n = element.firstChild(); !n.isNull(); n = n.nextSibling() ) {
-                    QDomElement e = n.toElement();
-                    if ( e.tagName() == "variable" ) {
-                        bool ok;
-                        Variable o = Variable::parseElement( e, &ok );
-                        if ( ok ) result.addVariable( o );
-                    }
-                }
-
-
-                if ( ok ) *ok = true;
-                return result;
-            }
-
             QString Head::writeElement() const
             {
                 QString xml;
@@ -619,43 +373,6 @@ namespace Soprano {
             }
 
 
-            Sparql Sparql::parseElement( const QDomElement &element, bool *ok )
-            {
-                if ( element.tagName() != "sparql" ) {
-                    //kError()() << "Expected 'sparql', got '" <<element.tagName() << "'.";
-                    if ( ok ) *ok = false;
-                    return Sparql();
-                }
-
-                Sparql result = Sparql();
-
-                QDomNode n;
-                for( n = element.firstChild(); !n.isNull(); n = n.nextSibling() ) {
-                    QDomElement e = n.toElement();
-                    if ( e.tagName() == "head" ) {
-                        bool ok;
-                        Head o = Head::parseElement( e, &ok );
-                        if ( ok ) result.setHead( o );
-                    }
-                    else if ( e.tagName() == "boolean" ) {
-                        bool ok;
-                        Boolean o = Boolean::parseElement( e, &ok );
-                        if ( ok ) result.setBoolean( o );
-                    }
-                    else if ( e.tagName() == "results" ) {
-                        bool ok;
-                        Results o = Results::parseElement( e, &ok );
-                        if ( ok ) result.setResults( o );
-                    }
-                }
-
-                result.setXml_lang( element.attribute( "xml:lang" ) );
-                result.setXsi_schemaLocation( element.attribute( "xsi:schemaLocation" ) );
-
-                if ( ok ) *ok = true;
-                return result;
-            }
-
             QString Sparql::writeElement() const
             {
                 QString xml;
@@ -668,71 +385,382 @@ namespace Soprano {
                 return xml;
             }
 
-            Sparql Sparql::parseFile( const QString &filename, bool *ok )
+            bool Sparql::writeFile( const QString &filename )
             {
                 QFile file( filename );
-                if ( !file.open( QIODevice::ReadOnly ) ) {
+                if ( !file.open( QIODevice::WriteOnly ) ) {
                     //kError()() << "Unable to open file '" << filename << "'";
-                    if ( ok ) *ok = false;
-                    return Sparql();
+                    return false;
+                }
+
+                QTextStream ts( &file );
+                ts << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+                ts << writeElement();
+                file.close();
+
+                return true;
+            }
+
+
+            class StreamReader::Private
+            {
+            public:
+                Private( DataSource* s )
+                    : source( s ),
+                      sourceFinished( false ),
+                      keepData( true ) {
+                }
+
+                ~Private() {
+                    delete source;
                 }
 
-                QString errorMsg;
-                int errorLine, errorCol;
-                QDomDocument doc;
-                if ( !doc.setContent( &file, false, &errorMsg, &errorLine, &errorCol ) ) {
-                    //kError()() << errorMsg << " at " << errorLine << "," << errorCol;
-                    if ( ok ) *ok = false;
-                    return Sparql();
+                DataSource* source;
+                bool sourceFinished;
+
+                // all data is kept until we know that this is a result document
+                bool keepData;
+                QByteArray data;
+
+                Head head;
+                Boolean boolean;
+                QString error;
+            };
+
+
+            StreamReader::StreamReader( DataSource* source )
+                : d( new Private( source ) )
+            {
+            }
+
+
+            StreamReader::~StreamReader()
+            {
+                delete d;
+            }
+
+
+            Head StreamReader::head() const
+            {
+                return d->head;
+            }
+
+
+            Boolean StreamReader::boolean() const
+            {
+                return d->boolean;
+            }
+
+
+            bool StreamReader::hasError() const
+            {
+                return !d->error.isEmpty();
+            }
+
+
+            QString StreamReader::errorString() const
+            {
+                return d->error;
+            }
+
+
+            QByteArray StreamReader::readAll()
+            {
+                QByteArray all = d->data;
+                d->data.clear();
+                if ( d->keepData ) {
+                    while ( !d->sourceFinished ) {
+                        QByteArray chunk = d->source->waitForData();
+                        if ( chunk.isEmpty() ) {
+                            d->sourceFinished = true;
+                        }
+                        else {
+                            all.append( chunk );
+                        }
+                    }
                 }
+                return all;
+            }
 
-                //kDebug() << "CONTENT:" << doc.toString();
 
-                bool documentOk;
-                Sparql c = parseElement( doc.documentElement(), &documentOk );
-                if ( ok ) {
-                    *ok = documentOk;
+            QByteArray StreamReader::fetchData()
+            {
+                if ( d->sourceFinished ) {
+                    return QByteArray();
                 }
-                return c;
+
+                QByteArray chunk = d->source->waitForData();
+                if ( chunk.isEmpty() ) {
+                    d->sourceFinished = true;
+                }
+                else if ( d->keepData ) {
+                    d->data.append( chunk );
+                }
+                return chunk;
             }
 
-            Sparql Sparql::parseByteArray( const QByteArray& bytes, bool *ok )
+
+            void StreamReader::setKeepData( bool keep )
             {
-                QString errorMsg;
-                int errorLine, errorCol;
-                QDomDocument doc;
-                if ( !doc.setContent( bytes, false, &errorMsg, &errorLine, &errorCol ) ) {
-                    //kError()() << errorMsg << " at " << errorLine << "," << errorCol;
-                    if ( ok ) *ok = false;
-                    return Sparql();
+                d->keepData = keep;
+                if ( !keep ) {
+                    d->data.clear();
                 }
+            }
+
+
+            void StreamReader::setHead( const Head& head )
+            {
+                d->head = head;
+            }
+
+
+            void StreamReader::setBoolean( const Boolean& boolean )
+            {
+                d->boolean = boolean;
+            }
+
 
-                //kDebug() << "CONTENT:" << doc.toString();
+            void StreamReader::setError( const QString& error )
+            {
+                d->error = error;
+            }
 
-                bool documentOk;
-                Sparql c = parseElement( doc.documentElement(), &documentOk );
-                if ( ok ) {
-                    *ok = documentOk;
+
+            class XmlStreamReader::Private
+            {
+            public:
+                Private( XmlStreamReader* parent )
+                    : q( parent ) {
+                }
+
+                QXmlStreamReader::TokenType readNext();
+                bool readStartElement();
+                QString readText();
+                bool readValue( Binding* binding );
+                bool parseResult( Result* result );
+                bool checkError();
+
+                QXmlStreamReader xml;
+
+            private:
+                XmlStreamReader* q;
+            };
+
+
+            QXmlStreamReader::TokenType XmlStreamReader::Private::readNext()
+            {
+                while ( true ) {
+                    QXmlStreamReader::TokenType token = xml.readNext();
+                    if ( token == QXmlStreamReader::Invalid &&
+                         xml.error() == QXmlStreamReader::PrematureEndOfDocumentError ) {
+                        // the parser simply continues where it stopped once we added more data
+                        QByteArray chunk = q->fetchData();
+                        if ( chunk.isEmpty() ) {
+                            return token;
+                        }
+                        xml.addData( chunk );
+                    }
+                    else {
+                        return token;
+                    }
                 }
-                return c;
             }
 
-            bool Sparql::writeFile( const QString &filename )
+
+            // read up to the next start element at the current level, false if the level ends
+            bool XmlStreamReader::Private::readStartElement()
             {
-                QFile file( filename );
-                if ( !file.open( QIODevice::WriteOnly ) ) {
-                    //kError()() << "Unable to open file '" << filename << "'";
+                while ( true ) {
+                    switch( readNext() ) {
+                    case QXmlStreamReader::StartElement:
+                        return true;
+                    case QXmlStreamReader::EndElement:
+                    case QXmlStreamReader::EndDocument:
+                    case QXmlStreamReader::Invalid:
+                        return false;
+                    default:
+                        break;
+                    }
+                }
+            }
+
+
+            // read the text of the current element, ignoring nested elements
+            QString XmlStreamReader::Private::readText()
+            {
+                QString text;
+                int depth = 1;
+                while ( depth > 0 ) {
+                    switch( readNext() ) {
+                    case QXmlStreamReader::Characters:
+                        if ( depth == 1 ) {
+                            text.append( xml.text() );
+                        }
+                        break;
+                    case QXmlStreamReader::StartElement:
+                        ++depth;
+                        break;
+                    case QXmlStreamReader::EndElement:
+                        --depth;
+                        break;
+                    case QXmlStreamReader::EndDocument:
+                    case QXmlStreamReader::Invalid:
+                        return text;
+                    default:
+                        break;
+                    }
+                }
+                return text;
+            }
+
+
+            bool XmlStreamReader::Private::readValue( Binding* binding )
+            {
+                if ( xml.name() == QLatin1String( "uri" ) ) {
+                    Uri uri;
+                    uri.setUri( QUrl::fromEncoded( readText().toUtf8() ) );
+                    binding->setUri( uri );
+                }
+                else if ( xml.name() == QLatin1String( "bnode" ) ) {
+                    Bnode bnode;
+                    bnode.setId( readText() );
+                    binding->setBnode( bnode );
+                }
+                else if ( xml.name() == QLatin1String( "literal" ) ) {
+                    Literal literal;
+                    QXmlStreamAttributes attributes = xml.attributes();
+                    literal.setDatatype( attributes.value( QLatin1String( "datatype" ) ).toString() );
+                    literal.setXsi_type( attributes.value( QLatin1String( "xsi:type" ) ).toString() );
+                    literal.setXml_lang( attributes.value( QLatin1String( "xml:lang" ) ).toString() );
+                    literal.setData( readText() );
+                    binding->setLiteral( literal );
+                }
+                else if ( xml.name() == QLatin1String( "unbound" ) ) {
+                    readText();
+                    binding->setUnbound( Unbound() );
+                }
+                else {
+                    readText();
                     return false;
                 }
+                return !xml.hasError();
+            }
+
+
+            bool XmlStreamReader::Private::parseResult( Result* result )
+            {
+                *result = Result();
+                result->setXml_lang( xml.attributes().value( QLatin1String( "xml:lang" ) ).toString() );
+                result->setIndex( xml.attributes().value( QLatin1String( "index" ) ).toString() );
+
+                while ( readStartElement() ) {
+                    if ( xml.name() == QLatin1String( "binding" ) ) {
+                        Binding binding;
+                        binding.setName( xml.attributes().value( QLatin1String( "name" ) ).toString() );
+                        bool valid = false;
+                        while ( readStartElement() ) {
+                            valid = readValue( &binding );
+                        }
+                        if ( valid ) {
+                            result->addBinding( binding );
+                        }
+                    }
+                    else {
+                        readText();
+                    }
+                }
+
+                return checkError();
+            }
 
-                QTextStream ts( &file );
-                ts << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-                ts << writeElement();
-                file.close();
 
+            bool XmlStreamReader::Private::checkError()
+            {
+                if ( xml.hasError() ) {
+                    q->setError( QString::fromLatin1( "Invalid SPARQL result at line %1, column %2: %3" )
+                                 .arg( xml.lineNumber() )
+                                 .arg( xml.columnNumber() )
+                                 .arg( xml.errorString() ) );
+                    return false;
+                }
                 return true;
             }
 
+
+            XmlStreamReader::XmlStreamReader( DataSource* source )
+                : StreamReader( source ),
+                  d( new Private( this ) )
+            {
+            }
+
+
+            XmlStreamReader::~XmlStreamReader()
+            {
+                delete d;
+            }
+
+
+            bool XmlStreamReader::readHead()
+            {
+                if ( !d->readStartElement() || d->xml.name() != QLatin1String( "sparql" ) ) {
+                    d->checkError();
+                    return false;
+                }
+
+                // from here on we do not need to keep a copy of the data anymore
+                setKeepData( false );
+
+                Head head;
+                while ( d->readStartElement() ) {
+                    if ( d->xml.name() == QLatin1String( "head" ) ) {
+                        while ( d->readStartElement() ) {
+                            if ( d->xml.name() == QLatin1String( "variable" ) ) {
+                                Variable v;
+                                v.setName( d->xml.attributes().value( QLatin1String( "name" ) ).toString() );
+                                head.addVariable( v );
+                            }
+                            // skip link elements and the end of the variable element
+                            d->readText();
+                        }
+                        setHead( head );
+                    }
+                    else if ( d->xml.name() == QLatin1String( "boolean" ) ) {
+                        Boolean b;
+                        b.setValue( d->readText().simplified() == QLatin1String( "true" ) );
+                        setBoolean( b );
+                        return d->checkError();
+                    }
+                    else if ( d->xml.name() == QLatin1String( "results" ) ) {
+                        // the results are read one by one via readResult
+                        return true;
+                    }
+                    else {
+                        d->readText();
+                    }
+                }
+
+                return d->checkError();
+            }
+
+
+            bool XmlStreamReader::readResult( Result* result )
+            {
+                if ( boolean().isValid() ) {
+                    return false;
+                }
+
+                while ( d->readStartElement() ) {
+                    if ( d->xml.name() == QLatin1String( "result" ) ) {
+                        return d->parseResult( result );
+                    }
+                    else {
+                        d->readText();
+                    }
+                }
+                d->checkError();
+                return false;
+            }
         }
     }
 }
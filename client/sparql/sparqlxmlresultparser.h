@@ -29,7 +29,7 @@
 #include <QListIterator>
 #include <QUrl>
 
-class QDomElement;
+class QByteArray;
 
 namespace Soprano {
     namespace Client {
@@ -37,10 +37,6 @@ namespace Soprano {
             class Unbound
             {
             public:
-                /**
-                   Parse XML object from DOM element.
-                */
-                static Unbound parseElement( const QDomElement &element, bool *ok );
                 QString writeElement() const;
 
             };
@@ -58,10 +54,6 @@ namespace Soprano {
                 void setData( const QString &v ) { this->mData = v; };
                 QString data() const { return this->mData; }
     
-                /**
-                   Parse XML object from DOM element.
-                */
-                static Literal parseElement( const QDomElement &element, bool *ok );
                 QString writeElement() const;
 
             private:
@@ -74,10 +66,6 @@ namespace Soprano {
             class Bnode
             {
             public:
-                /**
-                   Parse XML object from DOM element.
-                */
-                static Bnode parseElement( const QDomElement &element, bool *ok );
                 QString writeElement() const;
                 void setId( const QString &v ) { this->mId = v; };
                 QString id() const { return this->mId; }
@@ -89,10 +77,6 @@ namespace Soprano {
             class Uri
             {
             public:
-                /**
-                   Parse XML object from DOM element.
-                */
-                static Uri parseElement( const QDomElement &element, bool *ok );
                 QString writeElement() const;
     
                 void setUri( const QUrl &v ) { this->mUri = v; };
@@ -127,10 +111,6 @@ namespace Soprano {
 
                 BindingType type() const ;
     
-                /**
-                   Parse XML object from DOM element.
-                */
-                static Binding parseElement( const QDomElement &element, bool *ok );
                 QString writeElement() const;
 
             private:
@@ -156,10 +136,6 @@ namespace Soprano {
                 void addBinding( const Binding &v );
                 void setBindingList( const Binding::List &v );
                 Binding::List bindingList() const;
-                /**
-                   Parse XML object from DOM element.
-                */
-                static Result parseElement( const QDomElement &element, bool *ok );
                 QString writeElement() const;
 
             private:
@@ -175,13 +151,10 @@ namespace Soprano {
                     : mIsValid(false),
                     mValue(false) {}
 
-                /**
-                   Parse XML object from DOM element.
-                */
-                static Boolean parseElement( const QDomElement &element, bool *ok );
                 QString writeElement() const;
 
                 bool isValid() const { return mIsValid; }
+                void setValue( bool v ) { this->mValue = v; this->mIsValid = true; }
                 bool value() const { return this->mValue; }
             private:
                 bool mIsValid;
@@ -194,10 +167,6 @@ namespace Soprano {
                 void addResult( const Result &v );
                 void setResultList( const Result::List &v );
                 Result::List resultList() const;
-                /**
-                   Parse XML object from DOM element.
-                */
-                static Results parseElement( const QDomElement &element, bool *ok );
                 QString writeElement() const;
 
             private:
@@ -212,10 +181,6 @@ namespace Soprano {
             public:
                 void setName( const QString &v );
                 QString name() const;
-                /**
-                   Parse XML object from DOM element.
-                */
-                static Variable parseElement( const QDomElement &element, bool *ok );
                 QString writeElement() const;
 
             private:
@@ -228,10 +193,6 @@ namespace Soprano {
                 void addVariable( const Variable &v );
                 void setVariableList( const Variable::List &v );
                 Variable::List variableList() const;
-                /**
-                   Parse XML object from DOM element.
-                */
-                static Head parseElement( const QDomElement &element, bool *ok );
                 QString writeElement() const;
 
             private:
@@ -251,13 +212,7 @@ namespace Soprano {
                 Boolean boolean() const;
                 void setResults( const Results &v );
                 Results results() const;
-                /**
-                   Parse XML object from DOM element.
-                */
-                static Sparql parseElement( const QDomElement &element, bool *ok );
                 QString writeElement() const;
-                static Sparql parseFile( const QString &filename, bool *ok );
-                static Sparql parseByteArray( const QByteArray& array, bool *ok );
                 bool writeFile( const QString &filename );
 
             private:
@@ -267,6 +222,110 @@ namespace Soprano {
                 Boolean mBoolean;
                 Results mResults;
             };
+
+            /**
+             * Base class for incremental parsers of SPARQL query results.
+             *
+             * The response does not need to be available in full. The reader
+             * pulls the data from a DataSource whenever it runs out of input.
+             * This allows to hand out results while the response is still
+             * being received.
+             */
+            class StreamReader
+            {
+            public:
+                /**
+                 * Provides the raw response data to the StreamReader.
+                 */
+                class DataSource
+                {
+                public:
+                    virtual ~DataSource() {}
+
+                    /**
+                     * Block until more data is available.
+                     *
+                     * \return The data received since the last call or an empty
+                     * array if the response is complete.
+                     */
+                    virtual QByteArray waitForData() = 0;
+                };
+
+                /**
+                 * Create a new reader. The reader takes ownership of \p source.
+                 */
+                StreamReader( DataSource* source );
+                virtual ~StreamReader();
+
+                /**
+                 * Read the head of the document up to the first result
+                 * or the boolean value.
+                 *
+                 * \return \p false if the data is not a SPARQL query result
+                 * document.
+                 */
+                virtual bool readHead() = 0;
+
+                Head head() const;
+                Boolean boolean() const;
+
+                /**
+                 * Read the next result.
+                 *
+                 * \return \p false if there are no more results or on error.
+                 */
+                virtual bool readResult( Result* result ) = 0;
+
+                bool hasError() const;
+                QString errorString() const;
+
+                /**
+                 * Read the complete response including all data read so far.
+                 * Used to hand non-result documents such as graphs to other
+                 * parsers after readHead() failed.
+                 */
+                QByteArray readAll();
+
+            protected:
+                /**
+                 * Fetch the next chunk of data from the source.
+                 *
+                 * \return An empty array if the response is complete.
+                 */
+                QByteArray fetchData();
+
+                /**
+                 * As long as \p keep is \p true all fetched data is kept
+                 * for readAll(). Subclasses disable it once they know that
+                 * the data is a result document.
+                 */
+                void setKeepData( bool keep );
+
+                void setHead( const Head& head );
+                void setBoolean( const Boolean& boolean );
+                void setError( const QString& error );
+
+            private:
+                class Private;
+                Private* const d;
+            };
+
+            /**
+             * Incremental parser for the SPARQL query results XML format.
+             */
+            class XmlStreamReader : public StreamReader
+            {
+            public:
+                XmlStreamReader( DataSource* source );
+                ~XmlStreamReader();
+
+                bool readHead();
+                bool readResult( Result* result );
+
+            private:
+                class Private;
+                Private* const d;
+            };
         }
     }
 }
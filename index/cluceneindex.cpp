@@ -34,6 +34,8 @@
 #include <QtCore/QMutex>
 #include <QtCore/QThread>
 #include <QtCore/QMutexLocker>
+#include <QtCore/QSet>
+#include <QtCore/QSharedPointer>
 
 
 
@@ -41,6 +43,20 @@
 // indexwriter needs to be closed for deletion
 // indexreader needs to be closed after usage of writer
 
+namespace {
+    // deleter for the shared searcher which is used by the query hit iterators
+    void deleteSearcher( lucene::search::Searcher* searcher )
+    {
+        try {
+            searcher->close();
+        }
+        catch ( CLuceneError& err ) {
+            qDebug() << "(Soprano::Index::CLuceneIndex) could not close index seacher " << err.what();
+        }
+        delete searcher;
+    }
+}
+
 class Soprano::Index::CLuceneIndex::Private
 {
 public:
@@ -50,9 +66,13 @@ public:
           indexWriter( 0 ),
           analyzer( 0 ),
           queryAnalyzer( 0 ),
-          searcher( 0 ),
+          searcherGeneration( -1 ),
+          commitGeneration( 0 ),
           deleteAnalyzer( false ),
-          transactionID( 0 ) {
+          transactionID( 0 ),
+          documentCacheHits( 0 ),
+          documentCacheMisses( 0 ),
+          documentsWritten( 0 ) {
     }
 
     lucene::store::Directory* indexDir;
@@ -60,14 +80,32 @@ public:
     lucene::index::IndexWriter* indexWriter;
     lucene::analysis::Analyzer* analyzer;
     lucene::analysis::Analyzer* queryAnalyzer;
-    lucene::search::IndexSearcher* searcher;
+
+    // The searcher is shared by all queries and only replaced after a commit. Query hit
+    // iterators keep a reference to the searcher they were created from. Thus, searching
+    // only needs to lock the index mutex when the searcher is reopened.
+    // Lock order: mutex before searcherMutex.
+    QSharedPointer<lucene::search::Searcher> searcher;
+    int searcherGeneration;
+    int commitGeneration;
+    QMutex searcherMutex;
 
     bool deleteAnalyzer;
 
     // if > 0 a transaction is running
     int transactionID;
+
+    // all documents changed in the current transaction. Each of them is written exactly once on commit.
     QHash<Node, lucene::document::Document*> documentCache;
 
+    // the resources in documentCache which already have a document in the index that needs to be replaced
+    QSet<Node> storedResources;
+
+    // statistics
+    qint64 documentCacheHits;
+    qint64 documentCacheMisses;
+    qint64 documentsWritten;
+
     QMutex mutex;
 
     bool indexPresent() const {
@@ -101,26 +139,50 @@ public:
         return indexWriter;
     }
 
-    lucene::search::Searcher* getIndexSearcher() {
-        if ( !searcher ) {
+    /**
+     * Returns the searcher for the last commit, reopening it if necessary.
+     * Has to be called with the index mutex locked so reopening does not
+     * race with a commit writing the directory.
+     */
+    QSharedPointer<lucene::search::Searcher> getIndexSearcher() {
+        QMutexLocker lock( &searcherMutex );
+        if ( !searcher || searcherGeneration != commitGeneration ) {
+            // the writer keeps the documents of previous commits buffered, the new
+            // searcher has to see them. This only happens once per commit generation.
             closeWriter();
-            searcher = _CLNEW lucene::search::IndexSearcher( indexDir );
+            // the previous searcher is closed once the last iterator using it is gone
+            searcher = QSharedPointer<lucene::search::Searcher>( _CLNEW lucene::search::IndexSearcher( indexDir ), deleteSearcher );
+            searcherGeneration = commitGeneration;
         }
         return searcher;
     }
 
-    // FIXME: what if someone is still using a Hits instance?
-    void closeReader() {
-        if ( searcher ) {
-            try {
-                searcher->close();
-            }
-            catch ( CLuceneError& err ) {
-                qDebug() << "(Soprano::Index::CLuceneIndex) could not close index seacher " << err.what();
-            }
-            delete searcher;
-            searcher = 0;
+    /**
+     * Returns the searcher if it is up to date, a null pointer if it has
+     * to be reopened via getIndexSearcher(). Does not need the index mutex.
+     */
+    QSharedPointer<lucene::search::Searcher> currentSearcher() {
+        QMutexLocker lock( &searcherMutex );
+        if ( searcher && searcherGeneration == commitGeneration ) {
+            return searcher;
         }
+        return QSharedPointer<lucene::search::Searcher>();
+    }
+
+    /**
+     * Make the searcher pick up the changes written to the index.
+     */
+    void markCommitted() {
+        QMutexLocker lock( &searcherMutex );
+        ++commitGeneration;
+    }
+
+    void releaseSearcher() {
+        QMutexLocker lock( &searcherMutex );
+        searcher.clear();
+    }
+
+    void closeReader() {
         if ( indexReader ) {
             try {
                 indexReader->close();
@@ -197,9 +259,12 @@ public:
         // check if the resource is already cached
         QHash<Node, lucene::document::Document*>::const_iterator it = documentCache.constFind( resource );
         if ( it != documentCache.constEnd() ) {
+            ++documentCacheHits;
             return *it;
         }
         else {
+            ++documentCacheMisses;
+
             QString id = getId( resource );
             lucene::document::Document* document = 0;
             // step 1: create a new document
@@ -225,6 +290,8 @@ public:
                 }
                 _CLDELETE( fields );
                 _CLDELETE( oldDoc );
+
+                storedResources.insert( resource );
             }
 
             // step 4: add the new doc to our cache
@@ -237,11 +304,12 @@ public:
     void commit() {
         // update all documents
 
-        // remove previous instances
-        if ( indexPresent() ) {
-            for ( QHash<Node, lucene::document::Document*>::iterator it = documentCache.begin();
-                  it != documentCache.end(); ++it ) {
-                lucene::document::Document* doc = it.value();
+        // remove previous instances. Documents that were created in this transaction
+        // do not have any.
+        if ( !storedResources.isEmpty() ) {
+            for ( QSet<Node>::const_iterator it = storedResources.constBegin();
+                  it != storedResources.constEnd(); ++it ) {
+                lucene::document::Document* doc = documentCache[*it];
                 if ( const TCHAR* id = doc->get( idFieldName().data() ) ) { // this check is only for testing, it should NEVER fail
                     lucene::index::Term* idTerm = _CLNEW lucene::index::Term( idFieldName().data(), id );
                     getIndexReader()->deleteDocuments( idTerm );
@@ -257,11 +325,16 @@ public:
             // never add empty docs
             if ( !docEmpty( doc ) ) {
                 getIndexWriter()->addDocument( doc );
+                ++documentsWritten;
             }
             _CLDELETE( doc );
         }
 
         documentCache.clear();
+        storedResources.clear();
+
+        // the writer stays open, the next search flushes it when reopening the searcher
+        markCommitted();
     }
 };
 
@@ -338,6 +411,7 @@ void Soprano::Index::CLuceneIndex::close()
     if ( d->transactionID ) {
         closeTransaction( d->transactionID );
     }
+    d->releaseSearcher();
     QMutexLocker lock( &d->mutex );
     d->closeReader();
     d->closeWriter();
@@ -537,6 +611,12 @@ Soprano::Node Soprano::Index::CLuceneIndex::getResource( lucene::document::Docum
 
 
 Soprano::Iterator<Soprano::Index::QueryHit> Soprano::Index::CLuceneIndex::search( const QString& query )
+{
+    return search( query, -1 );
+}
+
+
+Soprano::Iterator<Soprano::Index::QueryHit> Soprano::Index::CLuceneIndex::search( const QString& query, int limit, int offset, double minScore )
 {
     clearError();
     try {
@@ -547,7 +627,7 @@ Soprano::Iterator<Soprano::Index::QueryHit> Soprano::Index::CLuceneIndex::search
             return Iterator<QueryHit>();
         }
         else {
-            Iterator<QueryHit> hits = search( q );
+            Iterator<QueryHit> hits = search( q, limit, offset, minScore );
             // FIXME: is it possible to use the CLucene ref counting here?
             if ( !hits.isValid() ) {
                 delete q;
@@ -565,14 +645,24 @@ Soprano::Iterator<Soprano::Index::QueryHit> Soprano::Index::CLuceneIndex::search
 
 Soprano::Iterator<Soprano::Index::QueryHit> Soprano::Index::CLuceneIndex::search( lucene::search::Query* query )
 {
-    QMutexLocker lock( &d->mutex );
+    return search( query, -1 );
+}
+
 
+Soprano::Iterator<Soprano::Index::QueryHit> Soprano::Index::CLuceneIndex::search( lucene::search::Query* query, int limit, int offset, double minScore )
+{
+    // the index mutex is only needed to reopen the searcher: the searcher only sees committed data
     if ( query ) {
         clearError();
         try {
-            lucene::search::Hits* hits = d->getIndexSearcher()->search( query );
+            QSharedPointer<lucene::search::Searcher> searcher = d->currentSearcher();
+            if ( !searcher ) {
+                QMutexLocker lock( &d->mutex );
+                searcher = d->getIndexSearcher();
+            }
+            lucene::search::Hits* hits = searcher->search( query );
             if ( hits ) {
-                return new QueryHitIteratorBackend( hits, query );
+                return new QueryHitIteratorBackend( hits, query, searcher, limit, offset, minScore );
             }
             else {
                 return Iterator<QueryHit>();
@@ -591,6 +681,36 @@ Soprano::Iterator<Soprano::Index::QueryHit> Soprano::Index::CLuceneIndex::search
 }
 
 
+qint64 Soprano::Index::CLuceneIndex::documentCacheHits() const
+{
+    QMutexLocker lock( &d->mutex );
+    return d->documentCacheHits;
+}
+
+
+qint64 Soprano::Index::CLuceneIndex::documentCacheMisses() const
+{
+    QMutexLocker lock( &d->mutex );
+    return d->documentCacheMisses;
+}
+
+
+qint64 Soprano::Index::CLuceneIndex::documentsWritten() const
+{
+    QMutexLocker lock( &d->mutex );
+    return d->documentsWritten;
+}
+
+
+void Soprano::Index::CLuceneIndex::resetStatistics()
+{
+    QMutexLocker lock( &d->mutex );
+    d->documentCacheHits = 0;
+    d->documentCacheMisses = 0;
+    d->documentsWritten = 0;
+}
+
+
 int Soprano::Index::CLuceneIndex::resourceCount() const
 {
     QMutexLocker lock( &d->mutex );
@@ -639,7 +759,7 @@ double Soprano::Index::CLuceneIndex::getScore( const Soprano::Node& resource, lu
         combinedQuery.add( query, true, false );
 
         // fetch the score when the URI matches the original query
-        lucene::search::TopDocs* docs = static_cast<lucene::search::Searchable*>( d->getIndexSearcher() )->_search( &combinedQuery, 0, 1 );
+        lucene::search::TopDocs* docs = static_cast<lucene::search::Searchable*>( d->getIndexSearcher().data() )->_search( &combinedQuery, 0, 1 );
         double r = -1.0;
         if ( docs->totalHits > 0 ) {
 #ifdef CL_VERSION_19_OR_GREATER
@@ -709,6 +829,7 @@ void Soprano::Index::CLuceneIndex::clear()
                 d->getIndexReader()->deleteDocument( i );
             }
             d->closeReader();
+            d->markCommitted();
         }
         catch( CLuceneError& err ) {
             setError( exceptionToError( err ) );
@@ -59,7 +59,9 @@ namespace Soprano {
          * made visible in the public API to provide the possibility for advanced queries
          * and data modifications.
          *
-         * CLuceneIndex is thread-safe.
+         * CLuceneIndex is thread-safe. Searches share one searcher which is only
+         * reopened after a transaction has been committed. Thus, searches never block
+         * on running updates but only see committed data.
          *
          * <b>Data organization</b>
          *
@@ -144,6 +146,42 @@ namespace Soprano {
             int resourceCount() const;
             //@}
 
+            //@{
+            /**
+             * All changes to one resource within a transaction are accumulated in
+             * one cached document which is written exactly once when the transaction
+             * is closed. This is the number of times a change could be applied to
+             * an already cached document.
+             *
+             * \sa documentCacheMisses(), documentsWritten(), resetStatistics()
+             *
+             * \since 2.10
+             */
+            qint64 documentCacheHits() const;
+
+            /**
+             * The number of times a document had to be created or read from
+             * the index since it was not cached in the current transaction yet.
+             *
+             * \since 2.10
+             */
+            qint64 documentCacheMisses() const;
+
+            /**
+             * The number of documents written to the index.
+             *
+             * \since 2.10
+             */
+            qint64 documentsWritten() const;
+
+            /**
+             * Reset the document cache statistics to 0.
+             *
+             * \since 2.10
+             */
+            void resetStatistics();
+            //@}
+
             //@{
             /**
              * Start a new transaction. After calling this method multiple fields and statements may be added to the
@@ -153,6 +191,10 @@ namespace Soprano {
              * Methods such as addStatement will start and close a transaction internally if none has been started
              * before.
              *
+             * Within a transaction all changes to one resource are accumulated and its document is written only once
+             * when closing the transaction. Thus, it is highly recommended to use transactions when adding many
+             * statements.
+             *
              * \return A transaction id that has to be used to close the transaction. This is a safety mechanism to ensure
              * that no other user closes one's transaction. If another transaction has already been started 0 is returned.
              */
@@ -224,6 +266,40 @@ namespace Soprano {
              * \warning The result iterator uses the query object.
              */
             Iterator<QueryHit> search( lucene::search::Query* query );
+
+            /**
+             * Evaluates the given query and only returns a window of the hits.
+             * Hits are sorted by descending score. Use this method to fetch the top \p limit
+             * hits without loading the documents of all matching resources.
+             *
+             * \param query The query in the CLucene query language.
+             * \param limit The maximum number of hits to return. A negative value means no limit.
+             * \param offset The number of top hits to skip, used for paging.
+             * \param minScore Hits with a score below \p minScore are not returned.
+             *
+             * \return The results as an iterator over QueryHit objects or an invalid iterator
+             * on error.
+             *
+             * \since 2.10
+             */
+            Iterator<QueryHit> search( const QString& query, int limit, int offset = 0, double minScore = 0.0 );
+
+            /**
+             * Evaluates the given query and only returns a window of the hits.
+             *
+             * \param query The query to evaluate. The iterator takes ownership of the query.
+             * \param limit The maximum number of hits to return. A negative value means no limit.
+             * \param offset The number of top hits to skip, used for paging.
+             * \param minScore Hits with a score below \p minScore are not returned.
+             *
+             * \return The results as an iterator over QueryHit objects or an invalid iterator
+             * on error.
+             *
+             * \sa search( const QString&, int, int, double )
+             *
+             * \since 2.10
+             */
+            Iterator<QueryHit> search( lucene::search::Query* query, int limit, int offset = 0, double minScore = 0.0 );
             //@}
 
 #if 0
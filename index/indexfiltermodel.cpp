@@ -22,7 +22,9 @@
 #include "indexfiltermodel.h"
 #include "indexfiltermodel_p.h"
 #include "cluceneindex.h"
+#include "indexqueue.h"
 #include "queryhitwrapperresultiteratorbackend.h"
+#include "queryhitjoinresultiteratorbackend.h"
 #include "queryresultiterator.h"
 #include "statementiterator.h"
 #include "qurlhash.h"
@@ -31,16 +33,89 @@
 
 #include <QtCore/QThread>
 #include <QtCore/QSet>
+#include <QtCore/QStringList>
 #include <QtCore/QRegExp>
+#include <QtCore/QMutexLocker>
 #include <QtCore/QDebug>
 
 
+namespace {
+    // the number of statements written in one transaction when rebuilding the index
+    const int s_rebuildBatchSize = 10000;
+
+    // rebuilding always fills complete batches, there is no reason to write them early
+    const int s_rebuildMaxDelay = 60*1000;
+
+    // the number of statements after which progress is reported and cancellation is checked
+    const int s_rebuildProgressInterval = 1000;
+
+    class LuceneQueryOptions
+    {
+    public:
+        LuceneQueryOptions()
+            : limit( -1 ),
+              offset( 0 ),
+              minScore( 0.0 ) {
+        }
+
+        int limit;
+        int offset;
+        double minScore;
+    };
+
+    /**
+     * Parses the user query language of lucene queries. The language is "lucene"
+     * optionally followed by options: "lucene?limit=20&offset=40&minScore=0.5".
+     *
+     * \return \p false if \p userQueryLanguage is not a lucene query language. An
+     * invalid option results in an error in \p error.
+     */
+    bool parseLuceneQueryLanguage( const QString& userQueryLanguage, LuceneQueryOptions& options, Soprano::Error::Error& error )
+    {
+        const int pos = userQueryLanguage.indexOf( QLatin1Char( '?' ) );
+        if ( userQueryLanguage.left( pos ).toLower() != QLatin1String( "lucene" ) ) {
+            return false;
+        }
+
+        if ( pos >= 0 ) {
+            const QStringList optionList = userQueryLanguage.mid( pos+1 ).split( QLatin1Char( '&' ), QString::SkipEmptyParts );
+            foreach( const QString& option, optionList ) {
+                const QString name = option.section( QLatin1Char( '=' ), 0, 0 ).toLower();
+                const QString value = option.section( QLatin1Char( '=' ), 1 );
+                bool ok = false;
+                if ( name == QLatin1String( "limit" ) ) {
+                    options.limit = value.toInt( &ok );
+                }
+                else if ( name == QLatin1String( "offset" ) ) {
+                    options.offset = value.toInt( &ok );
+                    ok = ok && options.offset >= 0;
+                }
+                else if ( name == QLatin1String( "minscore" ) ) {
+                    options.minScore = value.toDouble( &ok );
+                }
+                if ( !ok ) {
+                    error = Soprano::Error::Error( QString( "Invalid lucene query option: '%1'" ).arg( option ),
+                                                   Soprano::Error::ErrorInvalidArgument );
+                    return true;
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+
 Soprano::Index::IndexFilterModelPrivate::IndexFilterModelPrivate()
     : deleteIndex( false ),
       index( 0 ),
       transactionCacheSize( 1 ),
       transactionCacheId( 0 ),
-      transactionCacheCount( 0 )
+      transactionCacheCount( 0 ),
+      indexQueue( 0 ),
+      indexQueueBatchSize( 1000 ),
+      indexQueueMaxDelay( 1000 ),
+      rebuildCancelled( false )
 {
 }
 
@@ -66,6 +141,49 @@ void Soprano::Index::IndexFilterModelPrivate::closeTransaction()
 }
 
 
+Soprano::Error::ErrorCode Soprano::Index::IndexFilterModelPrivate::addToIndex( const Statement& statement )
+{
+    if ( indexQueue ) {
+        indexQueue->enqueueAdd( statement );
+        return Error::ErrorNone;
+    }
+    else {
+        startTransaction();
+        Error::ErrorCode c = index->addStatement( statement );
+        closeTransaction();
+        return c;
+    }
+}
+
+
+Soprano::Error::ErrorCode Soprano::Index::IndexFilterModelPrivate::removeFromIndex( const Statement& statement )
+{
+    if ( indexQueue ) {
+        indexQueue->enqueueRemove( statement );
+        return Error::ErrorNone;
+    }
+    else {
+        startTransaction();
+        Error::ErrorCode c = index->removeStatement( statement );
+        closeTransaction();
+        return c;
+    }
+}
+
+
+Soprano::Error::Error Soprano::Index::IndexFilterModelPrivate::flush()
+{
+    if ( indexQueue ) {
+        return indexQueue->flush();
+    }
+    else {
+        transactionCacheCount = transactionCacheSize;
+        closeTransaction();
+        return index->lastError();
+    }
+}
+
+
 bool Soprano::Index::IndexFilterModelPrivate::storeStatement( const Statement& statement ) const
 {
     return !indexOnlyPredicates.contains( statement.predicate().uri() );
@@ -101,6 +219,8 @@ Soprano::Index::IndexFilterModel::IndexFilterModel( CLuceneIndex* index, Soprano
 
 Soprano::Index::IndexFilterModel::~IndexFilterModel()
 {
+    // write back everything still queued before the index goes away
+    delete d->indexQueue;
     if ( d->deleteIndex ) {
         delete d->index;
     }
@@ -130,9 +250,7 @@ Soprano::Error::ErrorCode Soprano::Index::IndexFilterModel::addStatement( const
         bool index = d->indexStatement( statement );
 
         if ( c == Error::ErrorNone && index ) {
-            d->startTransaction();
-            c = d->index->addStatement( statement );
-            d->closeTransaction();
+            c = d->addToIndex( statement );
             if ( c != Error::ErrorNone ) {
                 setError( d->index->lastError() );
             }
@@ -153,9 +271,7 @@ Soprano::Error::ErrorCode Soprano::Index::IndexFilterModel::removeStatement( con
     Error::ErrorCode c = FilterModel::removeStatement( statement );
     if ( c == Error::ErrorNone &&
          d->indexStatement( statement ) ) {
-        d->startTransaction();
-        c = d->index->removeStatement( statement );
-        d->closeTransaction();
+        c = d->removeFromIndex( statement );
         if ( c != Error::ErrorNone ) {
             setError( d->index->lastError() );
         }
@@ -176,9 +292,7 @@ Soprano::Error::ErrorCode Soprano::Index::IndexFilterModel::removeAllStatements(
     while ( it.next() ) {
         Statement s = *it;
         if ( d->indexStatement( s ) ) {
-            d->startTransaction();
-            Error::ErrorCode c = d->index->removeStatement( *it );
-            d->closeTransaction();
+            Error::ErrorCode c = d->removeFromIndex( s );
             if ( c != Error::ErrorNone ) {
                 setError( d->index->lastError() );
                 return c;
@@ -193,14 +307,17 @@ Soprano::Error::ErrorCode Soprano::Index::IndexFilterModel::removeAllStatements(
 
 Soprano::QueryResultIterator Soprano::Index::IndexFilterModel::executeQuery( const QString& query, Query::QueryLanguage language, const QString& userQueryLanguage ) const
 {
-    if ( language == Query::QueryLanguageUser && userQueryLanguage.toLower() == "lucene" ) {
-
-        // commit any changes in the index
-        d->transactionCacheCount = d->transactionCacheSize;
-        d->closeTransaction();
+    LuceneQueryOptions options;
+    Error::Error error;
+    if ( language == Query::QueryLanguageUser && parseLuceneQueryLanguage( userQueryLanguage, options, error ) ) {
+        if ( error ) {
+            setError( error );
+            return 0;
+        }
 
+        // the index only searches committed data, callers use flushIndex() to search pending changes
         clearError();
-        Iterator<QueryHit> res = index()->search( query );
+        Iterator<QueryHit> res = index()->search( query, options.limit, options.offset, options.minScore );
         if ( !res.isValid() ) {
             setError( index()->lastError() );
             return 0;
@@ -215,6 +332,31 @@ Soprano::QueryResultIterator Soprano::Index::IndexFilterModel::executeQuery( con
 }
 
 
+Soprano::QueryResultIterator Soprano::Index::IndexFilterModel::executeFullTextQuery( const QString& query,
+                                                                                    const Statement& pattern,
+                                                                                    int limit,
+                                                                                    int offset,
+                                                                                    double minScore ) const
+{
+    Q_ASSERT( parentModel() );
+
+    if ( pattern.subject().isValid() ) {
+        setError( "The subject of a full text query pattern has to be empty.", Error::ErrorInvalidArgument );
+        return 0;
+    }
+
+    clearError();
+    Iterator<QueryHit> res = index()->search( query, -1, 0, minScore );
+    if ( !res.isValid() ) {
+        setError( index()->lastError() );
+        return 0;
+    }
+    else {
+        return new QueryHitJoinResultIteratorBackend( res, parentModel(), pattern, limit, offset );
+    }
+}
+
+
 void Soprano::Index::IndexFilterModel::setTransactionCacheSize( int size )
 {
     d->transactionCacheSize = qMax( 1, size );
@@ -228,39 +370,147 @@ int Soprano::Index::IndexFilterModel::transactionCacheSize() const
 }
 
 
+void Soprano::Index::IndexFilterModel::setAsynchronousIndexing( bool enable )
+{
+    if ( enable && !d->indexQueue ) {
+        // write back the transaction cache, from now on the queue handles transactions
+        d->transactionCacheCount = d->transactionCacheSize;
+        d->closeTransaction();
+
+        d->indexQueue = new IndexQueue( d->index );
+        d->indexQueue->setBatchSize( d->indexQueueBatchSize );
+        d->indexQueue->setMaxDelay( d->indexQueueMaxDelay );
+    }
+    else if ( !enable && d->indexQueue ) {
+        IndexQueue* queue = d->indexQueue;
+        d->indexQueue = 0;
+        queue->stop();
+        delete queue;
+    }
+}
+
+
+bool Soprano::Index::IndexFilterModel::asynchronousIndexing() const
+{
+    return d->indexQueue != 0;
+}
+
+
+void Soprano::Index::IndexFilterModel::setIndexQueueBatchSize( int size )
+{
+    d->indexQueueBatchSize = qMax( 1, size );
+    if ( d->indexQueue ) {
+        d->indexQueue->setBatchSize( d->indexQueueBatchSize );
+    }
+}
+
+
+int Soprano::Index::IndexFilterModel::indexQueueBatchSize() const
+{
+    return d->indexQueueBatchSize;
+}
+
+
+void Soprano::Index::IndexFilterModel::setIndexQueueMaxDelay( int msecs )
+{
+    d->indexQueueMaxDelay = qMax( 0, msecs );
+    if ( d->indexQueue ) {
+        d->indexQueue->setMaxDelay( d->indexQueueMaxDelay );
+    }
+}
+
+
+int Soprano::Index::IndexFilterModel::indexQueueMaxDelay() const
+{
+    return d->indexQueueMaxDelay;
+}
+
+
+Soprano::Error::ErrorCode Soprano::Index::IndexFilterModel::flushIndex()
+{
+    Error::Error error = d->flush();
+    setError( error );
+    return Error::convertErrorCode( error.code() );
+}
+
+
 void Soprano::Index::IndexFilterModel::rebuildIndex()
 {
-    d->closeTransaction();
+    rebuildIndex( 0 );
+}
+
+
+qint64 Soprano::Index::IndexFilterModel::rebuildIndex( qint64 position )
+{
+    d->flush();
+
+    d->rebuildMutex.lock();
+    d->rebuildCancelled = false;
+    d->rebuildMutex.unlock();
 
     // clear the index
     // -----------------------------
-    d->index->clear();
+    if ( position <= 0 ) {
+        position = 0;
+        d->index->clear();
+    }
 
     // rebuild the index
     // -----------------------------
 
-    // select all resources
-    QueryResultIterator it = FilterModel::executeQuery( "select distinct ?r where { ?r ?p ?o . }",
-                                                        Query::QueryLanguageSparql );
+    // The statements are read in one scan of the parent model in this thread while
+    // the index is written in large transactions by the queue's thread. Statements of
+    // one resource end up in one document per transaction. If a resource spans more
+    // than one transaction CLuceneIndex merges it with the already stored document.
+    IndexQueue queue( d->index );
+    queue.setBatchSize( s_rebuildBatchSize );
+    queue.setMaxDelay( s_rebuildMaxDelay );
+
+    // not all models know their size
+    qint64 total = FilterModel::statementCount();
+    if ( total < 0 ) {
+        total = -1;
+    }
 
+    qint64 current = 0;
+    StatementIterator it = FilterModel::listStatements( Statement() );
     while ( it.next() ) {
-        int id = d->index->startTransaction();
-        Node res = it.binding( "r" );
-
-        // and re-add all the literal statements and those in forceIndexPredicates (we can safely ignore the context here)
-        QStringList filters("(isLiteral(?o) && str(?o)!='')");
-        foreach( const QUrl& p, d->forceIndexPredicates ) {
-            filters << QString("?p = %1").arg(Soprano::Node(p).toN3());
+        // skip the statements handled in a previous run
+        if ( ++current <= position ) {
+            continue;
         }
-        QueryResultIterator it2 = FilterModel::executeQuery( QString( "select distinct ?p ?o where { %1 ?p ?o . FILTER(%2) . }" )
-                                                             .arg( res.toN3(), filters.join( " || " ) ),
-                                                             Query::QueryLanguageSparql );
-        while ( it2.next() ) {
-            d->index->addStatement( Statement( res, it2.binding( "p" ), it2.binding( "o" ) ) );
+
+        // re-add all the literal statements and those in forceIndexPredicates (we can safely ignore the context here)
+        const Statement s = *it;
+        if ( d->indexStatement( s ) ) {
+            queue.enqueueAdd( Statement( s.subject(), s.predicate(), s.object() ) );
         }
 
-        d->index->closeTransaction( id );
+        if ( current % s_rebuildProgressInterval == 0 ) {
+            emit indexRebuildProgress( current, total >= 0 ? qMax( current, total ) : total );
+
+            QMutexLocker lock( &d->rebuildMutex );
+            if ( d->rebuildCancelled ) {
+                break;
+            }
+        }
     }
+    it.close();
+
+    Error::Error error = queue.flush();
+    queue.stop();
+
+    emit indexRebuildProgress( current, total >= 0 ? qMax( current, total ) : total );
+
+    setError( error );
+    return current;
+}
+
+
+void Soprano::Index::IndexFilterModel::cancelIndexRebuild()
+{
+    QMutexLocker lock( &d->rebuildMutex );
+    d->rebuildCancelled = true;
 }
 
 
@@ -303,6 +553,7 @@ QList<QUrl> Soprano::Index::IndexFilterModel::forceIndexPredicates() const
 
 void Soprano::Index::IndexFilterModel::optimizeIndex()
 {
+    d->flush();
     d->index->optimize();
 }
 
@@ -322,3 +573,5 @@ QString Soprano::Index::IndexFilterModel::encodeUriForLuceneQuery( const QUrl& u
 {
     return encodeStringForLuceneQuery( QString::fromLatin1( uri.toEncoded() ) );
 }
+
+#include "moc_indexfiltermodel.cpp"
@@ -40,6 +40,8 @@ namespace Soprano {
      * In a future version of %Soprano the index will be integrated into the query API,
      * allowing for fast full text queries in combination with standard RDF queries.
      * At the moment these have to be done separately (see IndexFilterModel::executeQuery()).
+     * Simple combinations of full text queries and graph patterns are supported through
+     * IndexFilterModel::executeFullTextQuery().
      */
     namespace Index {
 
@@ -60,6 +62,8 @@ namespace Soprano {
          */
         class SOPRANO_INDEX_EXPORT IndexFilterModel : public Soprano::FilterModel
         {
+            Q_OBJECT
+
         public:
             /**
              * Create a new index model.
@@ -131,16 +135,59 @@ namespace Soprano {
              *                 CLucene queries.
              * \param userQueryLanguage If \p language equals Query::QueryLanguageUser
              *                          userQueryLanguage defines the language to use. Use <b>"lucene"</b>
-             *                          to perform CLucene queries.
+             *                          to perform CLucene queries. The hits can be restricted by appending
+             *                          options to the language name:
+             *                          <b>"lucene?limit=20&offset=40&minScore=0.5"</b> returns at most 20
+             *                          hits, skips the 40 best hits, and ignores hits scoring below 0.5
+             *                          (see CLuceneIndex::search( const QString&, int, int, double )).
+             *                          Options are supported since %Soprano 2.10.
              *
              * \return An iterator over all results matching the query, 
              * on error an invalid iterator is returned. In case of a CLucene query the iterator will
              * wrap a set of QueryHit objects through the bindings <b>"resource"</b> and <b>"score"</b>.
              *
+             * CLucene queries only see committed data, i.e. they do not include changes still cached
+             * in a transaction (setTransactionCacheSize()) or queued for asynchronous indexing
+             * (setAsynchronousIndexing()). Call flushIndex() before if this is required. That way
+             * searching never has to wait for running index updates.
+             *
              * \sa CLuceneIndex::search()
              */
             QueryResultIterator executeQuery( const QString& query, Query::QueryLanguage language, const QString& userQueryLanguage = QString() ) const;
 
+            /**
+             * Combine a full text query with a graph pattern. Only those hits of the CLucene
+             * \p query are returned for which the parent model contains a statement matching
+             * \p pattern with the hit resource as subject. A typical example is restricting the
+             * hits to resources of a certain type:
+             *
+             * \code
+             * model->executeFullTextQuery( "hello", Statement( Node(), Vocabulary::RDF::type(), someType ), 20 );
+             * \endcode
+             *
+             * The hits are joined against the parent model in batches. This is much faster than
+             * checking each hit of executeQuery() separately, especially through Soprano::Client.
+             *
+             * \param query The query in the CLucene query language.
+             * \param pattern The pattern the hit resources have to match. The subject has to be empty,
+             *                it is replaced with each hit resource. All other empty nodes act as wildcards.
+             * \param limit The maximum number of results. A negative value means no limit.
+             * \param offset The number of matching hits to skip, used for paging.
+             * \param minScore Hits with a score below \p minScore are ignored.
+             *
+             * \return An iterator over the matching hits sorted by score with the bindings <b>"resource"</b>
+             * and <b>"score"</b> or an invalid iterator on error.
+             *
+             * \sa executeQuery()
+             *
+             * \since 2.10
+             */
+            QueryResultIterator executeFullTextQuery( const QString& query,
+                                                      const Statement& pattern,
+                                                      int limit = -1,
+                                                      int offset = 0,
+                                                      double minScore = 0.0 ) const;
+
             /*
              * Extract full text matching parts of a %query and replace them with
              * results from an index %query.
@@ -154,8 +201,8 @@ namespace Soprano {
 
             /**
              * Set the number or addStatement operations that are to be cached in the index.
-             * The default value is 1 which means that no caching occurs. Be aware that query
-             * operations will always close cached transactions.
+             * The default value is 1 which means that no caching occurs. Be aware that lucene
+             * queries only see committed data. Use flushIndex() to close cached transactions.
              *
              * \param size The number of operations that should be handled in one transaction.
              * Set to 1 to disable.
@@ -171,16 +218,131 @@ namespace Soprano {
              */
             int transactionCacheSize() const;
 
+            /**
+             * Enable or disable asynchronous indexing. If enabled, all index updates are
+             * queued and written to the index by a background thread in large transactions.
+             * Thus, adding statements does not block on CLucene I/O anymore.
+             *
+             * A transaction is written once it contains indexQueueBatchSize() updates or
+             * the oldest update has been queued for indexQueueMaxDelay() milliseconds.
+             *
+             * rebuildIndex() and optimizeIndex() always wait for the queue to be written.
+             * Lucene queries only see data that has already been written. Use flushIndex()
+             * to wait for the queue explicitly. Disabling asynchronous indexing
+             * also writes all queued updates.
+             *
+             * By default asynchronous indexing is disabled.
+             *
+             * \warning While asynchronous indexing is enabled the indexing thread uses
+             * CLuceneIndex transactions. Do not start transactions on index() manually.
+             *
+             * \sa setTransactionCacheSize
+             *
+             * \since 2.10
+             */
+            void setAsynchronousIndexing( bool enable );
+
+            /**
+             * \return \p true if asynchronous indexing is enabled.
+             *
+             * \sa setAsynchronousIndexing
+             *
+             * \since 2.10
+             */
+            bool asynchronousIndexing() const;
+
+            /**
+             * Set the maximum number of index updates written in one transaction
+             * if asynchronous indexing is enabled. The default is 1000.
+             *
+             * \sa setAsynchronousIndexing
+             *
+             * \since 2.10
+             */
+            void setIndexQueueBatchSize( int size );
+
+            /**
+             * \sa setIndexQueueBatchSize
+             *
+             * \since 2.10
+             */
+            int indexQueueBatchSize() const;
+
+            /**
+             * Set the maximum time in milliseconds a queued index update may wait
+             * before it is written if asynchronous indexing is enabled. The default
+             * is 1000.
+             *
+             * \sa setAsynchronousIndexing
+             *
+             * \since 2.10
+             */
+            void setIndexQueueMaxDelay( int msecs );
+
+            /**
+             * \sa setIndexQueueMaxDelay
+             *
+             * \since 2.10
+             */
+            int indexQueueMaxDelay() const;
+
+            /**
+             * Write all pending index updates, i.e. the queued ones if asynchronous
+             * indexing is enabled or the cached transaction otherwise. Blocks until
+             * the data has been written.
+             *
+             * \return Error::ErrorNone on success. If asynchronous indexing is enabled
+             * the last error that occurred in the indexing thread since the last
+             * flush is reported.
+             *
+             * \since 2.10
+             */
+            Soprano::Error::ErrorCode flushIndex();
+
             /**
              * Rebuild the complete index. This means that the index will be cleared and all 
              * literal statements will be re-indexed.
              *
              * This method is purely intended for maintenance.
              *
+             * \sa rebuildIndex(qint64)
+             *
              * \since 2.1
              */
             void rebuildIndex();
 
+            /**
+             * Rebuild the index starting at \p position. The parent model is read in one
+             * scan while the index is written in large transactions in a separate thread.
+             * Progress is reported through indexRebuildProgress().
+             *
+             * \param position The number of statements of the parent model's statement
+             * listing to skip. If 0 the index is cleared and rebuilt from scratch. Otherwise
+             * this should be the value returned by a previous, cancelled call.
+             *
+             * \warning Resuming relies on the parent model listing its statements in the same
+             * order as before. This is only the case if the parent model has not been changed
+             * since the cancelled call. Otherwise statements might be skipped. Rebuild from
+             * position 0 if the model might have changed.
+             *
+             * \return The number of statements which have been handled. All of them have
+             * been written to the index when this method returns.
+             *
+             * \sa cancelIndexRebuild()
+             *
+             * \since 2.10
+             */
+            qint64 rebuildIndex( qint64 position );
+
+            /**
+             * Cancel a running rebuildIndex() call, either from another thread or from a
+             * slot directly connected to indexRebuildProgress(). rebuildIndex() will write
+             * what has been read so far and return the position to resume at.
+             *
+             * \since 2.10
+             */
+            void cancelIndexRebuild();
+
             /**
              * Optimize the index for search. This makes sense after adding or
              * removing a large number of statements.
@@ -332,6 +494,18 @@ namespace Soprano {
             using FilterModel::removeStatement;
             using FilterModel::removeAllStatements;
 
+        Q_SIGNALS:
+            /**
+             * Emitted regularly by rebuildIndex().
+             *
+             * \param position The number of statements of the parent model read so far.
+             * \param total The number of statements in the parent model or -1 if the parent
+             * model cannot tell (Model::statementCount() failed). Progress is unknown then.
+             *
+             * \since 2.10
+             */
+            void indexRebuildProgress( qint64 position, qint64 total );
+
         private:
             IndexFilterModelPrivate* const d;
         };
@@ -23,11 +23,16 @@
 #define _SOPRANO_INDEX_FILTER_MODEL_PRIVATE_H_
 
 #include <QtCore/QSet>
+#include <QtCore/QMutex>
 #include "qurlhash.h"
 #include "statement.h"
+#include "error.h"
 
 namespace Soprano {
     namespace Index {
+        class CLuceneIndex;
+        class IndexQueue;
+
         class IndexFilterModelPrivate
         {
         public:
@@ -42,10 +47,30 @@ namespace Soprano {
             int transactionCacheSize;
             int transactionCacheId;
             int transactionCacheCount;
-            
+
+            // only set if asynchronous indexing is enabled
+            IndexQueue* indexQueue;
+            int indexQueueBatchSize;
+            int indexQueueMaxDelay;
+
+            QMutex rebuildMutex;
+            bool rebuildCancelled;
+
             void startTransaction();
             void closeTransaction();
 
+            /**
+             * Add or remove a statement to/from the index, either directly
+             * or through the indexQueue.
+             */
+            Error::ErrorCode addToIndex( const Statement& s );
+            Error::ErrorCode removeFromIndex( const Statement& s );
+
+            /**
+             * Make sure all changes are written to the index.
+             */
+            Error::Error flush();
+
             bool storeStatement( const Statement& s ) const;
             bool indexStatement( const Statement& s ) const;
         };
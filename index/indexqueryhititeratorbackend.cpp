@@ -32,11 +32,21 @@
 
 // FIXME: is it possible to use the stupid CLucene ref counting for the query here?
 Soprano::Index::QueryHitIteratorBackend::QueryHitIteratorBackend( lucene::search::Hits* hits,
-                                                                  lucene::search::Query* query )
+                                                                  lucene::search::Query* query,
+                                                                  const QSharedPointer<lucene::search::Searcher>& searcher,
+                                                                  int limit,
+                                                                  int offset,
+                                                                  double minScore )
     : m_hits( hits ),
       m_query( query ),
-      m_currentDocId( -1 )
+      m_searcher( searcher ),
+      m_currentDocId( qMax( 0, offset ) - 1 ),
+      m_endDocId( hits->length() ),
+      m_minScore( minScore )
 {
+    if ( limit >= 0 ) {
+        m_endDocId = qMin( m_endDocId, qMax( 0, offset ) + limit );
+    }
 }
 
 
@@ -50,7 +60,15 @@ bool Soprano::Index::QueryHitIteratorBackend::next()
 {
     if ( m_hits ) {
         ++m_currentDocId;
-        return m_currentDocId < m_hits->length();
+        if ( m_currentDocId >= m_endDocId ) {
+            return false;
+        }
+        // hits are sorted by score, all remaining ones would be below the minimum as well
+        if ( m_minScore > 0.0 && m_hits->score( m_currentDocId ) < m_minScore ) {
+            m_endDocId = m_currentDocId;
+            return false;
+        }
+        return true;
     }
     else {
         setError( "Invalid iterator" );
@@ -74,7 +92,7 @@ namespace {
 Soprano::Index::QueryHit Soprano::Index::QueryHitIteratorBackend::current() const
 {
     if ( m_hits ) {
-        if ( m_currentDocId < m_hits->length() ) {
+        if ( m_currentDocId >= 0 && m_currentDocId < m_endDocId ) {
             clearError();
             lucene::document::Document& doc = m_hits->doc( m_currentDocId );
             QueryHit res( getResource( &doc ), m_hits->score( m_currentDocId ) );
@@ -101,4 +119,6 @@ void Soprano::Index::QueryHitIteratorBackend::close()
         _CLDELETE( m_query );
         m_query = 0;
     }
+    // the searcher is closed once it has been replaced and no iterator uses it anymore
+    m_searcher.clear();
 }
@@ -25,10 +25,13 @@
 #include "../soprano/iteratorbackend.h"
 #include "indexqueryhit.h"
 
+#include <QtCore/QSharedPointer>
+
 namespace lucene {
     namespace search {
         class Hits;
         class Query;
+        class Searcher;
     }
 }
 
@@ -37,7 +40,21 @@ namespace Soprano {
         class QueryHitIteratorBackend : public IteratorBackend<QueryHit>
         {
         public:
-            QueryHitIteratorBackend( lucene::search::Hits* hits, lucene::search::Query* query );
+            /**
+             * The iterator takes ownership of \p hits and \p query and keeps
+             * \p searcher alive until it is closed.
+             *
+             * Only the hits starting at \p offset are returned. The iterator stops after
+             * \p limit hits (a negative value means no limit) or at the first hit scoring
+             * below \p minScore. Lucene hits are sorted by score which means that documents
+             * after the requested window are never loaded.
+             */
+            QueryHitIteratorBackend( lucene::search::Hits* hits,
+                                     lucene::search::Query* query,
+                                     const QSharedPointer<lucene::search::Searcher>& searcher,
+                                     int limit = -1,
+                                     int offset = 0,
+                                     double minScore = 0.0 );
             ~QueryHitIteratorBackend();
 
             bool next();
@@ -47,7 +64,10 @@ namespace Soprano {
         private:
             lucene::search::Hits* m_hits;
             lucene::search::Query* m_query;
+            QSharedPointer<lucene::search::Searcher> m_searcher;
             qint32 m_currentDocId;
+            qint32 m_endDocId;
+            double m_minScore;
         };
     }
 }
@@ -0,0 +1,225 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "indexqueue.h"
+#include "cluceneindex.h"
+
+#include <QtCore/QMutexLocker>
+#include <QtCore/QTime>
+#include <QtCore/QDebug>
+
+
+namespace {
+    // writers are blocked once the queue contains this many batches
+    const int s_maxQueuedBatches = 10;
+}
+
+
+Soprano::Index::IndexQueue::IndexQueue( CLuceneIndex* index )
+    : QThread(),
+      m_index( index ),
+      m_batchSize( 1000 ),
+      m_maxDelay( 1000 ),
+      m_stopped( false ),
+      m_enqueued( 0 ),
+      m_written( 0 ),
+      m_flushTarget( 0 )
+{
+}
+
+
+Soprano::Index::IndexQueue::~IndexQueue()
+{
+    stop();
+}
+
+
+void Soprano::Index::IndexQueue::setBatchSize( int size )
+{
+    QMutexLocker lock( &m_mutex );
+    m_batchSize = qMax( 1, size );
+    m_workAvailable.wakeAll();
+}
+
+
+int Soprano::Index::IndexQueue::batchSize() const
+{
+    QMutexLocker lock( &m_mutex );
+    return m_batchSize;
+}
+
+
+void Soprano::Index::IndexQueue::setMaxDelay( int msecs )
+{
+    QMutexLocker lock( &m_mutex );
+    m_maxDelay = qMax( 0, msecs );
+    m_workAvailable.wakeAll();
+}
+
+
+int Soprano::Index::IndexQueue::maxDelay() const
+{
+    QMutexLocker lock( &m_mutex );
+    return m_maxDelay;
+}
+
+
+void Soprano::Index::IndexQueue::enqueueAdd( const Statement& statement )
+{
+    enqueue( statement, true );
+}
+
+
+void Soprano::Index::IndexQueue::enqueueRemove( const Statement& statement )
+{
+    enqueue( statement, false );
+}
+
+
+void Soprano::Index::IndexQueue::enqueue( const Statement& statement, bool add )
+{
+    QMutexLocker lock( &m_mutex );
+
+    if ( m_stopped || !isRunning() ) {
+        // make sure a previously stopped indexing thread has finished before restarting it
+        lock.unlock();
+        wait();
+        lock.relock();
+        if ( !isRunning() ) {
+            m_stopped = false;
+            start();
+        }
+    }
+
+    // do not let the queue grow without bounds if the indexer cannot keep up
+    while ( m_queue.count() >= s_maxQueuedBatches*m_batchSize ) {
+        m_queueDrained.wait( &m_mutex );
+    }
+
+    m_queue.append( qMakePair( statement, add ) );
+    ++m_enqueued;
+    if ( m_queue.count() >= m_batchSize ) {
+        m_workAvailable.wakeAll();
+    }
+    else if ( m_queue.count() == 1 ) {
+        // start the delay timer
+        m_workAvailable.wakeAll();
+    }
+}
+
+
+Soprano::Error::Error Soprano::Index::IndexQueue::flush()
+{
+    QMutexLocker lock( &m_mutex );
+
+    // only wait for what has been queued so far, otherwise continuous
+    // updates from other threads could keep us waiting forever
+    const qint64 target = m_enqueued;
+    if ( m_written < target ) {
+        m_flushTarget = qMax( m_flushTarget, target );
+        m_workAvailable.wakeAll();
+        while ( m_written < target ) {
+            m_queueDrained.wait( &m_mutex );
+        }
+    }
+
+    Error::Error error = m_lastError;
+    m_lastError = Error::Error();
+    return error;
+}
+
+
+void Soprano::Index::IndexQueue::stop()
+{
+    m_mutex.lock();
+    m_stopped = true;
+    m_workAvailable.wakeAll();
+    m_mutex.unlock();
+
+    wait();
+}
+
+
+void Soprano::Index::IndexQueue::run()
+{
+    QMutexLocker lock( &m_mutex );
+
+    while ( 1 ) {
+        while ( m_queue.isEmpty() && !m_stopped ) {
+            m_workAvailable.wait( &m_mutex );
+        }
+        if ( m_queue.isEmpty() ) {
+            // stopped and nothing left to write
+            break;
+        }
+
+        // wait for the batch to fill up unless someone is waiting for the data
+        QTime timer;
+        timer.start();
+        while ( m_queue.count() < m_batchSize &&
+                !m_stopped &&
+                m_written >= m_flushTarget ) {
+            const int remaining = m_maxDelay - timer.elapsed();
+            if ( remaining <= 0 ) {
+                break;
+            }
+            m_workAvailable.wait( &m_mutex, remaining );
+        }
+
+        // never write more than one batch per transaction, the queue may hold several
+        QList<QPair<Statement, bool> > batch = m_queue.mid( 0, m_batchSize );
+        m_queue.erase( m_queue.begin(), m_queue.begin() + batch.count() );
+        m_queueDrained.wakeAll();
+
+        lock.unlock();
+        applyBatch( batch );
+        lock.relock();
+
+        m_written += batch.count();
+        m_queueDrained.wakeAll();
+    }
+}
+
+
+void Soprano::Index::IndexQueue::applyBatch( const QList<QPair<Statement, bool> >& batch )
+{
+    // if the transaction cannot be started every statement is committed separately
+    // which is slow but correct
+    int id = m_index->startTransaction();
+
+    for ( QList<QPair<Statement, bool> >::const_iterator it = batch.constBegin();
+          it != batch.constEnd(); ++it ) {
+        Error::ErrorCode c = it->second
+                             ? m_index->addStatement( it->first )
+                             : m_index->removeStatement( it->first );
+        if ( c != Error::ErrorNone ) {
+            qDebug() << "(Soprano::Index::IndexQueue) failed to update index:" << m_index->lastError();
+            QMutexLocker lock( &m_mutex );
+            m_lastError = m_index->lastError();
+        }
+    }
+
+    if ( id && !m_index->closeTransaction( id ) ) {
+        qDebug() << "(Soprano::Index::IndexQueue) failed to commit index transaction:" << m_index->lastError();
+        QMutexLocker lock( &m_mutex );
+        m_lastError = m_index->lastError();
+    }
+}
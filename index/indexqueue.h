@@ -0,0 +1,123 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _SOPRANO_INDEX_QUEUE_H_
+#define _SOPRANO_INDEX_QUEUE_H_
+
+#include <QtCore/QThread>
+#include <QtCore/QMutex>
+#include <QtCore/QWaitCondition>
+#include <QtCore/QList>
+
+#include "statement.h"
+#include "error.h"
+
+namespace Soprano {
+    namespace Index {
+
+        class CLuceneIndex;
+
+        /**
+         * Buffers index updates and applies them to a CLuceneIndex in a background
+         * thread. The updates are grouped into transactions of at most batchSize()
+         * updates. A transaction is written once it is full or the oldest update
+         * has been waiting for maxDelay() milliseconds.
+         *
+         * Used by IndexFilterModel if asynchronous indexing is enabled.
+         */
+        class IndexQueue : public QThread
+        {
+        public:
+            IndexQueue( CLuceneIndex* index );
+
+            /**
+             * Calls stop()
+             */
+            ~IndexQueue();
+
+            void setBatchSize( int size );
+            int batchSize() const;
+
+            void setMaxDelay( int msecs );
+            int maxDelay() const;
+
+            /**
+             * Queue \p statement to be added to the index. Blocks if the
+             * queue has grown too large for the indexing thread to keep up.
+             */
+            void enqueueAdd( const Statement& statement );
+
+            /**
+             * Queue \p statement to be removed from the index.
+             */
+            void enqueueRemove( const Statement& statement );
+
+            /**
+             * Block until all updates queued before the call have been written to
+             * the index. Updates queued by other threads in the meantime are not
+             * waited for.
+             *
+             * \return The last error that occurred in the indexing thread since
+             * the last call to flush().
+             */
+            Error::Error flush();
+
+            /**
+             * Write all queued updates and stop the indexing thread.
+             */
+            void stop();
+
+        protected:
+            void run();
+
+        private:
+            void enqueue( const Statement& statement, bool add );
+            void applyBatch( const QList<QPair<Statement, bool> >& batch );
+
+            CLuceneIndex* m_index;
+
+            // the queued statements, the flag tells if they should be added (or removed)
+            QList<QPair<Statement, bool> > m_queue;
+
+            int m_batchSize;
+            int m_maxDelay;
+
+            bool m_stopped;
+
+            // The number of updates queued and written so far. flush() waits for the
+            // updates queued before it was called, m_flushTarget being the highest of
+            // those sequence numbers. Batches are written right away while
+            // m_written < m_flushTarget.
+            qint64 m_enqueued;
+            qint64 m_written;
+            qint64 m_flushTarget;
+
+            // we need to cache the error since ErrorCache stores errors per thread
+            Error::Error m_lastError;
+
+            mutable QMutex m_mutex;
+            QWaitCondition m_workAvailable;
+            QWaitCondition m_queueDrained;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,228 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "queryhitjoinresultiteratorbackend.h"
+#include "model.h"
+#include "queryresultiterator.h"
+
+#include <QtCore/QSet>
+
+
+namespace {
+    // the number of hits checked against the model at once
+    const int s_joinBatchSize = 100;
+
+    QString patternNodeToN3( const Soprano::Node& node, const QString& variable )
+    {
+        return node.isValid() ? node.toN3() : variable;
+    }
+
+    // a blank node in a query acts like a variable, it cannot select one specific node
+    bool containsBlankNode( const Soprano::Statement& pattern )
+    {
+        return ( pattern.predicate().isBlank() ||
+                 pattern.object().isBlank() ||
+                 pattern.context().isBlank() );
+    }
+}
+
+
+Soprano::Index::QueryHitJoinResultIteratorBackend::QueryHitJoinResultIteratorBackend( const Iterator<QueryHit>& it,
+                                                                                      const Model* model,
+                                                                                      const Statement& pattern,
+                                                                                      int limit,
+                                                                                      int offset )
+    : QueryResultIteratorBackend(),
+      m_it( it ),
+      m_model( model ),
+      m_pattern( pattern ),
+      m_limit( limit ),
+      m_skip( qMax( 0, offset ) ),
+      m_returned( 0 )
+{
+    m_bindingNameCache += QLatin1String( "resource" );
+    m_bindingNameCache += QLatin1String( "score" );
+}
+
+
+Soprano::Index::QueryHitJoinResultIteratorBackend::~QueryHitJoinResultIteratorBackend()
+{
+}
+
+
+bool Soprano::Index::QueryHitJoinResultIteratorBackend::next()
+{
+    if ( m_limit >= 0 && m_returned >= m_limit ) {
+        return false;
+    }
+
+    while ( true ) {
+        if ( m_buffer.isEmpty() && !fillBuffer() ) {
+            return false;
+        }
+
+        m_current = m_buffer.takeFirst();
+        if ( m_skip > 0 ) {
+            --m_skip;
+        }
+        else {
+            ++m_returned;
+            return true;
+        }
+    }
+}
+
+
+void Soprano::Index::QueryHitJoinResultIteratorBackend::close()
+{
+    m_it.close();
+    m_buffer.clear();
+}
+
+
+Soprano::Node Soprano::Index::QueryHitJoinResultIteratorBackend::binding( const QString &name ) const
+{
+    if ( name == m_bindingNameCache[0] ) {
+        return m_current.resource();
+    }
+    else if ( name == m_bindingNameCache[1] ) {
+        return LiteralValue( m_current.score() );
+    }
+    else {
+        return Node();
+    }
+}
+
+
+Soprano::Node Soprano::Index::QueryHitJoinResultIteratorBackend::binding( int offset ) const
+{
+    switch( offset ) {
+    case 0:
+        return m_current.resource();
+    case 1:
+        return LiteralValue( m_current.score() );
+    default:
+        return Node();
+    }
+}
+
+
+int Soprano::Index::QueryHitJoinResultIteratorBackend::bindingCount() const
+{
+    return m_bindingNameCache.count();
+}
+
+
+QStringList Soprano::Index::QueryHitJoinResultIteratorBackend::bindingNames() const
+{
+    return m_bindingNameCache;
+}
+
+
+bool Soprano::Index::QueryHitJoinResultIteratorBackend::fillBuffer()
+{
+    clearError();
+
+    // batches without any match are skipped until a match is found or the hits are exhausted
+    while ( m_buffer.isEmpty() ) {
+        QList<QueryHit> batch;
+        while ( batch.count() < s_joinBatchSize && m_it.next() ) {
+            batch.append( m_it.current() );
+        }
+        if ( m_it.lastError() ) {
+            setError( m_it.lastError() );
+            return false;
+        }
+        if ( batch.isEmpty() ) {
+            return false;
+        }
+
+        // each batch tries the query again, a failure only affects the batch at hand
+        QSet<Node> matches;
+        bool joined = false;
+        const QString query = buildBatchQuery( batch );
+        if ( !query.isEmpty() ) {
+            QueryResultIterator it = m_model->executeQuery( query, Query::QueryLanguageSparql );
+            if ( it.isValid() ) {
+                while ( it.next() ) {
+                    matches.insert( it.binding( 0 ) );
+                }
+                if ( it.lastError() ) {
+                    setError( it.lastError() );
+                    return false;
+                }
+                joined = true;
+            }
+        }
+
+        foreach( const QueryHit& hit, batch ) {
+            // blank nodes cannot be part of a query and have to be checked separately
+            const bool match = ( joined && !hit.resource().isBlank() )
+                               ? matches.contains( hit.resource() )
+                               : matchesPattern( hit.resource() );
+            if ( match ) {
+                m_buffer.append( hit );
+            }
+        }
+    }
+
+    return true;
+}
+
+
+bool Soprano::Index::QueryHitJoinResultIteratorBackend::matchesPattern( const Node& resource ) const
+{
+    return m_model->containsAnyStatement( resource, m_pattern.predicate(), m_pattern.object(), m_pattern.context() );
+}
+
+
+QString Soprano::Index::QueryHitJoinResultIteratorBackend::buildBatchQuery( const QList<QueryHit>& batch ) const
+{
+    if ( containsBlankNode( m_pattern ) ) {
+        return QString();
+    }
+
+    QStringList terms;
+    foreach( const QueryHit& hit, batch ) {
+        if ( hit.resource().isResource() ) {
+            terms << hit.resource().toN3();
+        }
+    }
+    if ( terms.isEmpty() ) {
+        return QString();
+    }
+
+    QString pattern = QString::fromLatin1( "?r %1 %2 ." )
+                      .arg( patternNodeToN3( m_pattern.predicate(), QLatin1String( "?p" ) ) )
+                      .arg( patternNodeToN3( m_pattern.object(), QLatin1String( "?o" ) ) );
+    if ( m_pattern.context().isValid() ) {
+        pattern = QString::fromLatin1( "graph %1 { %2 }" ).arg( m_pattern.context().toN3() ).arg( pattern );
+    }
+    else {
+        // an empty context matches all graphs in containsAnyStatement, not only the default graph
+        pattern = QString::fromLatin1( "{ %1 } UNION { graph ?g { %1 } }" ).arg( pattern );
+    }
+
+    // VALUES binds ?r up front instead of filtering the full pattern afterwards
+    return QString::fromLatin1( "select distinct ?r where { VALUES ?r { %1 } %2 }" )
+        .arg( terms.join( QLatin1String( " " ) ) )
+        .arg( pattern );
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _QUERYHIT_JOIN_RESULT_ITERATOR_BACKEND_H_
+#define _QUERYHIT_JOIN_RESULT_ITERATOR_BACKEND_H_
+
+#include "queryresultiteratorbackend.h"
+#include "iterator.h"
+#include "indexqueryhit.h"
+#include "statement.h"
+
+#include <QtCore/QList>
+#include <QtCore/QStringList>
+
+namespace Soprano {
+
+    class Model;
+
+    namespace Index {
+        /**
+         * Joins a stream of query hits against a statement pattern in a model.
+         * Only hits for which the model contains a statement matching the pattern
+         * with the hit resource as subject are returned, in the order of the hits.
+         *
+         * The hits are read in batches. Each batch is checked against the model with
+         * a single SPARQL query. If that query fails the hits of the batch are
+         * checked via Model::containsAnyStatement() instead. The same is done for
+         * patterns containing blank nodes since a query cannot express them.
+         */
+        class QueryHitJoinResultIteratorBackend : public QueryResultIteratorBackend
+        {
+        public:
+            QueryHitJoinResultIteratorBackend( const Iterator<QueryHit>& it,
+                                               const Model* model,
+                                               const Statement& pattern,
+                                               int limit = -1,
+                                               int offset = 0 );
+            ~QueryHitJoinResultIteratorBackend();
+
+            bool next();
+            void close();
+
+            Statement currentStatement() const { return Statement(); }
+            Node binding( const QString &name ) const;
+            Node binding( int offset ) const;
+            int bindingCount() const;
+            QStringList bindingNames() const;
+            bool isGraph() const { return false; }
+            bool isBinding() const { return true; }
+            bool isBool() const { return false; }
+            bool boolValue() const { return false; }
+
+        private:
+            bool fillBuffer();
+            bool matchesPattern( const Node& resource ) const;
+            QString buildBatchQuery( const QList<QueryHit>& batch ) const;
+
+            Iterator<QueryHit> m_it;
+            const Model* m_model;
+            Statement m_pattern;
+            int m_limit;
+            int m_skip;
+            int m_returned;
+            QList<QueryHit> m_buffer;
+            QueryHit m_current;
+            QStringList m_bindingNameCache;
+        };
+    }
+}
+
+#endif
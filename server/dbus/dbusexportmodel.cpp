@@ -29,7 +29,17 @@
 class Soprano::Server::DBusExportModel::Private
 {
 public:
+    Private()
+        : changeSignals( StatementSignals ),
+          signalCacheTime( 0 ),
+          maxSignalBatchSize( 1000 ) {
+    }
+
     QString dbusPath;
+
+    ChangeSignals changeSignals;
+    int signalCacheTime;
+    int maxSignalBatchSize;
 };
 
 
@@ -73,4 +83,40 @@ QString Soprano::Server::DBusExportModel::dbusObjectPath() const
     return d->dbusPath;
 }
 
+
+void Soprano::Server::DBusExportModel::setChangeSignals( ChangeSignals flags )
+{
+    d->changeSignals = flags;
+}
+
+
+Soprano::Server::DBusExportModel::ChangeSignals Soprano::Server::DBusExportModel::changeSignals() const
+{
+    return d->changeSignals;
+}
+
+
+void Soprano::Server::DBusExportModel::setSignalCacheTime( int msec )
+{
+    d->signalCacheTime = qMax( 0, msec );
+}
+
+
+int Soprano::Server::DBusExportModel::signalCacheTime() const
+{
+    return d->signalCacheTime;
+}
+
+
+void Soprano::Server::DBusExportModel::setMaxSignalBatchSize( int count )
+{
+    d->maxSignalBatchSize = qMax( 1, count );
+}
+
+
+int Soprano::Server::DBusExportModel::maxSignalBatchSize() const
+{
+    return d->maxSignalBatchSize;
+}
+
 #include "moc_dbusexportmodel.cpp"
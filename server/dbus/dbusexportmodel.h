@@ -50,6 +50,10 @@ namespace Soprano {
          * parent model to create delayed D-Bus replies. If the parent model
          * is not a Util::AsyncModel all calls will be performed syncroneously.
          *
+         * Change notifications of the parent model are coalesced before being
+         * relayed onto the bus (see setSignalCacheTime() and setChangeSignals())
+         * to avoid flooding it when importing large amounts of data.
+         *
          * \author Sebastian Trueg <trueg@kde.org>
          *
          * \sa \ref soprano_server_dbus
@@ -67,6 +71,32 @@ namespace Soprano {
              */
             DBusExportModel( Model* model = 0 );
 
+            /**
+             * The forms in which changes of the parent model are published
+             * on the org.soprano.Model interface.
+             *
+             * \since 2.10
+             */
+            enum ChangeSignal {
+                /**
+                 * One statementAdded or statementRemoved signal per statement.
+                 */
+                StatementSignals = 0x1,
+
+                /**
+                 * statementsAddedBatch and statementsRemovedBatch signals
+                 * carrying all statements changed since the last emission.
+                 */
+                StatementBatchSignals = 0x2,
+
+                /**
+                 * A statementsChanged signal carrying only the number of
+                 * added and removed statements.
+                 */
+                SummarySignals = 0x4
+            };
+            Q_DECLARE_FLAGS( ChangeSignals, ChangeSignal )
+
             /**
              * Destructor.
              */
@@ -90,6 +120,59 @@ namespace Soprano {
              */
             QString dbusObjectPath() const;
 
+            /**
+             * Set the forms in which change notifications are emitted via D-Bus.
+             * The plain statementsAdded and statementsRemoved signals are always emitted.
+             *
+             * Default value is StatementSignals which matches the signals
+             * emitted by earlier versions.
+             *
+             * \since 2.10
+             */
+            void setChangeSignals( ChangeSignals flags );
+
+            /**
+             * \sa setChangeSignals
+             *
+             * \since 2.10
+             */
+            ChangeSignals changeSignals() const;
+
+            /**
+             * Change notifications are collected for \p msec milliseconds
+             * and then emitted at once. A value of 0 relays every notification
+             * immediately.
+             *
+             * Default value is 0.
+             *
+             * \since 2.10
+             */
+            void setSignalCacheTime( int msec );
+
+            /**
+             * \sa setSignalCacheTime
+             *
+             * \since 2.10
+             */
+            int signalCacheTime() const;
+
+            /**
+             * Collected change notifications are emitted as soon as \p count
+             * statements have been added or removed, regardless of the cache time.
+             *
+             * Default value is 1000.
+             *
+             * \since 2.10
+             */
+            void setMaxSignalBatchSize( int count );
+
+            /**
+             * \sa setMaxSignalBatchSize
+             *
+             * \since 2.10
+             */
+            int maxSignalBatchSize() const;
+
         private:
             class Private;
             Private* const d;
@@ -97,4 +180,6 @@ namespace Soprano {
     }
 }
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( Soprano::Server::DBusExportModel::ChangeSignals )
+
 #endif
@@ -40,6 +40,8 @@
 #include <QtCore/QStringList>
 #include <QtCore/QMutex>
 #include <QtCore/QPointer>
+#include <QtCore/QBasicTimer>
+#include <QtCore/QTimerEvent>
 #include <QtCore/QDebug>
 
 #include "soprano/model.h"
@@ -56,7 +58,9 @@ class Soprano::Server::DBusModelAdaptor::Private
 {
 public:
     Private( DBusModelAdaptor* parent )
-        : m_iteratorCount( 0 ),
+        : addedPending( false ),
+          removedPending( false ),
+          m_iteratorCount( 0 ),
           q( parent ) {
     }
 
@@ -75,6 +79,21 @@ public:
 
     void _s_delayedResultReady( Soprano::Util::AsyncResult* );
 
+    // change notifications collected until the next flush
+    QList<Statement> addedStatements;
+    QList<Statement> removedStatements;
+    bool addedPending;
+    bool removedPending;
+    QBasicTimer flushTimer;
+
+    void _s_statementsAdded();
+    void _s_statementsRemoved();
+    void _s_statementAdded( const Soprano::Statement& );
+    void _s_statementRemoved( const Soprano::Statement& );
+
+    void scheduleFlush();
+    void flush();
+
 private:
     int m_iteratorCount;
     DBusModelAdaptor* q;
@@ -151,6 +170,102 @@ void Soprano::Server::DBusModelAdaptor::Private::_s_delayedResultReady( Util::As
 }
 
 
+void Soprano::Server::DBusModelAdaptor::Private::_s_statementsAdded()
+{
+    addedPending = true;
+    scheduleFlush();
+}
+
+
+void Soprano::Server::DBusModelAdaptor::Private::_s_statementsRemoved()
+{
+    removedPending = true;
+    scheduleFlush();
+}
+
+
+void Soprano::Server::DBusModelAdaptor::Private::_s_statementAdded( const Soprano::Statement& statement )
+{
+    // keep the order of additions and removals intact
+    if ( !removedStatements.isEmpty() ) {
+        flush();
+    }
+    addedStatements.append( statement );
+    scheduleFlush();
+}
+
+
+void Soprano::Server::DBusModelAdaptor::Private::_s_statementRemoved( const Soprano::Statement& statement )
+{
+    if ( !addedStatements.isEmpty() ) {
+        flush();
+    }
+    removedStatements.append( statement );
+    scheduleFlush();
+}
+
+
+void Soprano::Server::DBusModelAdaptor::Private::scheduleFlush()
+{
+    if ( model->signalCacheTime() <= 0 ||
+         addedStatements.count() + removedStatements.count() >= model->maxSignalBatchSize() ) {
+        flush();
+    }
+    else if ( !flushTimer.isActive() ) {
+        flushTimer.start( model->signalCacheTime(), q );
+    }
+}
+
+
+void Soprano::Server::DBusModelAdaptor::Private::flush()
+{
+    flushTimer.stop();
+
+    QList<Statement> added = addedStatements;
+    QList<Statement> removed = removedStatements;
+    bool wasAdded = addedPending;
+    bool wasRemoved = removedPending;
+    addedStatements.clear();
+    removedStatements.clear();
+    addedPending = removedPending = false;
+
+    DBusExportModel::ChangeSignals flags = model->changeSignals();
+
+    if ( flags & DBusExportModel::StatementSignals ) {
+        Q_FOREACH( const Statement& s, added ) {
+            emit q->statementAdded( s );
+        }
+        Q_FOREACH( const Statement& s, removed ) {
+            emit q->statementRemoved( s );
+        }
+    }
+
+    if ( flags & DBusExportModel::StatementBatchSignals ) {
+        if ( !added.isEmpty() ) {
+            emit q->statementsAddedBatch( added );
+        }
+        if ( !removed.isEmpty() ) {
+            emit q->statementsRemovedBatch( removed );
+        }
+    }
+
+    // not all models report single statements (removeAllStatements for example).
+    // Clients interested in those changes have to listen to statementsAdded and
+    // statementsRemoved. A summary without any counts carries no information.
+    if ( flags & DBusExportModel::SummarySignals &&
+         ( !added.isEmpty() || !removed.isEmpty() ) ) {
+        emit q->statementsChanged( added.count(), removed.count() );
+    }
+
+    if ( wasAdded ) {
+        emit q->statementsAdded();
+    }
+    if ( wasRemoved ) {
+        emit q->statementsRemoved();
+    }
+}
+
+
 Soprano::Server::DBusModelAdaptor::DBusModelAdaptor( DBusExportModel* dbusModel )
     : QDBusAbstractAdaptor( dbusModel ),
       d( new Private( this ) )
@@ -158,19 +273,21 @@ Soprano::Server::DBusModelAdaptor::DBusModelAdaptor( DBusExportModel* dbusModel
     qDBusRegisterMetaType<Soprano::Node>();
     qDBusRegisterMetaType<Soprano::Statement>();
     qDBusRegisterMetaType<Soprano::BindingSet>();
+    qDBusRegisterMetaType<QList<Soprano::Statement> >();
 
     d->model = dbusModel;
 
     // we cannot use setAutoRelaySignals here since that would connect (non-existing)
-    // signals from parent instead of model
+    // signals from parent instead of model. The signals are not relayed directly
+    // but coalesced according to the settings of the export model.
     connect( dbusModel->parentModel(), SIGNAL(statementsAdded()),
-             this, SIGNAL(statementsAdded()) );
+             this, SLOT(_s_statementsAdded()) );
     connect( dbusModel->parentModel(), SIGNAL(statementsRemoved()),
-             this, SIGNAL(statementsRemoved()) );
+             this, SLOT(_s_statementsRemoved()) );
     connect( dbusModel->parentModel(), SIGNAL(statementAdded(Soprano::Statement)),
-             this, SIGNAL(statementAdded(Soprano::Statement)) );
+             this, SLOT(_s_statementAdded(Soprano::Statement)) );
     connect( dbusModel->parentModel(), SIGNAL(statementRemoved(Soprano::Statement)),
-             this, SIGNAL(statementRemoved(Soprano::Statement)) );
+             this, SLOT(_s_statementRemoved(Soprano::Statement)) );
 }
 
 Soprano::Server::DBusModelAdaptor::~DBusModelAdaptor()
@@ -178,6 +295,17 @@ Soprano::Server::DBusModelAdaptor::~DBusModelAdaptor()
     delete d;
 }
 
+
+void Soprano::Server::DBusModelAdaptor::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() == d->flushTimer.timerId() ) {
+        d->flush();
+    }
+    else {
+        QDBusAbstractAdaptor::timerEvent( event );
+    }
+}
+
 int Soprano::Server::DBusModelAdaptor::addStatement( const Soprano::Statement& statement, const QDBusMessage& m )
 {
     // handle method call org.soprano.Model.addStatement
@@ -24,6 +24,8 @@
 
 #include <QtDBus/QtDBus>
 
+class QTimerEvent;
+
 namespace Soprano {
 
     class Statement;
@@ -98,6 +100,18 @@ namespace Soprano {
                         "      <arg name=\"statement\" type=\"((isss)(isss)(isss)(isss))\" />\n"
                         "      <annotation name=\"com.trolltech.QtDBus.QtTypeName.In0\" value=\"Soprano::Statement\" />\n"
                         "    </signal>\n"
+                        "    <signal name=\"statementsAddedBatch\">\n"
+                        "      <arg name=\"statements\" type=\"a((isss)(isss)(isss)(isss))\" />\n"
+                        "      <annotation name=\"com.trolltech.QtDBus.QtTypeName.In0\" value=\"QList&lt;Soprano::Statement&gt;\" />\n"
+                        "    </signal>\n"
+                        "    <signal name=\"statementsRemovedBatch\">\n"
+                        "      <arg name=\"statements\" type=\"a((isss)(isss)(isss)(isss))\" />\n"
+                        "      <annotation name=\"com.trolltech.QtDBus.QtTypeName.In0\" value=\"QList&lt;Soprano::Statement&gt;\" />\n"
+                        "    </signal>\n"
+                        "    <signal name=\"statementsChanged\">\n"
+                        "      <arg name=\"added\" type=\"i\" />\n"
+                        "      <arg name=\"removed\" type=\"i\" />\n"
+                        "    </signal>\n"
                         "  </interface>\n")
 
         public:
@@ -122,12 +136,22 @@ namespace Soprano {
             void statementsRemoved();
             void statementAdded( const Soprano::Statement& statement );
             void statementRemoved( const Soprano::Statement& statement );
+            void statementsAddedBatch( const QList<Soprano::Statement>& statements );
+            void statementsRemovedBatch( const QList<Soprano::Statement>& statements );
+            void statementsChanged( int added, int removed );
+
+        protected:
+            void timerEvent( QTimerEvent* event );
 
         private:
             class Private;
             Private* const d;
 
             Q_PRIVATE_SLOT( d, void _s_delayedResultReady( Soprano::Util::AsyncResult* ) )
+            Q_PRIVATE_SLOT( d, void _s_statementsAdded() )
+            Q_PRIVATE_SLOT( d, void _s_statementsRemoved() )
+            Q_PRIVATE_SLOT( d, void _s_statementAdded( const Soprano::Statement& ) )
+            Q_PRIVATE_SLOT( d, void _s_statementRemoved( const Soprano::Statement& ) )
         };
     }
 }
@@ -22,12 +22,15 @@
 #include "dbusnodeiteratoradaptor.h"
 #include "dbusutil.h"
 #include "dbusexportiterator.h"
+#include "dbusoperators.h"
 #include "nodeiterator.h"
 
 Soprano::Server::DBusNodeIteratorAdaptor::DBusNodeIteratorAdaptor( DBusExportIterator* it )
     : QDBusAbstractAdaptor( it ),
       m_iteratorWrapper( it )
 {
+    qDBusRegisterMetaType<Soprano::Node>();
+    qDBusRegisterMetaType<QList<Soprano::Node> >();
 }
 
 Soprano::Server::DBusNodeIteratorAdaptor::~DBusNodeIteratorAdaptor()
@@ -54,6 +57,21 @@ bool Soprano::Server::DBusNodeIteratorAdaptor::next( const QDBusMessage& m )
     return reply;
 }
 
+QList<Soprano::Node> Soprano::Server::DBusNodeIteratorAdaptor::nextBatch( int max, const QDBusMessage& m )
+{
+    // handle method call org.soprano.NodeIterator.nextBatch
+    QList<Soprano::Node> nodes;
+    NodeIterator it = m_iteratorWrapper->nodeIterator();
+    max = qBound( 1, max, int( DBus::MaxBatchSize ) );
+    while ( nodes.count() < max && it.next() ) {
+        nodes.append( it.current() );
+    }
+    if ( it.lastError() ) {
+        DBus::sendErrorReply( m, it.lastError() );
+    }
+    return nodes;
+}
+
 void Soprano::Server::DBusNodeIteratorAdaptor::close( const QDBusMessage& m )
 {
     // handle method call org.soprano.NodeIterator.next
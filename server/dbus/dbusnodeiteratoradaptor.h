@@ -45,6 +45,11 @@ namespace Soprano {
             "      <arg direction=\"out\" type=\"(isss)\" name=\"node\" />\n"
             "      <annotation value=\"Soprano::Node\" name=\"com.trolltech.QtDBus.QtTypeName.Out0\" />\n"
             "    </method>\n"
+            "    <method name=\"nextBatch\" >\n"
+            "      <arg direction=\"in\" type=\"i\" name=\"max\" />\n"
+            "      <arg direction=\"out\" type=\"a(isss)\" name=\"nodes\" />\n"
+            "      <annotation value=\"QList&lt;Soprano::Node&gt;\" name=\"com.trolltech.QtDBus.QtTypeName.Out0\" />\n"
+            "    </method>\n"
             "    <method name=\"close\" />\n"
             "  </interface>\n"
             "")
@@ -56,6 +61,12 @@ namespace Soprano {
     public Q_SLOTS:
         Soprano::Node current( const QDBusMessage& m );
         bool next( const QDBusMessage& m );
+
+        /**
+         * Advances the iterator up to \p max times and returns the visited
+         * nodes. Fewer nodes are only returned once the iterator is exhausted.
+         */
+        QList<Soprano::Node> nextBatch( int max, const QDBusMessage& m );
         void close( const QDBusMessage& m );
 
     private:
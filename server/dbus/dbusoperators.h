@@ -32,6 +32,9 @@
 Q_DECLARE_METATYPE(Soprano::Statement)
 Q_DECLARE_METATYPE(Soprano::Node)
 Q_DECLARE_METATYPE(Soprano::BindingSet)
+Q_DECLARE_METATYPE(QList<Soprano::Statement>)
+Q_DECLARE_METATYPE(QList<Soprano::Node>)
+Q_DECLARE_METATYPE(QList<Soprano::BindingSet>)
 
 
 QDBusArgument& operator<<( QDBusArgument& arg, const Soprano::Node& );
@@ -22,6 +22,7 @@
 #include "dbusqueryresultiteratoradaptor.h"
 #include "dbusutil.h"
 #include "dbusexportiterator.h"
+#include "dbusoperators.h"
 
 #include "node.h"
 #include "statement.h"
@@ -32,6 +33,11 @@ Soprano::Server::DBusQueryResultIteratorAdaptor::DBusQueryResultIteratorAdaptor(
     : QDBusAbstractAdaptor( it ),
       m_iteratorWrapper( it )
 {
+    qDBusRegisterMetaType<Soprano::Node>();
+    qDBusRegisterMetaType<Soprano::Statement>();
+    qDBusRegisterMetaType<Soprano::BindingSet>();
+    qDBusRegisterMetaType<QList<Soprano::Statement> >();
+    qDBusRegisterMetaType<QList<Soprano::BindingSet> >();
 }
 
 Soprano::Server::DBusQueryResultIteratorAdaptor::~DBusQueryResultIteratorAdaptor()
@@ -68,6 +74,36 @@ bool Soprano::Server::DBusQueryResultIteratorAdaptor::next( const QDBusMessage&
     return reply;
 }
 
+QList<Soprano::BindingSet> Soprano::Server::DBusQueryResultIteratorAdaptor::nextBatch( int max, const QDBusMessage& m )
+{
+    // handle method call org.soprano.QueryResultIterator.nextBatch
+    QList<Soprano::BindingSet> bindings;
+    QueryResultIterator it = m_iteratorWrapper->queryResultIterator();
+    max = qBound( 1, max, int( DBus::MaxBatchSize ) );
+    while ( bindings.count() < max && it.next() ) {
+        bindings.append( it.current() );
+    }
+    if ( it.lastError() ) {
+        DBus::sendErrorReply( m, it.lastError() );
+    }
+    return bindings;
+}
+
+QList<Soprano::Statement> Soprano::Server::DBusQueryResultIteratorAdaptor::nextStatementBatch( int max, const QDBusMessage& m )
+{
+    // handle method call org.soprano.QueryResultIterator.nextStatementBatch
+    QList<Soprano::Statement> statements;
+    QueryResultIterator it = m_iteratorWrapper->queryResultIterator();
+    max = qBound( 1, max, int( DBus::MaxBatchSize ) );
+    while ( statements.count() < max && it.next() ) {
+        statements.append( it.currentStatement() );
+    }
+    if ( it.lastError() ) {
+        DBus::sendErrorReply( m, it.lastError() );
+    }
+    return statements;
+}
+
 Soprano::Node Soprano::Server::DBusQueryResultIteratorAdaptor::bindingByIndex( int index, const QDBusMessage& m )
 {
     // handle method call org.soprano.QueryResultIterator.bindingByIndex
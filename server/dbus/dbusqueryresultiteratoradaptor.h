@@ -47,6 +47,16 @@ namespace Soprano {
                         "      <arg direction=\"out\" type=\"a{s(isss)}\" name=\"node\" />\n"
                         "      <annotation value=\"Soprano::BindingSet\" name=\"com.trolltech.QtDBus.QtTypeName.Out0\" />\n"
                         "    </method>\n"
+                        "    <method name=\"nextBatch\" >\n"
+                        "      <arg direction=\"in\" type=\"i\" name=\"max\" />\n"
+                        "      <arg direction=\"out\" type=\"a(a{s(isss)})\" name=\"bindings\" />\n"
+                        "      <annotation value=\"QList&lt;Soprano::BindingSet&gt;\" name=\"com.trolltech.QtDBus.QtTypeName.Out0\" />\n"
+                        "    </method>\n"
+                        "    <method name=\"nextStatementBatch\" >\n"
+                        "      <arg direction=\"in\" type=\"i\" name=\"max\" />\n"
+                        "      <arg direction=\"out\" type=\"a((isss)(isss)(isss)(isss))\" name=\"statements\" />\n"
+                        "      <annotation value=\"QList&lt;Soprano::Statement&gt;\" name=\"com.trolltech.QtDBus.QtTypeName.Out0\" />\n"
+                        "    </method>\n"
                         "    <method name=\"close\" />\n"
                         "    <method name=\"currentStatement\" >\n"
                         "      <arg direction=\"out\" type=\"((isss)(isss)(isss)(isss))\" name=\"statement\" />\n"
@@ -89,6 +99,18 @@ namespace Soprano {
         public Q_SLOTS:
             Soprano::BindingSet current( const QDBusMessage& m );
             bool next( const QDBusMessage& m );
+
+            /**
+             * Advances the iterator up to \p max times and returns the visited
+             * binding sets. Fewer sets are only returned once the iterator is
+             * exhausted.
+             */
+            QList<Soprano::BindingSet> nextBatch( int max, const QDBusMessage& m );
+
+            /**
+             * The same as nextBatch for graph results.
+             */
+            QList<Soprano::Statement> nextStatementBatch( int max, const QDBusMessage& m );
             void close( const QDBusMessage& m );
             Soprano::Statement currentStatement( const QDBusMessage& m );
             Soprano::Node bindingByIndex( int index, const QDBusMessage& m );
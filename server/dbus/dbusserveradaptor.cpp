@@ -98,6 +98,8 @@ QString Soprano::Server::DBusServerAdaptor::createModel( const QString& name, co
 
             QString objectPath = d->dbusObjectPath + "/models/" + normalizeModelName( name );
             DBusExportModel* mw = new DBusExportModel( model );
+            mw->setChangeSignals( DBusExportModel::ChangeSignals( d->core->dbusChangeSignals() ) );
+            mw->setSignalCacheTime( d->core->dbusSignalCacheTime() );
             connect( model, SIGNAL(destroyed(QObject*)), mw, SLOT(deleteLater()) );
             mw->registerModel( objectPath );
             d->modelDBusObjectPaths.insert( name, mw );
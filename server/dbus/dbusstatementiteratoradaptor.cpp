@@ -22,12 +22,16 @@
 #include "dbusstatementiteratoradaptor.h"
 #include "dbusutil.h"
 #include "dbusexportiterator.h"
+#include "dbusoperators.h"
 #include "statementiterator.h"
 
 Soprano::Server::DBusStatementIteratorAdaptor::DBusStatementIteratorAdaptor( DBusExportIterator* it )
     : QDBusAbstractAdaptor( it ),
       m_iteratorWrapper( it )
 {
+    qDBusRegisterMetaType<Soprano::Node>();
+    qDBusRegisterMetaType<Soprano::Statement>();
+    qDBusRegisterMetaType<QList<Soprano::Statement> >();
 }
 
 Soprano::Server::DBusStatementIteratorAdaptor::~DBusStatementIteratorAdaptor()
@@ -54,6 +58,21 @@ bool Soprano::Server::DBusStatementIteratorAdaptor::next( const QDBusMessage& m
     return reply;
 }
 
+QList<Soprano::Statement> Soprano::Server::DBusStatementIteratorAdaptor::nextBatch( int max, const QDBusMessage& m )
+{
+    // handle method call org.soprano.StatementIterator.nextBatch
+    QList<Soprano::Statement> statements;
+    StatementIterator it = m_iteratorWrapper->statementIterator();
+    max = qBound( 1, max, int( DBus::MaxBatchSize ) );
+    while ( statements.count() < max && it.next() ) {
+        statements.append( it.current() );
+    }
+    if ( it.lastError() ) {
+        DBus::sendErrorReply( m, it.lastError() );
+    }
+    return statements;
+}
+
 void Soprano::Server::DBusStatementIteratorAdaptor::close( const QDBusMessage& m )
 {
     // handle method call org.soprano.StatementIterator.next
@@ -45,6 +45,11 @@ namespace Soprano {
                         "      <arg direction=\"out\" type=\"((isss)(isss)(isss)(isss))\" name=\"statement\" />\n"
                         "      <annotation value=\"Soprano::Statement\" name=\"com.trolltech.QtDBus.QtTypeName.Out0\" />\n"
                         "    </method>\n"
+                        "    <method name=\"nextBatch\" >\n"
+                        "      <arg direction=\"in\" type=\"i\" name=\"max\" />\n"
+                        "      <arg direction=\"out\" type=\"a((isss)(isss)(isss)(isss))\" name=\"statements\" />\n"
+                        "      <annotation value=\"QList&lt;Soprano::Statement&gt;\" name=\"com.trolltech.QtDBus.QtTypeName.Out0\" />\n"
+                        "    </method>\n"
                         "    <method name=\"close\" />\n"
                         "  </interface>\n"
                         "")
@@ -56,6 +61,13 @@ namespace Soprano {
         public Q_SLOTS:
             Soprano::Statement current( const QDBusMessage& m );
             bool next( const QDBusMessage& m );
+
+            /**
+             * Advances the iterator up to \p max times and returns the visited
+             * statements. Fewer statements are only returned once the
+             * iterator is exhausted.
+             */
+            QList<Soprano::Statement> nextBatch( int max, const QDBusMessage& m );
             void close( const QDBusMessage& m );
 
         private:
@@ -42,6 +42,15 @@ namespace Soprano {
          * Converts a DBus error as encoded by sendErrorReply() to a Soprano::Error.
          */
         Soprano::Error::Error convertError( const QDBusError& e );
+
+        /**
+         * The nextBatch methods of the iterator interfaces return at most
+         * MaxBatchSize rows per call. Clients request DefaultBatchSize rows.
+         */
+        enum {
+            DefaultBatchSize = 100,
+            MaxBatchSize = 1000
+        };
     }
 }
 
@@ -119,6 +119,30 @@ int Soprano::Server::ServerCore::maximumConnectionCount() const
 }
 
 
+void Soprano::Server::ServerCore::setDBusChangeSignals( int flags )
+{
+    d->dbusChangeSignals = flags;
+}
+
+
+int Soprano::Server::ServerCore::dbusChangeSignals() const
+{
+    return d->dbusChangeSignals;
+}
+
+
+void Soprano::Server::ServerCore::setDBusSignalCacheTime( int msec )
+{
+    d->dbusSignalCacheTime = qMax( 0, msec );
+}
+
+
+int Soprano::Server::ServerCore::dbusSignalCacheTime() const
+{
+    return d->dbusSignalCacheTime;
+}
+
+
 Soprano::Model* Soprano::Server::ServerCore::model( const QString& name )
 {
     QHash<QString, Model*>::const_iterator it = d->models.constFind( name );
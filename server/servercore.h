@@ -137,6 +137,46 @@ namespace Soprano {
              */
             int maximumConnectionCount() const;
 
+            /**
+             * Set the forms in which models exported via D-Bus publish their changes.
+             * \p flags is a combination of DBusExportModel::ChangeSignal values and
+             * applies to models exported after the call.
+             *
+             * Default value is DBusExportModel::StatementSignals.
+             *
+             * \sa DBusExportModel::setChangeSignals
+             *
+             * \since 2.10
+             */
+            void setDBusChangeSignals( int flags );
+
+            /**
+             * \sa setDBusChangeSignals
+             *
+             * \since 2.10
+             */
+            int dbusChangeSignals() const;
+
+            /**
+             * Set the time in milliseconds models exported via D-Bus collect change
+             * notifications before emitting them. Applies to models exported after
+             * the call.
+             *
+             * Default value is 0, ie. every notification is relayed immediately.
+             *
+             * \sa DBusExportModel::setSignalCacheTime
+             *
+             * \since 2.10
+             */
+            void setDBusSignalCacheTime( int msec );
+
+            /**
+             * \sa setDBusSignalCacheTime
+             *
+             * \since 2.10
+             */
+            int dbusSignalCacheTime() const;
+
             /**
              * Get or create Model with the specific name.
              * The default implementation will use createModel() to create a new Model
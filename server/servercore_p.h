@@ -41,6 +41,8 @@ namespace Soprano {
         public:
             ServerCorePrivate()
                 : maxConnectionCount( 0 ),
+                  dbusChangeSignals( 0x1 ), // DBusExportModel::StatementSignals
+                  dbusSignalCacheTime( 0 ),
 #ifdef BUILD_DBUS_SUPPORT
                   dbusController( 0 ),
 #endif
@@ -53,6 +55,9 @@ namespace Soprano {
 
             int maxConnectionCount;
 
+            int dbusChangeSignals;
+            int dbusSignalCacheTime;
+
             QHash<QString, Model*> models;
             QList<ServerConnection*> connections;
 
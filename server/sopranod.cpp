@@ -17,6 +17,7 @@
 #include "version.h"
 #ifdef BUILD_DBUS_SUPPORT
 #include "dbus/dbusserveradaptor.h"
+#include "dbus/dbusexportmodel.h"
 #endif
 #include "lockfile.h"
 #include "sopranodcore.h"
@@ -60,8 +61,19 @@ int usage()
       << "   sopranod [--backend <name>] [--storagedir <dir>] [--port <port>]"
 #ifdef BUILD_CLUCENE_INDEX
            " [--with-index]"
+#endif
+#ifdef BUILD_DBUS_SUPPORT
+           " [--signal-cache-time <msec>] [--change-signals <forms>]"
 #endif
       << endl;
+#ifdef BUILD_DBUS_SUPPORT
+    s << endl
+      << "   --signal-cache-time <msec>  Collect D-Bus change notifications for <msec> milliseconds" << endl
+      << "                               before emitting them (default: 0)." << endl
+      << "   --change-signals <forms>    Comma separated list of the forms in which changes are" << endl
+      << "                               published via D-Bus in addition to statementsAdded and" << endl
+      << "                               statementsRemoved: statement, batch, summary (default: statement)." << endl;
+#endif
 
     return 1;
 }
@@ -83,6 +95,10 @@ int main( int argc, char** argv )
     QString backendName;
     int port = Soprano::Server::ServerCore::DEFAULT_PORT;
     bool withIndex = false;
+#ifdef BUILD_DBUS_SUPPORT
+    int signalCacheTime = 0;
+    int changeSignals = Soprano::Server::DBusExportModel::StatementSignals;
+#endif
     QList<Soprano::BackendSetting> settings;
     int i = 1;
     while ( i < args.count() ) {
@@ -121,6 +137,44 @@ int main( int argc, char** argv )
         else if ( args[i] == "--with-index" ) {
             withIndex = true;
         }
+#endif
+#ifdef BUILD_DBUS_SUPPORT
+        else if ( args[i] == "--signal-cache-time" ) {
+            ++i;
+            if ( i < args.count() ) {
+                bool ok = true;
+                signalCacheTime = args[i].toInt( &ok );
+                if ( !ok || signalCacheTime < 0 ) {
+                    return usage();
+                }
+            }
+            else {
+                return usage();
+            }
+        }
+        else if ( args[i] == "--change-signals" ) {
+            ++i;
+            if ( i < args.count() ) {
+                changeSignals = 0;
+                Q_FOREACH( const QString& form, args[i].split( ',', QString::SkipEmptyParts ) ) {
+                    if ( form == QLatin1String( "statement" ) ) {
+                        changeSignals |= Soprano::Server::DBusExportModel::StatementSignals;
+                    }
+                    else if ( form == QLatin1String( "batch" ) ) {
+                        changeSignals |= Soprano::Server::DBusExportModel::StatementBatchSignals;
+                    }
+                    else if ( form == QLatin1String( "summary" ) ) {
+                        changeSignals |= Soprano::Server::DBusExportModel::SummarySignals;
+                    }
+                    else {
+                        return usage();
+                    }
+                }
+            }
+            else {
+                return usage();
+            }
+        }
 #endif
         else {
             return usage();
@@ -146,6 +200,8 @@ int main( int argc, char** argv )
     core->setBackendSettings( settings );
 
 #ifdef BUILD_DBUS_SUPPORT
+    core->setDBusChangeSignals( changeSignals );
+    core->setDBusSignalCacheTime( signalCacheTime );
     QDBusConnection::sessionBus().registerService( "org.soprano.Server" );
     core->registerAsDBusObject();
 #endif
@@ -33,8 +33,12 @@
 #include "nodeiterator.h"
 #include "node.h"
 #include "statement.h"
+#include "statementsignaltracker.h"
 
 #include <QtCore/QUuid>
+#include <QtCore/QCache>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
 #include <QtCore/QDateTime>
 #include <QtCore/QMutex>
 #include <QtCore/QMutexLocker>
@@ -46,6 +50,35 @@ namespace {
     QUrl createGraphUri() {
         return QUrl( "urn:nepomuk:local:" + QUuid::createUuid().toString().remove( QRegExp( "[\\{\\}]" ) ) );
     }
+
+    /**
+     * The NRL cardinality restrictions defined for one predicate.
+     * -1 means undefined.
+     */
+    class Cardinality
+    {
+    public:
+        Cardinality()
+            : min( -1 ),
+              max( -1 ),
+              c( -1 ) {
+        }
+
+        int min;
+        int max;
+        int c;
+    };
+
+    // the maximum number of characters kept in the expanded query cache
+    const int s_maxExpandedQueryCacheCost = 1024*1024;
+
+    bool isCardinalityPredicate( const Soprano::Node& predicate ) {
+        // an empty predicate is used by some backends to signal the removal of a whole graph
+        return( predicate.isEmpty() ||
+                predicate == Soprano::Vocabulary::NRL::minCardinality() ||
+                predicate == Soprano::Vocabulary::NRL::maxCardinality() ||
+                predicate == Soprano::Vocabulary::NRL::cardinality() );
+    }
 }
 
 
@@ -55,7 +88,106 @@ public:
     Private()
         : ignoreContext( true ),
           m_expandQueryPrefixes( false ),
-          m_prefixMapMutex( QMutex::Recursive ) {
+          m_prefixMapMutex( QMutex::Recursive ),
+          m_expandedQueries( s_maxExpandedQueryCacheCost ),
+          m_cardinalityGeneration( 0 ),
+          m_cardinalityCacheGeneration( -1 ) {
+    }
+
+    /**
+     * Get the cardinality restrictions of \p predicate. The restrictions of all
+     * predicates are read in one go the first time this is called after the
+     * cache has been invalidated.
+     */
+    Cardinality cardinality( const Soprano::Node& predicate )
+    {
+        QMutexLocker lock( &m_cardinalityMutex );
+        if ( m_cardinalityCacheGeneration != m_cardinalityGeneration ) {
+            // do not keep the mutex locked while reading from the parent model since it may
+            // emit its signals which end up in invalidateCardinalities()
+            const int generation = m_cardinalityGeneration;
+            lock.unlock();
+            QHash<Soprano::Node, Cardinality> cardinalities = readCardinalities();
+            lock.relock();
+            m_cardinalities = cardinalities;
+            m_cardinalityCacheGeneration = generation;
+        }
+        return m_cardinalities.value( predicate );
+    }
+
+    QHash<Soprano::Node, Cardinality> readCardinalities() const
+    {
+        QHash<Soprano::Node, Cardinality> cardinalities;
+
+        Soprano::StatementIterator it = q->FilterModel::listStatements( Soprano::Statement( Soprano::Node(), Soprano::Vocabulary::NRL::minCardinality(), Soprano::Node() ) );
+        while ( it.next() ) {
+            if ( it.current().object().isLiteral() )
+                cardinalities[it.current().subject()].min = it.current().object().literal().toInt();
+        }
+        it = q->FilterModel::listStatements( Soprano::Statement( Soprano::Node(), Soprano::Vocabulary::NRL::maxCardinality(), Soprano::Node() ) );
+        while ( it.next() ) {
+            if ( it.current().object().isLiteral() )
+                cardinalities[it.current().subject()].max = it.current().object().literal().toInt();
+        }
+        it = q->FilterModel::listStatements( Soprano::Statement( Soprano::Node(), Soprano::Vocabulary::NRL::cardinality(), Soprano::Node() ) );
+        while ( it.next() ) {
+            if ( it.current().object().isLiteral() )
+                cardinalities[it.current().subject()].c = it.current().object().literal().toInt();
+        }
+
+        return cardinalities;
+    }
+
+    void invalidateCardinalities()
+    {
+        QMutexLocker lock( &m_cardinalityMutex );
+        ++m_cardinalityGeneration;
+    }
+
+    void handleStatementSignal( Soprano::Util::StatementSignalTracker& tracker, const Soprano::Statement& statement )
+    {
+        tracker.statementSignal();
+        if ( isCardinalityPredicate( statement.predicate() ) ) {
+            invalidateCardinalities();
+        }
+    }
+
+    /**
+     * Called after writing \p statement (which may be a pattern) through this model
+     * since the parent does not necessarily emit signals for it.
+     */
+    void handleOwnWrite( const Soprano::Statement& statement )
+    {
+        if ( isCardinalityPredicate( statement.predicate() ) ) {
+            invalidateCardinalities();
+        }
+    }
+
+    /**
+     * Calls handleOwnWrite() when going out of scope, ie. after the write.
+     */
+    class OwnWriteGuard
+    {
+    public:
+        OwnWriteGuard( Private* d, const Soprano::Statement& statement )
+            : m_d( d ),
+              m_statement( statement ) {
+        }
+        ~OwnWriteGuard() {
+            m_d->handleOwnWrite( m_statement );
+        }
+
+    private:
+        Private* m_d;
+        Soprano::Statement m_statement;
+    };
+
+    void handleStatementsSignal( Soprano::Util::StatementSignalTracker& tracker )
+    {
+        if ( tracker.summarySignal() ) {
+            // we do not know which statements changed
+            invalidateCardinalities();
+        }
     }
 
     /**
@@ -65,7 +197,7 @@ public:
     {
         QMutexLocker lock( &m_prefixMapMutex );
 
-        m_prefixes.clear();
+        clearPrefixMap();
 
         // fixed prefixes
         m_prefixes.insert( "rdf", Soprano::Vocabulary::RDF::rdfNamespace() );
@@ -89,6 +221,84 @@ public:
                 m_prefixes.insert( ab, ns );
             }
         }
+
+        buildPrefixMatcher();
+    }
+
+    void clearPrefixMap()
+    {
+        QMutexLocker lock( &m_prefixMapMutex );
+        m_prefixes.clear();
+        m_prefixUsageRx = QRegExp();
+        m_expandedQueries.clear();
+    }
+
+    /**
+     * Build one regular expression which matches the usage of any of the
+     * known prefixes. That way a query only needs to be scanned once.
+     */
+    void buildPrefixMatcher()
+    {
+        QStringList escapedPrefixes;
+        for ( QHash<QString, QUrl>::const_iterator it = m_prefixes.constBegin();
+              it != m_prefixes.constEnd(); ++it ) {
+            escapedPrefixes << QRegExp::escape( it.key() );
+        }
+        m_prefixUsageRx = QRegExp( QString::fromLatin1( "\\b(%1):" ).arg( escapedPrefixes.join( QLatin1String( "|" ) ) ) );
+        m_expandedQueries.clear();
+    }
+
+    /**
+     * Add the declarations of all used but undeclared prefixes to \p query.
+     * Results are cached since the same queries tend to be executed over and over again.
+     */
+    QString expandQueryPrefixes( const QString& query )
+    {
+        QMutexLocker lock( &m_prefixMapMutex );
+
+        if ( const QString* cachedQuery = m_expandedQueries.object( query ) ) {
+            return *cachedQuery;
+        }
+
+        QString expandedQuery( query );
+
+        // find position in the query to add the prefixes to: directly before the actual query start
+        // certain backends like the virtuoso one support SPARQL extensions which need to be before the
+        // prefixes
+        const int pos = expandedQuery.indexOf( QRegExp( QLatin1String( "select|describe|construct|ask" ), Qt::CaseInsensitive ) );
+        if ( pos >= 0 && !m_prefixUsageRx.isEmpty() ) {
+            // collect the prefixes which are already declared
+            QRegExp declarationRx( QLatin1String( "[pP][rR][eE][fF][iI][xX]\\s*([^\\s:]*)\\s*:\\s*<([^>]*)>" ) );
+            QSet<QString> declaredPrefixes;
+            int i = 0;
+            while ( ( i = declarationRx.indexIn( query, i ) ) >= 0 ) {
+                if ( m_prefixes.value( declarationRx.cap( 1 ) ).toString() == declarationRx.cap( 2 ) ) {
+                    declaredPrefixes.insert( declarationRx.cap( 1 ) );
+                }
+                i += declarationRx.matchedLength();
+            }
+
+            // collect the used prefixes which still need to be declared
+            QRegExp usageRx( m_prefixUsageRx );
+            QSet<QString> usedPrefixes;
+            i = 0;
+            while ( ( i = usageRx.indexIn( query, i ) ) >= 0 ) {
+                if ( !declaredPrefixes.contains( usageRx.cap( 1 ) ) ) {
+                    usedPrefixes.insert( usageRx.cap( 1 ) );
+                }
+                i += usageRx.matchedLength();
+            }
+
+            QString declarations;
+            Q_FOREACH( const QString& prefix, usedPrefixes ) {
+                declarations += QString( "prefix %1: <%2> " ).arg( prefix ).arg( m_prefixes[prefix].toString() );
+            }
+            expandedQuery.insert( pos, declarations );
+        }
+
+        m_expandedQueries.insert( query, new QString( expandedQuery ), expandedQuery.length() );
+
+        return expandedQuery;
     }
 
     bool ignoreContext;
@@ -97,9 +307,24 @@ public:
     // cache of all prefixes that are supported
     QHash<QString, QUrl> m_prefixes;
 
+    // matches the usage of any of the prefixes in m_prefixes
+    QRegExp m_prefixUsageRx;
+
+    // LRU cache of expanded queries keyed by the original query
+    QCache<QString, QString> m_expandedQueries;
+
     NRLModel* q;
 
     QMutex m_prefixMapMutex;
+
+    // cache of the cardinality restrictions of all predicates
+    QHash<Soprano::Node, Cardinality> m_cardinalities;
+    int m_cardinalityGeneration;
+    int m_cardinalityCacheGeneration;
+    QMutex m_cardinalityMutex;
+
+    Soprano::Util::StatementSignalTracker m_addedTracker;
+    Soprano::Util::StatementSignalTracker m_removedTracker;
 };
 
 Soprano::NRLModel::NRLModel()
@@ -143,7 +368,7 @@ void Soprano::NRLModel::setEnableQueryPrefixExpansion( bool enable )
         if ( enable )
             d->buildPrefixMap();
         else
-            d->m_prefixes.clear();
+            d->clearPrefixMap();
     }
 }
 
@@ -156,43 +381,23 @@ bool Soprano::NRLModel::queryPrefixExpansionEnabled() const
 
 QHash<QString, QUrl> Soprano::NRLModel::queryPrefixes() const
 {
+    QMutexLocker lock( &d->m_prefixMapMutex );
     return d->m_prefixes;
 }
 
 
 Soprano::Error::ErrorCode Soprano::NRLModel::addNrlStatement( const Statement& statement )
 {
+    Private::OwnWriteGuard guard( d, statement );
+
     // 1. check if any cardinality restrictions are defined for s.predicate()
     // 2. if so -> enforce
     // 3. if not -> check if some for superproperties are defined (optional advanced feature)
 
-    QString query = QString( "select ?min ?max ?c where { { <%1> <%2> ?min } UNION { <%1> <%3> ?max } UNION { <%1> <%4> ?c } }" )
-                    .arg( statement.predicate().toString() )
-                    .arg( Vocabulary::NRL::minCardinality().toString() )
-                    .arg( Vocabulary::NRL::maxCardinality().toString() )
-                    .arg( Vocabulary::NRL::cardinality().toString() );
-
-    QueryResultIterator it = FilterModel::executeQuery( query, Query::QueryLanguageSparql );
-    if ( !it.isValid() ) {
-        setError( QString( "Query failed: '%1'" ).arg( query ) );
-        return Error::ErrorUnknown;
-    }
-
-    int min = -1;
-    int max = -1;
-    int c = -1;
-
-    while ( it.next() ) {
-        if ( it.binding( "min" ).isLiteral() ) {
-            min = it.binding( "min" ).literal().toInt();
-        }
-        else if ( it.binding( "max" ).isLiteral() ) {
-            max = it.binding( "max" ).literal().toInt();
-        }
-        if ( it.binding( "c" ).isLiteral() ) {
-            c = it.binding( "c" ).literal().toInt();
-        }
-    }
+    const Cardinality cardinality = d->cardinality( statement.predicate() );
+    int min = cardinality.min;
+    int max = cardinality.max;
+    int c = cardinality.c;
 
     if ( min >= 0 || max >= 0 || c >= 0 ) {
         qDebug() << "Predicate " << statement.predicate() << " has cardinalities: " << min << "; " << max << "; " << c;
@@ -279,6 +484,9 @@ QUrl Soprano::NRLModel::createGraph( const QUrl& type, QUrl* metadataGraph )
 
 Soprano::Error::ErrorCode Soprano::NRLModel::removeGraph( const QUrl& graph )
 {
+    // the graph may contain cardinality restrictions
+    Private::OwnWriteGuard guard( d, Statement( Node(), Node(), Node(), graph ) );
+
     QList<Node> metadataGraphs = FilterModel::executeQuery( QString("select ?mg where { ?mg %1 %2 . }")
                                                             .arg(Node::resourceToN3(Soprano::Vocabulary::NRL::coreGraphMetadataFor()) )
                                                             .arg(Node::resourceToN3(graph)),
@@ -295,43 +503,39 @@ Soprano::Error::ErrorCode Soprano::NRLModel::removeGraph( const QUrl& graph )
 
 Soprano::QueryResultIterator Soprano::NRLModel::executeQuery( const QString& query, Query::QueryLanguage language, const QString& userQueryLanguage ) const
 {
-    QString expandedQuery( query );
-
     if ( language == Query::QueryLanguageSparql &&
          d->m_expandQueryPrefixes ) {
-        d->m_prefixMapMutex.lock();
-        QHash<QString, QUrl> prefixes = d->m_prefixes;
-        d->m_prefixMapMutex.unlock();
-
-        // find position in the query to add the prefixes to: directly before the actual query start
-        // certain backends like the virtuoso one support SPARQL extensions which need to be before the
-        // prefixes
-        const int pos = expandedQuery.indexOf(QRegExp(QLatin1String("select|describe|construct|ask"), Qt::CaseInsensitive));
-        if(pos >= 0) {
-            for ( QHash<QString, QUrl>::const_iterator it = prefixes.constBegin();
-                  it != prefixes.constEnd(); ++it ) {
-                QString prefix = it.key();
-                QUrl ns = it.value();
-
-                // very stupid check for the prefix usage
-                if ( expandedQuery.contains( prefix + ':' ) ) {
-                    // if the prefix is not defined add it
-                    if ( !expandedQuery.contains( QRegExp( QString::fromLatin1( "[pP][rR][eE][fF][iI][xX]\\s*%1\\s*:\\s*<%2>" )
-                                                           .arg( prefix )
-                                                           .arg( QRegExp::escape( ns.toString() ) ) ) ) ) {
-                        expandedQuery.insert( pos, QString( "prefix %1: <%2> " ).arg( prefix ).arg( ns.toString() ) );
-                    }
-                }
-            }
-        }
+        return FilterModel::executeQuery( d->expandQueryPrefixes( query ), language, userQueryLanguage );
     }
 
-    return FilterModel::executeQuery( expandedQuery, language, userQueryLanguage );
+    return FilterModel::executeQuery( query, language, userQueryLanguage );
+}
+
+
+void Soprano::NRLModel::setParentModel( Model* model )
+{
+    FilterModel::setParentModel( model );
+    d->invalidateCardinalities();
+}
+
+
+Soprano::Error::ErrorCode Soprano::NRLModel::addStatement( const Statement& statement )
+{
+    Private::OwnWriteGuard guard( d, statement );
+    return FilterModel::addStatement( statement );
+}
+
+
+Soprano::Error::ErrorCode Soprano::NRLModel::removeStatement( const Statement& statement )
+{
+    Private::OwnWriteGuard guard( d, statement );
+    return FilterModel::removeStatement( statement );
 }
 
 
 Soprano::Error::ErrorCode Soprano::NRLModel::removeAllStatements( const Statement& statement )
 {
+    Private::OwnWriteGuard guard( d, statement );
     if( statement.context().isValid() &&
         !statement.subject().isValid() &&
         !statement.predicate().isValid() &&
@@ -343,4 +547,33 @@ Soprano::Error::ErrorCode Soprano::NRLModel::removeAllStatements( const Statemen
     }
 }
 
+
+
+void Soprano::NRLModel::parentStatementsAdded()
+{
+    d->handleStatementsSignal( d->m_addedTracker );
+    FilterModel::parentStatementsAdded();
+}
+
+
+void Soprano::NRLModel::parentStatementsRemoved()
+{
+    d->handleStatementsSignal( d->m_removedTracker );
+    FilterModel::parentStatementsRemoved();
+}
+
+
+void Soprano::NRLModel::parentStatementAdded( const Statement& statement )
+{
+    d->handleStatementSignal( d->m_addedTracker, statement );
+    FilterModel::parentStatementAdded( statement );
+}
+
+
+void Soprano::NRLModel::parentStatementRemoved( const Statement& statement )
+{
+    d->handleStatementSignal( d->m_removedTracker, statement );
+    FilterModel::parentStatementRemoved( statement );
+}
+
 #include "moc_nrlmodel.cpp"
@@ -124,6 +124,12 @@ namespace Soprano {
          * cardinality bigger than 1 which has already been reached
          * fails with an error.
          *
+         * The cardinality restrictions of all predicates are cached. The
+         * cache is invalidated whenever statements using one of the NRL
+         * cardinality predicates are added to or removed from the parent
+         * model, be it through this model or, if the parent emits statement
+         * signals, directly.
+         *
          * \return Error::ErrorNone on success.
          */
         Error::ErrorCode addNrlStatement( const Statement& s );
@@ -154,6 +160,9 @@ namespace Soprano {
          * If queryPrefixExpansionEnabled is \p true query prefixes will be expanded before sending the
          * query to the underlying model.
          *
+         * Expanded queries are cached. Thus, executing the same query repeatedly
+         * does not require to scan it again.
+         *
          * \since 2.4
          */
         virtual QueryResultIterator executeQuery( const QString& query, Query::QueryLanguage language, const QString& userQueryLanguage = QString() ) const;
@@ -168,6 +177,52 @@ namespace Soprano {
          */
         virtual Error::ErrorCode removeAllStatements( const Statement& statement );
 
+        /**
+         * Reimplemented to invalidate the cached cardinality restrictions if
+         * \p statement uses one of the NRL cardinality predicates.
+         */
+        virtual Error::ErrorCode addStatement( const Statement& statement );
+
+        /**
+         * Reimplemented to invalidate the cached cardinality restrictions if
+         * \p statement uses one of the NRL cardinality predicates.
+         */
+        virtual Error::ErrorCode removeStatement( const Statement& statement );
+
+        /**
+         * Reimplemented to invalidate the cached cardinality restrictions.
+         */
+        void setParentModel( Model* model );
+
+        using FilterModel::addStatement;
+        using FilterModel::removeStatement;
+        using FilterModel::removeAllStatements;
+
+    protected:
+        /**
+         * Invalidates the cached cardinality restrictions if no per-statement
+         * signal told us which statements were added.
+         */
+        void parentStatementsAdded();
+
+        /**
+         * Invalidates the cached cardinality restrictions if no per-statement
+         * signal told us which statements were removed.
+         */
+        void parentStatementsRemoved();
+
+        /**
+         * Invalidates the cached cardinality restrictions if \p statement
+         * uses one of the NRL cardinality predicates.
+         */
+        void parentStatementAdded( const Statement& statement );
+
+        /**
+         * Invalidates the cached cardinality restrictions if \p statement
+         * uses one of the NRL cardinality predicates.
+         */
+        void parentStatementRemoved( const Statement& statement );
+
     private:
         class Private;
         Private* const d;
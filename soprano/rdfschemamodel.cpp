@@ -22,14 +22,257 @@
 #include "rdfschemamodel.h"
 #include "model.h"
 #include "statementiterator.h"
+#include "simplestatementiterator.h"
+#include "iteratorbackend.h"
 #include "rdf.h"
 #include "rdfs.h"
 #include "statement.h"
+#include "statementsignaltracker.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+
+
+namespace {
+    /**
+     * The transitive closure of one hierarchy relation (rdfs:subClassOf
+     * or rdfs:subPropertyOf) in both directions.
+     */
+    class Hierarchy
+    {
+    public:
+        Hierarchy()
+            : generation( -1 ) {
+        }
+
+        void build( const Soprano::Model* model, const QUrl& relation );
+
+        bool contains( const Soprano::Node& sub, const Soprano::Node& super ) const {
+            QHash<Soprano::Node, QSet<Soprano::Node> >::const_iterator it = supers.constFind( sub );
+            return it != supers.constEnd() && it.value().contains( super );
+        }
+
+        QList<Soprano::Statement> statements( const QUrl& relation, const Soprano::Node& sub, const Soprano::Node& super ) const;
+
+        /// the invalidation generation this hierarchy was built for
+        int generation;
+
+        /// maps each node to all its (transitive) super nodes
+        QHash<Soprano::Node, QSet<Soprano::Node> > supers;
+
+        /// maps each node to all its (transitive) sub nodes
+        QHash<Soprano::Node, QSet<Soprano::Node> > subs;
+    };
+
+
+    void Hierarchy::build( const Soprano::Model* model, const QUrl& relation )
+    {
+        supers.clear();
+        subs.clear();
+
+        QHash<Soprano::Node, QList<Soprano::Node> > direct;
+        Soprano::StatementIterator it = model->listStatements( Soprano::Node(), relation, Soprano::Node() );
+        while ( it.next() ) {
+            const Soprano::Statement s = *it;
+            direct[s.subject()].append( s.object() );
+        }
+
+        for ( QHash<Soprano::Node, QList<Soprano::Node> >::const_iterator dit = direct.constBegin();
+              dit != direct.constEnd(); ++dit ) {
+            QSet<Soprano::Node>& reachable = supers[dit.key()];
+            QList<Soprano::Node> stack = dit.value();
+            while ( !stack.isEmpty() ) {
+                const Soprano::Node node = stack.takeLast();
+                if ( !reachable.contains( node ) ) {
+                    reachable.insert( node );
+                    subs[node].insert( dit.key() );
+                    stack += direct.value( node );
+                }
+            }
+        }
+    }
+
+
+    QList<Soprano::Statement> Hierarchy::statements( const QUrl& relation, const Soprano::Node& sub, const Soprano::Node& super ) const
+    {
+        QList<Soprano::Statement> sl;
+        if ( sub.isValid() && super.isValid() ) {
+            if ( contains( sub, super ) ) {
+                sl.append( Soprano::Statement( sub, relation, super ) );
+            }
+        }
+        else if ( sub.isValid() ) {
+            Q_FOREACH( const Soprano::Node& node, supers.value( sub ) ) {
+                sl.append( Soprano::Statement( sub, relation, node ) );
+            }
+        }
+        else if ( super.isValid() ) {
+            Q_FOREACH( const Soprano::Node& node, subs.value( super ) ) {
+                sl.append( Soprano::Statement( node, relation, super ) );
+            }
+        }
+        else {
+            for ( QHash<Soprano::Node, QSet<Soprano::Node> >::const_iterator it = supers.constBegin();
+                  it != supers.constEnd(); ++it ) {
+                Q_FOREACH( const Soprano::Node& node, it.value() ) {
+                    sl.append( Soprano::Statement( it.key(), relation, node ) );
+                }
+            }
+        }
+        return sl;
+    }
+
+
+    /**
+     * Merges the results of several rdf:type listings into one iterator.
+     * Each listed type statement is expanded with the super classes of its
+     * object (or rewritten to the requested type), duplicates are dropped.
+     */
+    class TypeIteratorBackend : public Soprano::IteratorBackend<Soprano::Statement>
+    {
+    public:
+        TypeIteratorBackend( const Soprano::Model* model,
+                             const QList<Soprano::Statement>& patterns,
+                             const Soprano::Node& type,
+                             const QHash<Soprano::Node, QSet<Soprano::Node> >& supers )
+            : m_model( model ),
+              m_patterns( patterns ),
+              m_type( type ),
+              m_supers( supers ) {
+        }
+
+        bool next() {
+            clearError();
+            while ( 1 ) {
+                while ( !m_pending.isEmpty() ) {
+                    m_current = m_pending.takeFirst();
+                    if ( !m_seen.contains( m_current ) ) {
+                        m_seen.insert( m_current );
+                        return true;
+                    }
+                }
+
+                if ( m_it.isValid() ) {
+                    if ( m_it.next() ) {
+                        Soprano::Statement s = *m_it;
+                        if ( m_type.isValid() ) {
+                            s.setObject( m_type );
+                            m_pending.append( s );
+                        }
+                        else {
+                            m_pending.append( s );
+                            Q_FOREACH( const Soprano::Node& node, m_supers.value( s.object() ) ) {
+                                m_pending.append( Soprano::Statement( s.subject(), s.predicate(), node, s.context() ) );
+                            }
+                        }
+                    }
+                    else {
+                        const Soprano::Error::Error error = m_it.lastError();
+                        m_it = Soprano::StatementIterator();
+                        if ( error ) {
+                            setError( error );
+                            return false;
+                        }
+                    }
+                }
+                else if ( !m_patterns.isEmpty() ) {
+                    m_it = m_model->listStatements( m_patterns.takeFirst() );
+                    if ( !m_it.isValid() ) {
+                        setError( m_model->lastError() );
+                        return false;
+                    }
+                }
+                else {
+                    m_current = Soprano::Statement();
+                    return false;
+                }
+            }
+        }
+
+        Soprano::Statement current() const {
+            return m_current;
+        }
+
+        void close() {
+            m_it.close();
+            m_patterns.clear();
+            m_pending.clear();
+        }
+
+    private:
+        const Soprano::Model* m_model;
+        QList<Soprano::Statement> m_patterns;
+        Soprano::Node m_type;
+        QHash<Soprano::Node, QSet<Soprano::Node> > m_supers;
+
+        Soprano::StatementIterator m_it;
+        QList<Soprano::Statement> m_pending;
+        QSet<Soprano::Statement> m_seen;
+        Soprano::Statement m_current;
+    };
+}
 
 
 class Soprano::RdfSchemaModel::Private
 {
 public:
+    Private()
+        : generation( 0 ) {
+    }
+
+    /**
+     * Rebuilds \p h if it has been invalidated since it was last built.
+     * Has to be called with buildMutex locked.
+     */
+    void ensureHierarchy( Hierarchy& h, const QUrl& relation ) {
+        const int gen = currentGeneration();
+        if ( h.generation != gen ) {
+            h.build( q->parentModel(), relation );
+            h.generation = gen;
+        }
+    }
+
+    int currentGeneration() {
+        QMutexLocker lock( &generationMutex );
+        return generation;
+    }
+
+    void invalidate() {
+        QMutexLocker lock( &generationMutex );
+        ++generation;
+    }
+
+    /**
+     * Invalidates the hierarchies if \p statement (which may be a pattern)
+     * changes one of them.
+     */
+    void invalidate( const Statement& statement ) {
+        // an empty predicate is used by some backends to signal the removal of a whole graph
+        if ( statement.predicate().isEmpty() ||
+             statement.predicate() == Vocabulary::RDFS::subClassOf() ||
+             statement.predicate() == Vocabulary::RDFS::subPropertyOf() ) {
+            invalidate();
+        }
+    }
+
+    Hierarchy classHierarchy;
+    Hierarchy propertyHierarchy;
+
+    // protects the hierarchies while they are built and read
+    QMutex buildMutex;
+
+    // Protects the generation counter. This is separate from buildMutex since
+    // the parent may emit its signals while we are blocked reading from it.
+    QMutex generationMutex;
+    int generation;
+
+    Util::StatementSignalTracker addedTracker;
+    Util::StatementSignalTracker removedTracker;
+
+    RdfSchemaModel* q;
 };
 
 
@@ -37,6 +280,7 @@ Soprano::RdfSchemaModel::RdfSchemaModel( Model* model )
     : FilterModel( model ),
       d( new Private() )
 {
+    d->q = this;
 }
 
 
@@ -46,6 +290,38 @@ Soprano::RdfSchemaModel::~RdfSchemaModel()
 }
 
 
+void Soprano::RdfSchemaModel::setParentModel( Model* model )
+{
+    FilterModel::setParentModel( model );
+    d->invalidate();
+}
+
+
+Soprano::Error::ErrorCode Soprano::RdfSchemaModel::addStatement( const Statement& statement )
+{
+    // the parent does not necessarily emit signals
+    Error::ErrorCode r = FilterModel::addStatement( statement );
+    d->invalidate( statement );
+    return r;
+}
+
+
+Soprano::Error::ErrorCode Soprano::RdfSchemaModel::removeStatement( const Statement& statement )
+{
+    Error::ErrorCode r = FilterModel::removeStatement( statement );
+    d->invalidate( statement );
+    return r;
+}
+
+
+Soprano::Error::ErrorCode Soprano::RdfSchemaModel::removeAllStatements( const Statement& statement )
+{
+    Error::ErrorCode r = FilterModel::removeAllStatements( statement );
+    d->invalidate( statement );
+    return r;
+}
+
+
 Soprano::StatementIterator Soprano::RdfSchemaModel::classes() const
 {
     return parentModel()->listStatements( Statement( Node(), Vocabulary::RDF::type(), Vocabulary::RDFS::Class() ) );
@@ -90,22 +366,35 @@ Soprano::StatementIterator Soprano::RdfSchemaModel::range( const Node& prop, con
 
 Soprano::StatementIterator Soprano::RdfSchemaModel::subClassOf( const Node& subClass, const Node& superClass ) const
 {
-    // FIXME: do a recursive search for all subclasses. Problem: We cannot wrap multiple results in one iterator yet
-    return directSubClassOf( subClass, superClass );
+    QMutexLocker lock( &d->buildMutex );
+    d->ensureHierarchy( d->classHierarchy, Vocabulary::RDFS::subClassOf() );
+    return Util::SimpleStatementIterator( d->classHierarchy.statements( Vocabulary::RDFS::subClassOf(), subClass, superClass ) );
 }
 
 
 Soprano::StatementIterator Soprano::RdfSchemaModel::subPropertyOf( const Node& subProperty, const Node& superProperty ) const
 {
-    // FIXME: do a recursive search for all subproperties. Problem: We cannot wrap multiple results in one iterator yet
-    return directSubPropertyOf( subProperty, superProperty );
+    QMutexLocker lock( &d->buildMutex );
+    d->ensureHierarchy( d->propertyHierarchy, Vocabulary::RDFS::subPropertyOf() );
+    return Util::SimpleStatementIterator( d->propertyHierarchy.statements( Vocabulary::RDFS::subPropertyOf(), subProperty, superProperty ) );
 }
 
 
 Soprano::StatementIterator Soprano::RdfSchemaModel::type( const Node& someClass, const Node& someType ) const
 {
-    // FIXME: do a recursive search for all subtypes. Problem: We cannot wrap multiple results in one iterator yet
-    return directType( someClass, someType );
+    QMutexLocker lock( &d->buildMutex );
+    d->ensureHierarchy( d->classHierarchy, Vocabulary::RDFS::subClassOf() );
+
+    // an instance of any subclass of someType is also an instance of someType
+    QList<Statement> patterns;
+    patterns.append( Statement( someClass, Vocabulary::RDF::type(), someType ) );
+    if ( someType.isValid() ) {
+        Q_FOREACH( const Node& subClass, d->classHierarchy.subs.value( someType ) ) {
+            patterns.append( Statement( someClass, Vocabulary::RDF::type(), subClass ) );
+        }
+    }
+
+    return StatementIterator( new TypeIteratorBackend( parentModel(), patterns, someType, d->classHierarchy.supers ) );
 }
 
 
@@ -151,13 +440,17 @@ bool Soprano::RdfSchemaModel::isDirectType( const Node& someClass, const Node& s
 
 bool Soprano::RdfSchemaModel::isSubClassOf( const Node& subClass, const Node& superClass ) const
 {
-    return subClassOf( subClass, superClass ).next();
+    QMutexLocker lock( &d->buildMutex );
+    d->ensureHierarchy( d->classHierarchy, Vocabulary::RDFS::subClassOf() );
+    return d->classHierarchy.contains( subClass, superClass );
 }
 
 
 bool Soprano::RdfSchemaModel::isSubPropertyOf( const Node& subProperty, const Node& superProperty ) const
 {
-    return subPropertyOf( subProperty, superProperty ).next();
+    QMutexLocker lock( &d->buildMutex );
+    d->ensureHierarchy( d->propertyHierarchy, Vocabulary::RDFS::subPropertyOf() );
+    return d->propertyHierarchy.contains( subProperty, superProperty );
 }
 
 
@@ -165,3 +458,39 @@ bool Soprano::RdfSchemaModel::isType( const Node& someClass, const Node& someTyp
 {
     return type( someClass, someType ).next();
 }
+
+
+void Soprano::RdfSchemaModel::parentStatementsAdded()
+{
+    if ( d->addedTracker.summarySignal() ) {
+        // we do not know what has been added
+        d->invalidate();
+    }
+    FilterModel::parentStatementsAdded();
+}
+
+
+void Soprano::RdfSchemaModel::parentStatementsRemoved()
+{
+    if ( d->removedTracker.summarySignal() ) {
+        // we do not know what has been removed
+        d->invalidate();
+    }
+    FilterModel::parentStatementsRemoved();
+}
+
+
+void Soprano::RdfSchemaModel::parentStatementAdded( const Statement& statement )
+{
+    d->addedTracker.statementSignal();
+    d->invalidate( statement );
+    FilterModel::parentStatementAdded( statement );
+}
+
+
+void Soprano::RdfSchemaModel::parentStatementRemoved( const Statement& statement )
+{
+    d->removedTracker.statementSignal();
+    d->invalidate( statement );
+    FilterModel::parentStatementRemoved( statement );
+}
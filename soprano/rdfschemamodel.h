@@ -38,8 +38,11 @@ namespace Soprano {
      *
      * Interface based on Sesame's RdfSchemaSource. (Copyright (C) 2002-2006 Aduna BV, GNU LGPL License applies.)
      *
-     * \warning Backward inferencing has not been implemented yet. Thus, methods like subClassOf() return the same
-     * as directSubClassOf().
+     * The transitive subClassOf and subPropertyOf hierarchies are computed once and cached
+     * in closure tables. The cache is invalidated whenever rdfs:subClassOf or rdfs:subPropertyOf
+     * statements are added to or removed from the parent model, be it through this model or, if the
+     * parent emits statement signals, directly. Thus, methods like isSubClassOf() are cheap enough
+     * to be used in tight loops.
      *
      * \author Sebastian Trueg <trueg@kde.org>
      */
@@ -283,6 +286,58 @@ namespace Soprano {
          */
         bool isType( const Node& someClass, const Node& someType ) const;
 
+        /**
+         * Reimplemented to invalidate the cached class and property hierarchies.
+         */
+        void setParentModel( Model* model );
+
+        /**
+         * Reimplemented to invalidate the cached hierarchies if \p statement
+         * is an rdfs:subClassOf or rdfs:subPropertyOf statement.
+         */
+        Error::ErrorCode addStatement( const Statement& statement );
+
+        /**
+         * Reimplemented to invalidate the cached hierarchies if \p statement
+         * is an rdfs:subClassOf or rdfs:subPropertyOf statement.
+         */
+        Error::ErrorCode removeStatement( const Statement& statement );
+
+        /**
+         * Reimplemented to invalidate the cached hierarchies if \p statement
+         * matches rdfs:subClassOf or rdfs:subPropertyOf statements.
+         */
+        Error::ErrorCode removeAllStatements( const Statement& statement );
+
+        using FilterModel::addStatement;
+        using FilterModel::removeStatement;
+        using FilterModel::removeAllStatements;
+
+    protected:
+        /**
+         * Invalidates the cached hierarchies if no per-statement signal
+         * told us which statements were added.
+         */
+        void parentStatementsAdded();
+
+        /**
+         * Invalidates the cached hierarchies if no per-statement signal
+         * told us which statements were removed.
+         */
+        void parentStatementsRemoved();
+
+        /**
+         * Invalidates the cached hierarchies if \p statement is
+         * an rdfs:subClassOf or rdfs:subPropertyOf statement.
+         */
+        void parentStatementAdded( const Statement& statement );
+
+        /**
+         * Invalidates the cached hierarchies if \p statement is
+         * an rdfs:subClassOf or rdfs:subPropertyOf statement.
+         */
+        void parentStatementRemoved( const Statement& statement );
+
     private:
         class Private;
         Private* const d;
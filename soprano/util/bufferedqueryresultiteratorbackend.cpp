@@ -0,0 +1,167 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "bufferedqueryresultiteratorbackend.h"
+#include "node.h"
+
+
+Soprano::Util::QueryResultBuffer::QueryResultBuffer()
+    : isGraph( false ),
+      isBool( false ),
+      boolValue( false )
+{
+}
+
+
+bool Soprano::Util::QueryResultBuffer::read( QueryResultIterator& it, int maxRows )
+{
+    isGraph = it.isGraph();
+    isBool = it.isBool();
+    bindingNames = it.bindingNames();
+    if ( isBool ) {
+        boolValue = it.boolValue();
+        return !it.lastError();
+    }
+
+    while ( maxRows < 0 || bindings.count() < maxRows ) {
+        if ( !it.next() ) {
+            return !it.lastError();
+        }
+        bindings.append( it.current() );
+        if ( isGraph ) {
+            statements.append( it.currentStatement() );
+        }
+    }
+    return false;
+}
+
+
+Soprano::Util::BufferedQueryResultIteratorBackend::BufferedQueryResultIteratorBackend( const QueryResultBuffer& result,
+                                                                                      const QueryResultIterator& tail )
+    : m_result( result ),
+      m_pos( -1 ),
+      m_tail( tail )
+{
+}
+
+
+Soprano::Util::BufferedQueryResultIteratorBackend::~BufferedQueryResultIteratorBackend()
+{
+}
+
+
+bool Soprano::Util::BufferedQueryResultIteratorBackend::next()
+{
+    clearError();
+    if ( m_result.isBool ) {
+        return false;
+    }
+    if ( m_pos < m_result.bindings.count() ) {
+        ++m_pos;
+    }
+    if ( m_pos < m_result.bindings.count() ) {
+        return true;
+    }
+    else if ( m_tail.isValid() ) {
+        bool r = m_tail.next();
+        setError( m_tail.lastError() );
+        return r;
+    }
+    return false;
+}
+
+
+Soprano::BindingSet Soprano::Util::BufferedQueryResultIteratorBackend::current() const
+{
+    if ( m_pos < m_result.bindings.count() ) {
+        return m_result.bindings[m_pos];
+    }
+    else {
+        return m_tail.current();
+    }
+}
+
+
+void Soprano::Util::BufferedQueryResultIteratorBackend::close()
+{
+    m_pos = m_result.bindings.count();
+    m_tail.close();
+}
+
+
+Soprano::Statement Soprano::Util::BufferedQueryResultIteratorBackend::currentStatement() const
+{
+    if ( m_pos < m_result.statements.count() ) {
+        return m_result.statements[m_pos];
+    }
+    else if ( m_pos >= m_result.bindings.count() ) {
+        return m_tail.currentStatement();
+    }
+    return Statement();
+}
+
+
+Soprano::Node Soprano::Util::BufferedQueryResultIteratorBackend::binding( const QString &name ) const
+{
+    return current()[name];
+}
+
+
+Soprano::Node Soprano::Util::BufferedQueryResultIteratorBackend::binding( int offset ) const
+{
+    return current()[offset];
+}
+
+
+int Soprano::Util::BufferedQueryResultIteratorBackend::bindingCount() const
+{
+    return m_result.bindingNames.count();
+}
+
+
+QStringList Soprano::Util::BufferedQueryResultIteratorBackend::bindingNames() const
+{
+    return m_result.bindingNames;
+}
+
+
+bool Soprano::Util::BufferedQueryResultIteratorBackend::isGraph() const
+{
+    return m_result.isGraph;
+}
+
+
+bool Soprano::Util::BufferedQueryResultIteratorBackend::isBinding() const
+{
+    return !m_result.isGraph && !m_result.isBool;
+}
+
+
+bool Soprano::Util::BufferedQueryResultIteratorBackend::isBool() const
+{
+    return m_result.isBool;
+}
+
+
+bool Soprano::Util::BufferedQueryResultIteratorBackend::boolValue() const
+{
+    return m_result.boolValue;
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _SOPRANO_BUFFERED_QUERY_RESULT_ITERATOR_BACKEND_H_
+#define _SOPRANO_BUFFERED_QUERY_RESULT_ITERATOR_BACKEND_H_
+
+#include "queryresultiteratorbackend.h"
+#include "queryresultiterator.h"
+#include "bindingset.h"
+#include "statement.h"
+
+#include <QtCore/QList>
+#include <QtCore/QStringList>
+
+namespace Soprano {
+    namespace Util {
+        /**
+         * An in-memory copy of a query result.
+         */
+        class QueryResultBuffer
+        {
+        public:
+            QueryResultBuffer();
+
+            /**
+             * Reads the result type and at most \p maxRows rows from \p it. A negative
+             * value reads the complete result.
+             *
+             * \return \p true if the complete result has been read, \p false if
+             * \p it has more rows or an error occurred.
+             */
+            bool read( QueryResultIterator& it, int maxRows = -1 );
+
+            bool isGraph;
+            bool isBool;
+            bool boolValue;
+            QStringList bindingNames;
+            QList<BindingSet> bindings;
+            QList<Statement> statements;
+        };
+
+        /**
+         * Iterates over a buffered query result first and continues with
+         * \p tail if given. The tail is used for results which have only been
+         * partially buffered.
+         */
+        class BufferedQueryResultIteratorBackend : public QueryResultIteratorBackend
+        {
+        public:
+            BufferedQueryResultIteratorBackend( const QueryResultBuffer& result,
+                                                const QueryResultIterator& tail = QueryResultIterator() );
+            ~BufferedQueryResultIteratorBackend();
+
+            bool next();
+            BindingSet current() const;
+            void close();
+            Statement currentStatement() const;
+            Node binding( const QString &name ) const;
+            Node binding( int offset ) const;
+            int bindingCount() const;
+            QStringList bindingNames() const;
+            bool isGraph() const;
+            bool isBinding() const;
+            bool isBool() const;
+            bool boolValue() const;
+
+        private:
+            QueryResultBuffer m_result;
+            int m_pos;
+            QueryResultIterator m_tail;
+        };
+    }
+}
+
+#endif
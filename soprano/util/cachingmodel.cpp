@@ -0,0 +1,472 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "cachingmodel.h"
+#include "statementiterator.h"
+#include "queryresultiterator.h"
+#include "bufferedqueryresultiteratorbackend.h"
+#include "iteratorbackend.h"
+#include "bindingset.h"
+#include "statementsignaltracker.h"
+
+#include <QtCore/QCache>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QRegExp>
+
+
+namespace {
+    /**
+     * Patterns overlap if there could be a statement matching both,
+     * i.e. empty nodes are wildcards on both sides.
+     */
+    bool nodesOverlap( const Soprano::Node& n1, const Soprano::Node& n2 )
+    {
+        return n1.isEmpty() || n2.isEmpty() || n1 == n2;
+    }
+
+    bool patternsOverlap( const Soprano::Statement& s1, const Soprano::Statement& s2 )
+    {
+        return( nodesOverlap( s1.subject(), s2.subject() ) &&
+                nodesOverlap( s1.predicate(), s2.predicate() ) &&
+                nodesOverlap( s1.object(), s2.object() ) &&
+                nodesOverlap( s1.context(), s2.context() ) );
+    }
+
+    template<class T> void removeOverlapping( QCache<Soprano::Statement, T>& cache, const Soprano::Statement& statement )
+    {
+        Q_FOREACH( const Soprano::Statement& pattern, cache.keys() ) {
+            if ( patternsOverlap( pattern, statement ) ) {
+                cache.remove( pattern );
+            }
+        }
+    }
+
+
+    /**
+     * Only read-only SPARQL queries can be cached. Updates and unknown
+     * query languages have to reach the parent model each time.
+     */
+    bool isCacheableQuery( const QString& query, Soprano::Query::QueryLanguage language )
+    {
+        if ( language != Soprano::Query::QueryLanguageSparql &&
+             language != Soprano::Query::QueryLanguageSparqlNoInference ) {
+            return false;
+        }
+
+        // skip comments and the prologue to find the query form
+        QRegExp queryFormRx( QLatin1String( "^(?:\\s|#[^\\n]*|base\\s*<[^>]*>|prefix\\s*[^\\s:]*\\s*:\\s*<[^>]*>)*"
+                                            "(select|ask|construct|describe)\\b" ),
+                             Qt::CaseInsensitive );
+        return queryFormRx.indexIn( query ) == 0;
+    }
+
+
+    /**
+     * Iterates over the buffered statements first and continues with
+     * \p tail. The tail is used for results which are too large for the cache.
+     */
+    class CachedStatementIteratorBackend : public Soprano::IteratorBackend<Soprano::Statement>
+    {
+    public:
+        CachedStatementIteratorBackend( const QList<Soprano::Statement>& statements,
+                                        const Soprano::StatementIterator& tail = Soprano::StatementIterator() )
+            : m_statements( statements ),
+              m_pos( -1 ),
+              m_tail( tail ) {
+        }
+
+        bool next() {
+            clearError();
+            if ( m_pos < m_statements.count() ) {
+                ++m_pos;
+            }
+            if ( m_pos < m_statements.count() ) {
+                return true;
+            }
+            else if ( m_tail.isValid() ) {
+                bool r = m_tail.next();
+                setError( m_tail.lastError() );
+                return r;
+            }
+            return false;
+        }
+
+        Soprano::Statement current() const {
+            if ( m_pos < m_statements.count() ) {
+                return m_statements[m_pos];
+            }
+            else {
+                return m_tail.current();
+            }
+        }
+
+        void close() {
+            m_pos = m_statements.count();
+            m_tail.close();
+        }
+
+    private:
+        QList<Soprano::Statement> m_statements;
+        int m_pos;
+        Soprano::StatementIterator m_tail;
+    };
+}
+
+
+class Soprano::Util::CachingModel::Private
+{
+public:
+    Private()
+        : statementCount( -1 ),
+          generation( 0 ),
+          cacheHits( 0 ),
+          cacheMisses( 0 ) {
+        setCacheSize( 100000 );
+    }
+
+    void setCacheSize( int size ) {
+        listCache.setMaxCost( size );
+        containsCache.setMaxCost( size );
+        queryCache.setMaxCost( size );
+        maxResultSize = size;
+    }
+
+    /// Has to be called with mutex locked
+    void clear() {
+        ++generation;
+        listCache.clear();
+        containsCache.clear();
+        statementCount = -1;
+        queryCache.clear();
+    }
+
+    /// Has to be called with mutex locked
+    void invalidate( const Statement& statement ) {
+        ++generation;
+        removeOverlapping( listCache, statement );
+        removeOverlapping( containsCache, statement );
+        statementCount = -1;
+        queryCache.clear();
+    }
+
+    QCache<Statement, QList<Statement> > listCache;
+    QCache<Statement, bool> containsCache;
+    QCache<QString, QueryResultBuffer> queryCache;
+
+    // there is only one statement count, -1 if not cached
+    int statementCount;
+
+    int maxResultSize;
+
+    // Protects all of the above. Never held while calling the parent model to
+    // avoid a deadlock with parent models which emit signals with a lock held.
+    QMutex mutex;
+
+    // incremented with each invalidation to detect changes while a result is read
+    int generation;
+
+    StatementSignalTracker addedTracker;
+    StatementSignalTracker removedTracker;
+
+    qint64 cacheHits;
+    qint64 cacheMisses;
+};
+
+
+Soprano::Util::CachingModel::CachingModel( Model* parent )
+    : FilterModel( parent ),
+      d( new Private() )
+{
+}
+
+
+Soprano::Util::CachingModel::~CachingModel()
+{
+    delete d;
+}
+
+
+void Soprano::Util::CachingModel::setCacheSize( int size )
+{
+    QMutexLocker lock( &d->mutex );
+    d->setCacheSize( qMax( 0, size ) );
+}
+
+
+int Soprano::Util::CachingModel::cacheSize() const
+{
+    QMutexLocker lock( &d->mutex );
+    return d->maxResultSize;
+}
+
+
+void Soprano::Util::CachingModel::clearCache()
+{
+    QMutexLocker lock( &d->mutex );
+    d->clear();
+}
+
+
+qint64 Soprano::Util::CachingModel::cacheHits() const
+{
+    QMutexLocker lock( &d->mutex );
+    return d->cacheHits;
+}
+
+
+qint64 Soprano::Util::CachingModel::cacheMisses() const
+{
+    QMutexLocker lock( &d->mutex );
+    return d->cacheMisses;
+}
+
+
+void Soprano::Util::CachingModel::resetStatistics()
+{
+    QMutexLocker lock( &d->mutex );
+    d->cacheHits = 0;
+    d->cacheMisses = 0;
+}
+
+
+void Soprano::Util::CachingModel::setParentModel( Model* model )
+{
+    FilterModel::setParentModel( model );
+    clearCache();
+}
+
+
+Soprano::Error::ErrorCode Soprano::Util::CachingModel::addStatement( const Statement& statement )
+{
+    // the parent model might not emit any signals
+    Error::ErrorCode r = FilterModel::addStatement( statement );
+    QMutexLocker lock( &d->mutex );
+    d->invalidate( statement );
+    return r;
+}
+
+
+Soprano::Error::ErrorCode Soprano::Util::CachingModel::removeStatement( const Statement& statement )
+{
+    Error::ErrorCode r = FilterModel::removeStatement( statement );
+    QMutexLocker lock( &d->mutex );
+    d->invalidate( statement );
+    return r;
+}
+
+
+Soprano::Error::ErrorCode Soprano::Util::CachingModel::removeAllStatements( const Statement& statement )
+{
+    Error::ErrorCode r = FilterModel::removeAllStatements( statement );
+    QMutexLocker lock( &d->mutex );
+    d->invalidate( statement );
+    return r;
+}
+
+
+Soprano::StatementIterator Soprano::Util::CachingModel::listStatements( const Statement& partial ) const
+{
+    int generation = 0;
+    int maxResultSize = 0;
+    {
+        QMutexLocker lock( &d->mutex );
+        if ( QList<Statement>* cached = d->listCache.object( partial ) ) {
+            ++d->cacheHits;
+            clearError();
+            return new CachedStatementIteratorBackend( *cached );
+        }
+        ++d->cacheMisses;
+        generation = d->generation;
+        maxResultSize = d->maxResultSize;
+    }
+
+    StatementIterator it = FilterModel::listStatements( partial );
+    if ( !it.isValid() ) {
+        return it;
+    }
+
+    // read the complete result unless it is too large for the cache
+    QList<Statement> statements;
+    while ( statements.count() < maxResultSize ) {
+        if ( !it.next() ) {
+            if ( it.lastError() ) {
+                setError( it.lastError() );
+                return StatementIterator();
+            }
+            QMutexLocker lock( &d->mutex );
+            if ( d->generation == generation ) {
+                d->listCache.insert( partial, new QList<Statement>( statements ), statements.count() + 1 );
+            }
+            return new CachedStatementIteratorBackend( statements );
+        }
+        statements.append( *it );
+    }
+
+    return new CachedStatementIteratorBackend( statements, it );
+}
+
+
+Soprano::QueryResultIterator Soprano::Util::CachingModel::executeQuery( const QString& query, Query::QueryLanguage language, const QString& userQueryLanguage ) const
+{
+    if ( !isCacheableQuery( query, language ) ) {
+        // updates do not necessarily result in signals
+        QueryResultIterator it = FilterModel::executeQuery( query, language, userQueryLanguage );
+        QMutexLocker lock( &d->mutex );
+        d->clear();
+        return it;
+    }
+
+    const QString key = Query::queryLanguageToString( language, userQueryLanguage ) + QLatin1Char( '\n' ) + query;
+
+    int generation = 0;
+    int maxResultSize = 0;
+    {
+        QMutexLocker lock( &d->mutex );
+        if ( QueryResultBuffer* cached = d->queryCache.object( key ) ) {
+            ++d->cacheHits;
+            clearError();
+            return new BufferedQueryResultIteratorBackend( *cached );
+        }
+        ++d->cacheMisses;
+        generation = d->generation;
+        maxResultSize = d->maxResultSize;
+    }
+
+    QueryResultIterator it = FilterModel::executeQuery( query, language, userQueryLanguage );
+    if ( !it.isValid() ) {
+        return it;
+    }
+
+    // read the complete result unless it is too large for the cache
+    QueryResultBuffer result;
+    if ( !result.read( it, maxResultSize ) ) {
+        if ( it.lastError() ) {
+            setError( it.lastError() );
+            return QueryResultIterator();
+        }
+        return new BufferedQueryResultIteratorBackend( result, it );
+    }
+
+    {
+        QMutexLocker lock( &d->mutex );
+        if ( d->generation == generation ) {
+            d->queryCache.insert( key, new QueryResultBuffer( result ), result.bindings.count() + 1 );
+        }
+    }
+    return new BufferedQueryResultIteratorBackend( result );
+}
+
+
+bool Soprano::Util::CachingModel::containsAnyStatement( const Statement& statement ) const
+{
+    int generation = 0;
+    {
+        QMutexLocker lock( &d->mutex );
+        if ( bool* cached = d->containsCache.object( statement ) ) {
+            ++d->cacheHits;
+            clearError();
+            return *cached;
+        }
+        ++d->cacheMisses;
+        generation = d->generation;
+    }
+
+    bool r = FilterModel::containsAnyStatement( statement );
+    if ( !lastError() ) {
+        QMutexLocker lock( &d->mutex );
+        if ( d->generation == generation ) {
+            d->containsCache.insert( statement, new bool( r ) );
+        }
+    }
+    return r;
+}
+
+
+int Soprano::Util::CachingModel::statementCount() const
+{
+    int generation = 0;
+    {
+        QMutexLocker lock( &d->mutex );
+        if ( d->statementCount >= 0 ) {
+            ++d->cacheHits;
+            clearError();
+            return d->statementCount;
+        }
+        ++d->cacheMisses;
+        generation = d->generation;
+    }
+
+    int r = FilterModel::statementCount();
+    if ( r >= 0 ) {
+        QMutexLocker lock( &d->mutex );
+        if ( d->generation == generation ) {
+            d->statementCount = r;
+        }
+    }
+    return r;
+}
+
+
+void Soprano::Util::CachingModel::parentStatementsAdded()
+{
+    if ( d->addedTracker.summarySignal() ) {
+        // we do not know what has been added
+        QMutexLocker lock( &d->mutex );
+        d->clear();
+    }
+    FilterModel::parentStatementsAdded();
+}
+
+
+void Soprano::Util::CachingModel::parentStatementsRemoved()
+{
+    if ( d->removedTracker.summarySignal() ) {
+        // we do not know what has been removed
+        QMutexLocker lock( &d->mutex );
+        d->clear();
+    }
+    FilterModel::parentStatementsRemoved();
+}
+
+
+void Soprano::Util::CachingModel::parentStatementAdded( const Statement& statement )
+{
+    d->addedTracker.statementSignal();
+    {
+        QMutexLocker lock( &d->mutex );
+        d->invalidate( statement );
+    }
+    FilterModel::parentStatementAdded( statement );
+}
+
+
+void Soprano::Util::CachingModel::parentStatementRemoved( const Statement& statement )
+{
+    d->removedTracker.statementSignal();
+    {
+        QMutexLocker lock( &d->mutex );
+        d->invalidate( statement );
+    }
+    FilterModel::parentStatementRemoved( statement );
+}
+
+#include "moc_cachingmodel.cpp"
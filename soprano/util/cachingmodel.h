@@ -0,0 +1,188 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _SOPRANO_CACHING_MODEL_H_
+#define _SOPRANO_CACHING_MODEL_H_
+
+#include "filtermodel.h"
+#include "soprano_export.h"
+
+namespace Soprano {
+    namespace Util {
+        /**
+         * \class CachingModel cachingmodel.h Soprano/Util/CachingModel
+         *
+         * \brief Caches the results of read operations on a model which changes rarely.
+         *
+         * CachingModel remembers the results of executeQuery(), listStatements(),
+         * containsAnyStatement(), and statementCount() and answers identical calls from
+         * the cache. Queries are identified by their text and language, all other
+         * operations by their pattern. Only read-only SPARQL queries (select, ask,
+         * construct, and describe) are cached. All other queries, including SPARQL
+         * updates and user query languages, are always passed on to the parent model.
+         *
+         * The cache is invalidated whenever the parent model signals a change and whenever
+         * statements are added or removed through the CachingModel itself. The latter also
+         * works for parent models which do not emit signals. Executing a query which is not
+         * cached clears the whole cache since it might have changed the data. Changes made
+         * to the parent model directly are only noticed through its signals. Cached
+         * statement patterns are only dropped if they match an added or removed statement.
+         * Query results are always dropped since there is no way to know which statements
+         * a query depends on. If the parent model only emits Model::statementsAdded() or
+         * Model::statementsRemoved() without the statements involved the whole cache is
+         * cleared.
+         *
+         * The memory used by the cache is limited by cacheSize(). Results which are larger
+         * than the cache are not cached but streamed from the parent model as usual.
+         *
+         * CachingModel is thread-safe as long as the parent model is.
+         *
+         * \since 2.10
+         */
+        class SOPRANO_EXPORT CachingModel : public FilterModel
+        {
+            Q_OBJECT
+
+        public:
+            /**
+             * Create a new CachingModel.
+             *
+             * \param parent The parent Model to forward
+             *        the actual calls to.
+             */
+            CachingModel( Model* parent = 0 );
+
+            /**
+             * Destructor.
+             */
+            virtual ~CachingModel();
+
+            /**
+             * Set the maximum number of cached result rows, i.e. statements, binding sets,
+             * or single values. The default is 100000.
+             */
+            void setCacheSize( int size );
+
+            /**
+             * \sa setCacheSize
+             */
+            int cacheSize() const;
+
+            /**
+             * Drop all cached results.
+             */
+            void clearCache();
+
+            /**
+             * The number of calls which have been answered from the cache since
+             * the last call to resetStatistics().
+             */
+            qint64 cacheHits() const;
+
+            /**
+             * The number of calls which have been forwarded to the parent model since
+             * the last call to resetStatistics().
+             */
+            qint64 cacheMisses() const;
+
+            /**
+             * Reset cacheHits() and cacheMisses() to 0.
+             */
+            void resetStatistics();
+
+            /**
+             * Reimplemented to clear the cache.
+             */
+            void setParentModel( Model* model );
+
+            /**
+             * Reimplemented to invalidate the cached results affected by \p statement.
+             */
+            Error::ErrorCode addStatement( const Statement& statement );
+
+            /**
+             * Reimplemented to invalidate the cached results affected by \p statement.
+             */
+            Error::ErrorCode removeStatement( const Statement& statement );
+
+            /**
+             * Reimplemented to invalidate the cached results affected by \p statement.
+             */
+            Error::ErrorCode removeAllStatements( const Statement& statement );
+
+            /**
+             * Returns the cached statements matching \p partial if available.
+             */
+            StatementIterator listStatements( const Statement& partial ) const;
+
+            /**
+             * Returns the cached result of \p query if available. Only read-only
+             * SPARQL queries are cached, all other queries are passed on to the
+             * parent model and clear the cache.
+             */
+            QueryResultIterator executeQuery( const QString& query, Query::QueryLanguage language, const QString& userQueryLanguage = QString() ) const;
+
+            /**
+             * Returns the cached result for \p statement if available.
+             */
+            bool containsAnyStatement( const Statement& statement ) const;
+
+            /**
+             * Returns the cached statement count if available.
+             */
+            int statementCount() const;
+
+            using FilterModel::addStatement;
+            using FilterModel::removeStatement;
+            using FilterModel::removeAllStatements;
+            using FilterModel::listStatements;
+            using FilterModel::containsAnyStatement;
+            using FilterModel::containsStatement;
+
+        protected:
+            /**
+             * Reimplemented to invalidate the cache.
+             */
+            virtual void parentStatementsAdded();
+
+            /**
+             * Reimplemented to invalidate the cache.
+             */
+            virtual void parentStatementsRemoved();
+
+            /**
+             * Reimplemented to invalidate the cached results affected by \p statement.
+             */
+            virtual void parentStatementAdded( const Statement& statement );
+
+            /**
+             * Reimplemented to invalidate the cached results affected by \p statement.
+             */
+            virtual void parentStatementRemoved( const Statement& statement );
+
+        private:
+            class Private;
+            Private* const d;
+        };
+    }
+}
+
+#endif
@@ -25,6 +25,9 @@
 #include "mutexstatementiteratorbackend.h"
 #include "mutexnodeiteratorbackend.h"
 #include "mutexqueryresultiteratorbackend.h"
+#include "bufferedqueryresultiteratorbackend.h"
+#include "simplestatementiterator.h"
+#include "simplenodeiterator.h"
 
 #include "statementiterator.h"
 #include "nodeiterator.h"
@@ -48,6 +51,7 @@ public:
             m_mutex.lock();
             break;
         case ReadWriteMultiThreading:
+        case SnapshotMultiThreading:
             m_msLock.lockForWrite();
             break;
         case ReadWriteSingleThreading:
@@ -62,6 +66,7 @@ public:
             m_mutex.lock();
             break;
         case ReadWriteMultiThreading:
+        case SnapshotMultiThreading:
             m_msLock.lockForRead();
             break;
         case ReadWriteSingleThreading:
@@ -69,12 +74,17 @@ public:
         }
     }
 
+    bool snapshotIterators() const {
+        return m_protectionMode == SnapshotMultiThreading;
+    }
+
     void unlock() {
         switch( m_protectionMode ) {
         case PlainMultiThreading:
             m_mutex.unlock();
             break;
         case ReadWriteMultiThreading:
+        case SnapshotMultiThreading:
             m_msLock.unlock();
             break;
         case ReadWriteSingleThreading:
@@ -139,7 +149,21 @@ Soprano::StatementIterator Soprano::Util::MutexModel::listStatements( const Stat
 {
     d->lockForRead();
     StatementIterator it = FilterModel::listStatements( partial );
-    if ( it.isValid() ) {
+    if ( it.isValid() && d->snapshotIterators() ) {
+        QList<Statement> sl;
+        while ( it.next() ) {
+            sl.append( *it );
+        }
+        Error::Error error = it.lastError();
+        it.close();
+        d->unlock();
+        if ( error ) {
+            setError( error );
+            return StatementIterator();
+        }
+        return SimpleStatementIterator( sl );
+    }
+    else if ( it.isValid() ) {
         MutexStatementIteratorBackend* b = new MutexStatementIteratorBackend( it, const_cast<MutexModel*>( this ) );
         d->openIterators.append( b );
         return b;
@@ -155,7 +179,21 @@ Soprano::NodeIterator Soprano::Util::MutexModel::listContexts() const
 {
     d->lockForRead();
     NodeIterator it = FilterModel::listContexts();
-    if ( it.isValid() ) {
+    if ( it.isValid() && d->snapshotIterators() ) {
+        QList<Node> nodes;
+        while ( it.next() ) {
+            nodes.append( *it );
+        }
+        Error::Error error = it.lastError();
+        it.close();
+        d->unlock();
+        if ( error ) {
+            setError( error );
+            return NodeIterator();
+        }
+        return SimpleNodeIterator( nodes );
+    }
+    else if ( it.isValid() ) {
         MutexNodeIteratorBackend* b = new MutexNodeIteratorBackend( it, const_cast<MutexModel*>( this ) );
         d->openIterators.append( b );
         return b;
@@ -173,7 +211,19 @@ Soprano::QueryResultIterator Soprano::Util::MutexModel::executeQuery( const QStr
 {
     d->lockForRead();
     QueryResultIterator it = FilterModel::executeQuery( query, language, userQueryLanguage );
-    if ( it.isValid() ) {
+    if ( it.isValid() && d->snapshotIterators() ) {
+        QueryResultBuffer result;
+        bool success = result.read( it );
+        Error::Error error = it.lastError();
+        it.close();
+        d->unlock();
+        if ( !success ) {
+            setError( error );
+            return QueryResultIterator();
+        }
+        return new BufferedQueryResultIteratorBackend( result );
+    }
+    else if ( it.isValid() ) {
         MutexQueryResultIteratorBackend* b = new MutexQueryResultIteratorBackend( it, const_cast<MutexModel*>( this ) );
         d->openIterators.append( b );
         return b;
@@ -70,7 +70,23 @@ namespace Soprano {
                  * \deprecated This was a buggy mode which was impossible to fix.
                  * Use Soprano::Util::AsyncModel instead.
                  */
-                ReadWriteSingleThreading
+                ReadWriteSingleThreading,
+
+                /**
+                 * In SnapshotMultiThreading mode locking is the same as in
+                 * ReadWriteMultiThreading mode. However, iterators do not keep
+                 * the read lock. Instead the complete result is read into memory
+                 * and the lock is released before the iterator is returned.
+                 * Thus, slow consumers of iterators never block write operations
+                 * and nesting iterators is always safe.
+                 *
+                 * Iterators see a consistent snapshot of the model at the time
+                 * they have been created. The downside is the memory needed to
+                 * hold large results.
+                 *
+                 * \since 2.10
+                 */
+                SnapshotMultiThreading
             };
 
             /**
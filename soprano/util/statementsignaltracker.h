@@ -0,0 +1,75 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef _SOPRANO_STATEMENT_SIGNAL_TRACKER_H_
+#define _SOPRANO_STATEMENT_SIGNAL_TRACKER_H_
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+
+namespace Soprano {
+    namespace Util {
+        /**
+         * Helps filter models with caches to decide if a Model::statementsAdded
+         * or Model::statementsRemoved signal needs to clear the whole cache.
+         *
+         * Models emit the per-statement signals and then the summary signal in
+         * the thread performing the write. The tracker counts the per-statement
+         * signals per thread, so writers on different threads do not interfere.
+         * Only if the thread emitting the summary signal reported at least one
+         * statement since its last summary signal the cache can rely on the
+         * per-statement invalidation. In all other cases it has to assume that
+         * anything changed.
+         *
+         * Use one tracker for additions and one for removals.
+         */
+        class StatementSignalTracker
+        {
+        public:
+            /**
+             * Call for each Model::statementAdded or Model::statementRemoved signal.
+             */
+            void statementSignal() {
+                QMutexLocker lock( &m_mutex );
+                ++m_counts[QThread::currentThreadId()];
+            }
+
+            /**
+             * Call for each Model::statementsAdded or Model::statementsRemoved signal.
+             *
+             * \return \p true if the whole cache needs to be cleared.
+             */
+            bool summarySignal() {
+                QMutexLocker lock( &m_mutex );
+                return m_counts.take( QThread::currentThreadId() ) == 0;
+            }
+
+        private:
+            QMutex m_mutex;
+            QHash<Qt::HANDLE, int> m_counts;
+        };
+    }
+}
+
+#endif
@@ -23,8 +23,17 @@
 
 #include "soprano.h"
 
+#include <QtCore/QDate>
+
 using namespace Soprano;
 
+namespace {
+    QUrl cacheTestUri( const QString& name )
+    {
+        return QUrl( QLatin1String( "http://soprano.sf.net/test/cache#" ) + name );
+    }
+}
+
 
 Soprano::Model* RedlandMemoryModelTest::createModel()
 {
@@ -37,6 +46,156 @@ Soprano::Model* RedlandMemoryModelTest::createModel()
     return b->createModel();
 }
 
+
+void RedlandMemoryModelTest::testNodeCache()
+{
+    // resources, datatypes, and language tags all go through the node caches
+    QList<Statement> statements;
+    statements << Statement( cacheTestUri( "A" ), cacheTestUri( "value" ), LiteralValue( 42 ) )
+               << Statement( cacheTestUri( "A" ), cacheTestUri( "label" ), LiteralValue::createPlainLiteral( QLatin1String( "Hallo" ), QLatin1String( "de" ) ) )
+               << Statement( cacheTestUri( "B" ), cacheTestUri( "value" ), LiteralValue( QDate( 2026, 10, 19 ) ) )
+               << Statement( cacheTestUri( "B" ), cacheTestUri( "link" ), cacheTestUri( "A" ) );
+
+    // the cached nodes outlive the statements and models they were created for
+    for ( int round = 0; round < 3; ++round ) {
+        QCOMPARE( m_model->addStatements( statements ), Error::ErrorNone );
+        Q_FOREACH( const Statement& s, statements ) {
+            QVERIFY( m_model->containsStatement( s ) );
+            QList<Statement> listed = m_model->listStatements( s.subject(), s.predicate(), Node() ).allStatements();
+            QCOMPARE( listed.count(), 1 );
+            QCOMPARE( listed.first(), s );
+            QCOMPARE( listed.first().object().dataType(), s.object().dataType() );
+        }
+
+        QCOMPARE( m_model->removeStatements( statements ), Error::ErrorNone );
+        Q_FOREACH( const Statement& s, statements ) {
+            QVERIFY( !m_model->containsAnyStatement( s ) );
+        }
+
+        deleteModel( m_model );
+        m_model = createModel();
+        QVERIFY( m_model );
+    }
+}
+
+
+void RedlandMemoryModelTest::testNodeCacheEviction()
+{
+    // more resources than the caches keep
+    const int count = 12000;
+    QList<Statement> statements;
+    for ( int i = 0; i < count; ++i ) {
+        statements << Statement( cacheTestUri( QString::fromLatin1( "R%1" ).arg( i ) ), cacheTestUri( "value" ), LiteralValue( i ) );
+    }
+    QCOMPARE( m_model->addStatements( statements ), Error::ErrorNone );
+
+    // evicted and cached resources are converted alike
+    int found = 0;
+    StatementIterator it = m_model->listStatements( Node(), cacheTestUri( "value" ), Node() );
+    while ( it.next() ) {
+        const Statement s = *it;
+        QCOMPARE( s.subject().uri(), cacheTestUri( QString::fromLatin1( "R%1" ).arg( s.object().literal().toInt() ) ) );
+        ++found;
+    }
+    QCOMPARE( found, count );
+
+    QVERIFY( m_model->containsStatement( statements.first() ) );
+    QVERIFY( m_model->containsStatement( statements.last() ) );
+}
+
+
+void RedlandMemoryModelTest::testNodeCacheStatistics()
+{
+    QVERIFY( QMetaObject::invokeMethod( m_model, "resetNodeCacheStatistics", Qt::DirectConnection ) );
+
+    qint64 hits = -1;
+    qint64 misses = -1;
+    QVERIFY( QMetaObject::invokeMethod( m_model, "nodeCacheHits", Qt::DirectConnection, Q_RETURN_ARG( qint64, hits ) ) );
+    QVERIFY( QMetaObject::invokeMethod( m_model, "nodeCacheMisses", Qt::DirectConnection, Q_RETURN_ARG( qint64, misses ) ) );
+    QCOMPARE( hits, qint64( 0 ) );
+    QCOMPARE( misses, qint64( 0 ) );
+
+    // the second lookup of the same resources is served from the cache
+    const Statement s( cacheTestUri( "stats" ), cacheTestUri( "value" ), cacheTestUri( "other" ) );
+    QCOMPARE( m_model->addStatement( s ), Error::ErrorNone );
+    QVERIFY( QMetaObject::invokeMethod( m_model, "nodeCacheHits", Qt::DirectConnection, Q_RETURN_ARG( qint64, hits ) ) );
+    QVERIFY( QMetaObject::invokeMethod( m_model, "nodeCacheMisses", Qt::DirectConnection, Q_RETURN_ARG( qint64, misses ) ) );
+    QVERIFY( misses > 0 );
+
+    const qint64 hitsBefore = hits;
+    QVERIFY( m_model->containsStatement( s ) );
+    QVERIFY( QMetaObject::invokeMethod( m_model, "nodeCacheHits", Qt::DirectConnection, Q_RETURN_ARG( qint64, hits ) ) );
+    QVERIFY( hits >= hitsBefore + 3 );
+}
+
+
+void RedlandMemoryModelTest::testReusedQueryStatement()
+{
+    const Statement a1( cacheTestUri( "A" ), cacheTestUri( "p1" ), LiteralValue( 1 ) );
+    const Statement a2( cacheTestUri( "A" ), cacheTestUri( "p2" ), LiteralValue( 2 ) );
+    const Statement b1( cacheTestUri( "B" ), cacheTestUri( "p1" ), LiteralValue( 2 ) );
+    QCOMPARE( m_model->addStatement( a1 ), Error::ErrorNone );
+    QCOMPARE( m_model->addStatement( a2 ), Error::ErrorNone );
+    QCOMPARE( m_model->addStatement( b1 ), Error::ErrorNone );
+
+    // each lookup binds other parts of the statement, none of them may leak into the next one
+    QCOMPARE( m_model->listStatements( cacheTestUri( "A" ), Node(), Node() ).allStatements().count(), 2 );
+    QCOMPARE( m_model->listStatements( Node(), cacheTestUri( "p1" ), Node() ).allStatements().count(), 2 );
+    QCOMPARE( m_model->listStatements( Node(), Node(), LiteralValue( 2 ) ).allStatements().count(), 2 );
+    QCOMPARE( m_model->listStatements( cacheTestUri( "B" ), Node(), Node() ).allStatements().count(), 1 );
+    QVERIFY( m_model->containsAnyStatement( Node(), cacheTestUri( "p2" ), Node() ) );
+    QVERIFY( !m_model->containsAnyStatement( cacheTestUri( "B" ), cacheTestUri( "p2" ), Node() ) );
+    QVERIFY( m_model->containsStatement( a1 ) );
+    QVERIFY( !m_model->containsStatement( cacheTestUri( "B" ), cacheTestUri( "p1" ), LiteralValue( 1 ) ) );
+
+    // an open iterator is not affected by the lookups done while iterating it
+    StatementIterator it = m_model->listStatements( cacheTestUri( "A" ), Node(), Node() );
+    int count = 0;
+    while ( it.next() ) {
+        QCOMPARE( it.current().subject().uri(), cacheTestUri( "A" ) );
+        QVERIFY( m_model->containsStatement( b1 ) );
+        QCOMPARE( m_model->listStatements( cacheTestUri( "B" ), Node(), Node() ).allStatements().count(), 1 );
+        ++count;
+    }
+    QCOMPARE( count, 2 );
+}
+
+
+void RedlandMemoryModelTest::testContainsStatementFastPath()
+{
+    const QUrl graph = cacheTestUri( "graph" );
+    const Statement inDefaultGraph( cacheTestUri( "A" ), cacheTestUri( "p" ), LiteralValue( "default" ) );
+    const Statement inGraph( cacheTestUri( "B" ), cacheTestUri( "p" ), LiteralValue( "graph" ), graph );
+    const Statement inGraphWithoutContext( inGraph.subject(), inGraph.predicate(), inGraph.object() );
+    QCOMPARE( m_model->addStatement( inDefaultGraph ), Error::ErrorNone );
+    QCOMPARE( m_model->addStatement( inGraph ), Error::ErrorNone );
+
+    // complete statements without a context
+    QVERIFY( m_model->containsStatement( inDefaultGraph ) );
+    QVERIFY( m_model->containsAnyStatement( inDefaultGraph ) );
+    QVERIFY( !m_model->containsStatement( inGraphWithoutContext ) );
+    QVERIFY( m_model->containsAnyStatement( inGraphWithoutContext ) );
+
+    // and with one
+    QVERIFY( m_model->containsStatement( inGraph ) );
+    QVERIFY( m_model->containsAnyStatement( inGraph ) );
+    QVERIFY( !m_model->containsStatement( Statement( inDefaultGraph.subject(), inDefaultGraph.predicate(), inDefaultGraph.object(), graph ) ) );
+    QVERIFY( !m_model->containsAnyStatement( Statement( inDefaultGraph.subject(), inDefaultGraph.predicate(), inDefaultGraph.object(), graph ) ) );
+
+    // statements which do not exist at all
+    QVERIFY( !m_model->containsStatement( inDefaultGraph.subject(), inDefaultGraph.predicate(), LiteralValue( "other" ) ) );
+    QVERIFY( !m_model->containsAnyStatement( inDefaultGraph.subject(), inDefaultGraph.predicate(), LiteralValue( "other" ) ) );
+
+    // patterns still work after complete lookups
+    QVERIFY( m_model->containsAnyStatement( inGraph.subject(), Node(), Node() ) );
+    QVERIFY( m_model->containsAnyStatement( Node(), Node(), Node(), graph ) );
+
+    QCOMPARE( m_model->removeStatement( inDefaultGraph ), Error::ErrorNone );
+    QVERIFY( !m_model->containsStatement( inDefaultGraph ) );
+    QVERIFY( !m_model->containsAnyStatement( inDefaultGraph ) );
+    QVERIFY( m_model->containsStatement( inGraph ) );
+}
+
 QTEST_MAIN(RedlandMemoryModelTest)
 
 
@@ -35,6 +35,13 @@ class RedlandMemoryModelTest: public SopranoModelTest
 {
 Q_OBJECT
 
+private Q_SLOTS:
+  void testNodeCache();
+  void testNodeCacheEviction();
+  void testNodeCacheStatistics();
+  void testReusedQueryStatement();
+  void testContainsStatementFastPath();
+
 protected:
   virtual Soprano::Model* createModel();
 };
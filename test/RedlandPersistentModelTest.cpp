@@ -60,6 +60,43 @@ void RedlandPersistentModelTest::deleteModel( Soprano::Model* m )
     QFile::remove( QString( "/tmp/%1-contexts.db" ).arg( name ) );
 }
 
+
+void RedlandPersistentModelTest::testBatchWrites()
+{
+    const Backend* b = Soprano::discoverBackendByName( "redland" );
+    QVERIFY( b );
+    QVERIFY( b->supportedUserFeatures().contains( "batchWrites" ) );
+
+    bool ok = false;
+    QVERIFY( QMetaObject::invokeMethod( m_model, "startBatch", Qt::DirectConnection, Q_RETURN_ARG( bool, ok ) ) );
+    QVERIFY( ok );
+
+    // nested batches only sync once the outermost one is committed
+    QVERIFY( QMetaObject::invokeMethod( m_model, "startBatch", Qt::DirectConnection, Q_RETURN_ARG( bool, ok ) ) );
+
+    QList<Statement> statements;
+    for ( int i = 0; i < 100; ++i ) {
+        statements.append( Statement( QUrl( QString( "http://soprano.sf.net/test#batch%1" ).arg( i ) ),
+                                      QUrl( "http://soprano.sf.net/test#predicate" ),
+                                      LiteralValue( i ),
+                                      QUrl( "http://soprano.sf.net/test#graph" ) ) );
+    }
+    QCOMPARE( m_model->addStatements( statements ), Error::ErrorNone );
+
+    QVERIFY( QMetaObject::invokeMethod( m_model, "commitBatch", Qt::DirectConnection, Q_RETURN_ARG( bool, ok ) ) );
+    QVERIFY( ok );
+    QVERIFY( QMetaObject::invokeMethod( m_model, "commitBatch", Qt::DirectConnection, Q_RETURN_ARG( bool, ok ) ) );
+    QVERIFY( ok );
+
+    // nothing left to commit
+    QVERIFY( QMetaObject::invokeMethod( m_model, "commitBatch", Qt::DirectConnection, Q_RETURN_ARG( bool, ok ) ) );
+    QVERIFY( !ok );
+
+    Q_FOREACH( const Statement& s, statements ) {
+        QVERIFY( m_model->containsStatement( s ) );
+    }
+}
+
 QTEST_MAIN(RedlandPersistentModelTest)
 
 
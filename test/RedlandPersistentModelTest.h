@@ -35,6 +35,9 @@ class RedlandPersistentModelTest: public SopranoModelTest
 {
 Q_OBJECT
 
+private Q_SLOTS:
+  void testBatchWrites();
+
 protected:
   virtual Soprano::Model* createModel();
   void deleteModel( Soprano::Model* );
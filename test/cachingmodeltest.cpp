@@ -0,0 +1,227 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "cachingmodeltest.h"
+
+#include <QtTest/QTest>
+#include <QtCore/QDebug>
+
+#include "../soprano/soprano.h"
+#include "../soprano/util/cachingmodel.h"
+
+using namespace Soprano;
+
+namespace {
+    QUrl testUri( const char* name ) {
+        return QUrl( QLatin1String( "http://soprano.org/test#" ) + QLatin1String( name ) );
+    }
+
+    class QueryCountingModel : public FilterModel
+    {
+    public:
+        QueryCountingModel( Model* parent )
+            : FilterModel( parent ),
+              queryCount( 0 ) {
+        }
+
+        QueryResultIterator executeQuery( const QString& query, Query::QueryLanguage language, const QString& userQueryLanguage = QString() ) const {
+            ++queryCount;
+            return FilterModel::executeQuery( query, language, userQueryLanguage );
+        }
+
+        mutable int queryCount;
+    };
+
+    /// Swallows all signals of its parent like Virtuoso with noStatementSignals
+    class SilentModel : public FilterModel
+    {
+    public:
+        SilentModel( Model* parent )
+            : FilterModel( parent ) {
+        }
+
+    protected:
+        void parentStatementsAdded() {}
+        void parentStatementsRemoved() {}
+        void parentStatementAdded( const Statement& ) {}
+        void parentStatementRemoved( const Statement& ) {}
+    };
+}
+
+
+void CachingModelTest::init()
+{
+    QList<BackendSetting> settings;
+    settings.append( BackendSetting( BackendOptionStorageMemory ) );
+    m_model = createModel( settings );
+    QVERIFY( m_model != 0 );
+
+    m_cachingModel = new Util::CachingModel( m_model );
+
+    m_model->addStatement( testUri( "A" ), testUri( "p" ), LiteralValue( "a" ) );
+    m_model->addStatement( testUri( "A" ), testUri( "q" ), LiteralValue( "b" ) );
+    m_model->addStatement( testUri( "B" ), testUri( "p" ), LiteralValue( "c" ) );
+}
+
+
+void CachingModelTest::cleanup()
+{
+    delete m_cachingModel;
+    delete m_model;
+}
+
+
+void CachingModelTest::testListStatements()
+{
+    m_cachingModel->resetStatistics();
+
+    QList<Statement> sl1 = m_cachingModel->listStatements( testUri( "A" ), Node(), Node() ).allStatements();
+    QCOMPARE( sl1.count(), 2 );
+    QCOMPARE( m_cachingModel->cacheMisses(), qint64( 1 ) );
+
+    QList<Statement> sl2 = m_cachingModel->listStatements( testUri( "A" ), Node(), Node() ).allStatements();
+    QCOMPARE( m_cachingModel->cacheHits(), qint64( 1 ) );
+    QCOMPARE( sl1.toSet(), sl2.toSet() );
+}
+
+
+void CachingModelTest::testPatternInvalidation()
+{
+    m_cachingModel->listStatements( testUri( "A" ), Node(), Node() ).allStatements();
+    m_cachingModel->listStatements( testUri( "B" ), Node(), Node() ).allStatements();
+    m_cachingModel->resetStatistics();
+
+    // only the cached results for B are affected
+    QVERIFY( m_cachingModel->addStatement( testUri( "B" ), testUri( "q" ), LiteralValue( "d" ) ) == Error::ErrorNone );
+
+    QCOMPARE( m_cachingModel->listStatements( testUri( "A" ), Node(), Node() ).allStatements().count(), 2 );
+    QCOMPARE( m_cachingModel->cacheHits(), qint64( 1 ) );
+    QCOMPARE( m_cachingModel->listStatements( testUri( "B" ), Node(), Node() ).allStatements().count(), 2 );
+    QCOMPARE( m_cachingModel->cacheMisses(), qint64( 1 ) );
+
+    // changes in the parent model are seen as well
+    QVERIFY( m_model->removeAllStatements( testUri( "A" ), Node(), Node() ) == Error::ErrorNone );
+    QVERIFY( m_cachingModel->listStatements( testUri( "A" ), Node(), Node() ).allStatements().isEmpty() );
+}
+
+
+void CachingModelTest::testExecuteQuery()
+{
+    const QString query = QString::fromLatin1( "select ?r where { ?r %1 ?o . }" ).arg( Node::resourceToN3( testUri( "p" ) ) );
+
+    m_cachingModel->resetStatistics();
+    QCOMPARE( m_cachingModel->executeQuery( query, Query::QueryLanguageSparql ).allBindings().count(), 2 );
+    QCOMPARE( m_cachingModel->executeQuery( query, Query::QueryLanguageSparql ).allBindings().count(), 2 );
+    QCOMPARE( m_cachingModel->cacheHits(), qint64( 1 ) );
+    QCOMPARE( m_cachingModel->cacheMisses(), qint64( 1 ) );
+
+    QVERIFY( m_cachingModel->addStatement( testUri( "C" ), testUri( "p" ), LiteralValue( "e" ) ) == Error::ErrorNone );
+    QCOMPARE( m_cachingModel->executeQuery( query, Query::QueryLanguageSparql ).allBindings().count(), 3 );
+    QCOMPARE( m_cachingModel->cacheMisses(), qint64( 2 ) );
+}
+
+
+void CachingModelTest::testUncachedQueries()
+{
+    QueryCountingModel countingModel( m_model );
+    m_cachingModel->setParentModel( &countingModel );
+
+    // updates have to reach the backend each time
+    const QString update = QString::fromLatin1( "prefix t: <http://soprano.org/test#> insert data { t:C t:p \"e\" . }" );
+    m_cachingModel->executeQuery( update, Query::QueryLanguageSparql );
+    m_cachingModel->executeQuery( update, Query::QueryLanguageSparql );
+    QCOMPARE( countingModel.queryCount, 2 );
+
+    // as do queries in unknown languages
+    m_cachingModel->executeQuery( QLatin1String( "select 1" ), Query::QueryLanguageUser, QLatin1String( "sql" ) );
+    m_cachingModel->executeQuery( QLatin1String( "select 1" ), Query::QueryLanguageUser, QLatin1String( "sql" ) );
+    QCOMPARE( countingModel.queryCount, 4 );
+
+    // read-only queries with a prologue are still cached
+    const QString query = QString::fromLatin1( "# comment\nprefix t: <http://soprano.org/test#>\nselect ?r where { ?r t:p ?o . }" );
+    QCOMPARE( m_cachingModel->executeQuery( query, Query::QueryLanguageSparql ).allBindings().count(), 2 );
+    QCOMPARE( m_cachingModel->executeQuery( query, Query::QueryLanguageSparql ).allBindings().count(), 2 );
+    QCOMPARE( countingModel.queryCount, 5 );
+
+    m_cachingModel->setParentModel( m_model );
+}
+
+
+void CachingModelTest::testContainsAndCount()
+{
+    m_cachingModel->resetStatistics();
+    QCOMPARE( m_cachingModel->statementCount(), 3 );
+    QCOMPARE( m_cachingModel->statementCount(), 3 );
+    QVERIFY( m_cachingModel->containsAnyStatement( testUri( "A" ), testUri( "p" ), Node() ) );
+    QVERIFY( m_cachingModel->containsAnyStatement( testUri( "A" ), testUri( "p" ), Node() ) );
+    QVERIFY( !m_cachingModel->containsAnyStatement( testUri( "C" ), Node(), Node() ) );
+    QCOMPARE( m_cachingModel->cacheHits(), qint64( 2 ) );
+
+    QVERIFY( m_cachingModel->addStatement( testUri( "C" ), testUri( "p" ), LiteralValue( "e" ) ) == Error::ErrorNone );
+    QCOMPARE( m_cachingModel->statementCount(), 4 );
+    QVERIFY( m_cachingModel->containsAnyStatement( testUri( "C" ), Node(), Node() ) );
+}
+
+
+void CachingModelTest::testWritesWithoutSignals()
+{
+    SilentModel silentModel( m_model );
+    m_cachingModel->setParentModel( &silentModel );
+
+    QCOMPARE( m_cachingModel->statementCount(), 3 );
+    QVERIFY( !m_cachingModel->containsAnyStatement( testUri( "C" ), Node(), Node() ) );
+    QCOMPARE( m_cachingModel->listStatements( testUri( "C" ), Node(), Node() ).allStatements().count(), 0 );
+
+    // writes through the caching model invalidate the cache themselves
+    QVERIFY( m_cachingModel->addStatement( testUri( "C" ), testUri( "p" ), LiteralValue( "e" ) ) == Error::ErrorNone );
+    QCOMPARE( m_cachingModel->statementCount(), 4 );
+    QVERIFY( m_cachingModel->containsAnyStatement( testUri( "C" ), Node(), Node() ) );
+    QCOMPARE( m_cachingModel->listStatements( testUri( "C" ), Node(), Node() ).allStatements().count(), 1 );
+
+    QVERIFY( m_cachingModel->removeStatement( testUri( "C" ), testUri( "p" ), LiteralValue( "e" ) ) == Error::ErrorNone );
+    QCOMPARE( m_cachingModel->statementCount(), 3 );
+    QVERIFY( !m_cachingModel->containsAnyStatement( testUri( "C" ), Node(), Node() ) );
+
+    QVERIFY( m_cachingModel->removeAllStatements( testUri( "A" ), Node(), Node() ) == Error::ErrorNone );
+    QCOMPARE( m_cachingModel->statementCount(), 1 );
+    QCOMPARE( m_cachingModel->listStatements( testUri( "A" ), Node(), Node() ).allStatements().count(), 0 );
+
+    // a query which is not cached might have been an update
+    QVERIFY( m_model->addStatement( testUri( "D" ), testUri( "p" ), LiteralValue( "f" ) ) == Error::ErrorNone );
+    QCOMPARE( m_cachingModel->statementCount(), 1 );
+    m_cachingModel->executeQuery( QLatin1String( "select 1" ), Query::QueryLanguageUser, QLatin1String( "sql" ) );
+    QCOMPARE( m_cachingModel->statementCount(), 2 );
+
+    m_cachingModel->setParentModel( m_model );
+}
+
+
+void CachingModelTest::testLargeResult()
+{
+    // results larger than the cache are streamed and not cached
+    m_cachingModel->setCacheSize( 2 );
+    m_cachingModel->resetStatistics();
+    QCOMPARE( m_cachingModel->listStatements().allStatements().count(), 3 );
+    QCOMPARE( m_cachingModel->listStatements().allStatements().count(), 3 );
+    QCOMPARE( m_cachingModel->cacheHits(), qint64( 0 ) );
+}
+
+QTEST_MAIN( CachingModelTest )
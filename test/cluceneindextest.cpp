@@ -23,6 +23,7 @@
 #include "stringpool.h"
 
 #include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
 #include <QtCore/QDebug>
 #include <QtCore/QProcess>
 #include <QtCore/QDir>
@@ -31,13 +32,64 @@
 #include "../soprano/soprano.h"
 #include "../index/indexfiltermodel.h"
 #include "../index/cluceneindex.h"
+#include "../soprano/filtermodel.h"
 #include "../index/tstring.h"
+#include "../soprano/vocabulary/rdf.h"
 
 #include <CLucene.h>
 
 using namespace Soprano;
 using namespace Soprano::Index;
 
+namespace {
+    /// A model which does not know its size like many remote models
+    class UnknownCountModel : public FilterModel
+    {
+    public:
+        UnknownCountModel( Model* parent )
+            : FilterModel( parent ) {
+        }
+
+        int statementCount() const {
+            return -1;
+        }
+    };
+
+    /// A model which fails every other query
+    class FlakyQueryModel : public FilterModel
+    {
+    public:
+        FlakyQueryModel( Model* parent )
+            : FilterModel( parent ),
+              m_queryCount( 0 ) {
+        }
+
+        QueryResultIterator executeQuery( const QString& query, Query::QueryLanguage language, const QString& userQueryLanguage = QString() ) const {
+            if ( m_queryCount++ % 2 == 0 ) {
+                setError( "Query failed on purpose" );
+                return QueryResultIterator();
+            }
+            return FilterModel::executeQuery( query, language, userQueryLanguage );
+        }
+
+        int queryCount() const {
+            return m_queryCount;
+        }
+
+    private:
+        mutable int m_queryCount;
+    };
+
+    void addUnindexedStatements( Model* model, int count )
+    {
+        for ( int i = 0; i < count; ++i ) {
+            QVERIFY( model->addStatement( QUrl( QString( "http://soprano.sf.net/test#R%1" ).arg( i ) ),
+                                          QUrl( "http://soprano.sf.net/test#valueX" ),
+                                          LiteralValue( "Hello World" ) ) == Error::ErrorNone );
+        }
+    }
+}
+
 
 /*static QUrl createRandomUri()
 {
@@ -250,5 +302,276 @@ void IndexTest::testMassAddStatement()
 }
 
 
+void IndexTest::testAsynchronousIndexing()
+{
+    m_indexModel->setAsynchronousIndexing( true );
+    m_indexModel->setIndexQueueBatchSize( 10 );
+    QVERIFY( m_indexModel->asynchronousIndexing() );
+
+    for ( int i = 0; i < 25; ++i ) {
+        QVERIFY( m_indexModel->addStatement( QUrl( QString( "http://soprano.sf.net/test#R%1" ).arg( i ) ),
+                                             QUrl( "http://soprano.sf.net/test#valueX" ),
+                                             LiteralValue( "Hello World" ) ) == Error::ErrorNone );
+    }
+
+    QCOMPARE( m_indexModel->flushIndex(), Error::ErrorNone );
+    QCOMPARE( m_indexModel->index()->resourceCount(), 25 );
+
+    QVERIFY( m_indexModel->removeStatement( QUrl( "http://soprano.sf.net/test#R0" ),
+                                            QUrl( "http://soprano.sf.net/test#valueX" ),
+                                            LiteralValue( "Hello World" ) ) == Error::ErrorNone );
+    QCOMPARE( m_indexModel->flushIndex(), Error::ErrorNone );
+    QueryResultIterator it = m_indexModel->executeQuery( "Hello", Query::QueryLanguageUser, "lucene" );
+    QCOMPARE( it.allBindings().count(), 24 );
+
+    m_indexModel->setAsynchronousIndexing( false );
+    QVERIFY( !m_indexModel->asynchronousIndexing() );
+}
+
+
+void IndexTest::testQueryPendingChanges()
+{
+    // searching does not wait for queued updates, they become searchable once flushed
+    m_indexModel->setAsynchronousIndexing( true );
+    m_indexModel->setIndexQueueBatchSize( 100 );
+    m_indexModel->setIndexQueueMaxDelay( 60*1000 );
+
+    QVERIFY( m_indexModel->addStatement( QUrl( "http://soprano.sf.net/test#A" ),
+                                         QUrl( "http://soprano.sf.net/test#valueX" ),
+                                         LiteralValue( "Hello World" ) ) == Error::ErrorNone );
+    QueryResultIterator it = m_indexModel->executeQuery( "Hello", Query::QueryLanguageUser, "lucene" );
+    QCOMPARE( it.allBindings().count(), 0 );
+    QCOMPARE( m_indexModel->flushIndex(), Error::ErrorNone );
+    it = m_indexModel->executeQuery( "Hello", Query::QueryLanguageUser, "lucene" );
+    QCOMPARE( it.allBindings().count(), 1 );
+
+    m_indexModel->setAsynchronousIndexing( false );
+
+    // the same goes for changes cached in a transaction
+    m_indexModel->setTransactionCacheSize( 100 );
+    QVERIFY( m_indexModel->addStatement( QUrl( "http://soprano.sf.net/test#B" ),
+                                         QUrl( "http://soprano.sf.net/test#valueX" ),
+                                         LiteralValue( "Hello World" ) ) == Error::ErrorNone );
+    it = m_indexModel->executeQuery( "Hello", Query::QueryLanguageUser, "lucene" );
+    QCOMPARE( it.allBindings().count(), 1 );
+    QCOMPARE( m_indexModel->flushIndex(), Error::ErrorNone );
+    it = m_indexModel->executeQuery( "Hello", Query::QueryLanguageUser, "lucene" );
+    QCOMPARE( it.allBindings().count(), 2 );
+    QCOMPARE( m_indexModel->executeFullTextQuery( "Hello", Statement() ).allBindings().count(), 2 );
+    m_indexModel->setTransactionCacheSize( 1 );
+}
+
+
+void IndexTest::testDocumentCache()
+{
+    CLuceneIndex* index = m_indexModel->index();
+    index->resetStatistics();
+
+    int id = index->startTransaction();
+    QVERIFY( id != 0 );
+    for ( int i = 0; i < 30; ++i ) {
+        QVERIFY( index->addStatement( Statement( QUrl( "http://soprano.sf.net/test#A" ),
+                                                 QUrl( QString( "http://soprano.sf.net/test#value%1" ).arg( i ) ),
+                                                 LiteralValue( "Hello World" ) ) ) == Error::ErrorNone );
+    }
+    QVERIFY( index->addStatement( Statement( QUrl( "http://soprano.sf.net/test#B" ),
+                                             QUrl( "http://soprano.sf.net/test#value0" ),
+                                             LiteralValue( "Hello World" ) ) ) == Error::ErrorNone );
+    QVERIFY( index->closeTransaction( id ) );
+
+    // one document per resource
+    QCOMPARE( index->documentCacheMisses(), qint64( 2 ) );
+    QCOMPARE( index->documentCacheHits(), qint64( 29 ) );
+    QCOMPARE( index->documentsWritten(), qint64( 2 ) );
+    QCOMPARE( index->resourceCount(), 2 );
+
+    // updating a stored resource replaces its document
+    QVERIFY( index->removeStatement( Statement( QUrl( "http://soprano.sf.net/test#B" ),
+                                                QUrl( "http://soprano.sf.net/test#value0" ),
+                                                LiteralValue( "Hello World" ) ) ) == Error::ErrorNone );
+    QCOMPARE( index->resourceCount(), 1 );
+}
+
+
+void IndexTest::testPagedSearch()
+{
+    for ( int i = 0; i < 30; ++i ) {
+        QVERIFY( m_indexModel->addStatement( QUrl( QString( "http://soprano.sf.net/test#R%1" ).arg( i ) ),
+                                             QUrl( "http://soprano.sf.net/test#valueX" ),
+                                             LiteralValue( "Hello World" ) ) == Error::ErrorNone );
+    }
+    QCOMPARE( m_indexModel->flushIndex(), Error::ErrorNone );
+
+    QList<QueryHit> allHits = m_indexModel->index()->search( "Hello" ).allElements();
+    QCOMPARE( allHits.count(), 30 );
+
+    QList<QueryHit> firstPage = m_indexModel->index()->search( "Hello", 20 ).allElements();
+    QCOMPARE( firstPage.count(), 20 );
+    QList<QueryHit> secondPage = m_indexModel->index()->search( "Hello", 20, 20 ).allElements();
+    QCOMPARE( secondPage.count(), 10 );
+    for ( int i = 0; i < 30; ++i ) {
+        const QueryHit& hit = i < 20 ? firstPage[i] : secondPage[i-20];
+        QCOMPARE( hit.resource(), allHits[i].resource() );
+    }
+
+    QVERIFY( m_indexModel->index()->search( "Hello", 10, 40 ).allElements().isEmpty() );
+    QVERIFY( m_indexModel->index()->search( "Hello", -1, 0, allHits.first().score() + 1.0 ).allElements().isEmpty() );
+
+    QueryResultIterator it = m_indexModel->executeQuery( "Hello", Query::QueryLanguageUser, "lucene?limit=5&offset=2" );
+    QCOMPARE( it.allBindings().count(), 5 );
+
+    it = m_indexModel->executeQuery( "Hello", Query::QueryLanguageUser, "lucene?limit=five" );
+    QVERIFY( !it.isValid() );
+    QCOMPARE( m_indexModel->lastError().code(), int( Error::ErrorInvalidArgument ) );
+}
+
+
+void IndexTest::testFullTextQueryWithPattern()
+{
+    // every third resource is a person
+    const QUrl personType( "http://soprano.sf.net/test#Person" );
+    for ( int i = 0; i < 300; ++i ) {
+        const QUrl resource( QString( "http://soprano.sf.net/test#R%1" ).arg( i ) );
+        QVERIFY( m_indexModel->addStatement( resource,
+                                             QUrl( "http://soprano.sf.net/test#valueX" ),
+                                             LiteralValue( "Hello World" ) ) == Error::ErrorNone );
+        if ( i % 3 == 0 ) {
+            QVERIFY( m_indexModel->addStatement( resource, Vocabulary::RDF::type(), personType ) == Error::ErrorNone );
+        }
+    }
+    QCOMPARE( m_indexModel->flushIndex(), Error::ErrorNone );
+
+    QueryResultIterator it = m_indexModel->executeFullTextQuery( "Hello", Statement( Node(), Vocabulary::RDF::type(), personType ) );
+    QVERIFY( it.isValid() );
+    QList<BindingSet> persons = it.allBindings();
+    QCOMPARE( persons.count(), 100 );
+    foreach( const BindingSet& set, persons ) {
+        QVERIFY( m_model->containsAnyStatement( set["resource"], Vocabulary::RDF::type(), personType ) );
+    }
+
+    it = m_indexModel->executeFullTextQuery( "Hello", Statement( Node(), Vocabulary::RDF::type(), personType ), 20, 90 );
+    QCOMPARE( it.allBindings().count(), 10 );
+
+    it = m_indexModel->executeFullTextQuery( "Hello", Statement( QUrl( "http://soprano.sf.net/test#R0" ), Vocabulary::RDF::type(), personType ) );
+    QVERIFY( !it.isValid() );
+}
+
+
+void IndexTest::testFullTextQueryRetriesBatchQuery()
+{
+    FlakyQueryModel flakyModel( m_model );
+    IndexFilterModel indexModel( m_index, &flakyModel );
+
+    // three batches of hits, every third resource is a person
+    const QUrl personType( "http://soprano.sf.net/test#Person" );
+    for ( int i = 0; i < 300; ++i ) {
+        const QUrl resource( QString( "http://soprano.sf.net/test#R%1" ).arg( i ) );
+        QVERIFY( indexModel.addStatement( resource,
+                                          QUrl( "http://soprano.sf.net/test#valueX" ),
+                                          LiteralValue( "Hello World" ) ) == Error::ErrorNone );
+        if ( i % 3 == 0 ) {
+            QVERIFY( indexModel.addStatement( resource, Vocabulary::RDF::type(), personType ) == Error::ErrorNone );
+        }
+    }
+
+    // a failed batch query only affects its own batch
+    QueryResultIterator it = indexModel.executeFullTextQuery( "Hello", Statement( Node(), Vocabulary::RDF::type(), personType ) );
+    QVERIFY( it.isValid() );
+    QCOMPARE( it.allBindings().count(), 100 );
+    QCOMPARE( flakyModel.queryCount(), 3 );
+}
+
+
+void IndexTest::testFullTextQueryWithBlankNode()
+{
+    const QUrl valueY( "http://soprano.sf.net/test#valueY" );
+    for ( int i = 0; i < 10; ++i ) {
+        const QUrl resource( QString( "http://soprano.sf.net/test#R%1" ).arg( i ) );
+        QVERIFY( m_indexModel->addStatement( resource,
+                                             QUrl( "http://soprano.sf.net/test#valueX" ),
+                                             LiteralValue( "Hello World" ) ) == Error::ErrorNone );
+        QVERIFY( m_indexModel->addStatement( resource, valueY, m_model->createBlankNode() ) == Error::ErrorNone );
+    }
+
+    // the blank node selects one node, it does not act as a variable
+    StatementIterator sit = m_model->listStatements( QUrl( "http://soprano.sf.net/test#R3" ), valueY, Node() );
+    QVERIFY( sit.next() );
+    const Node blank = sit.current().object();
+    sit.close();
+    QVERIFY( blank.isBlank() );
+
+    QueryResultIterator it = m_indexModel->executeFullTextQuery( "Hello", Statement( Node(), valueY, blank ) );
+    QVERIFY( it.isValid() );
+    QList<BindingSet> hits = it.allBindings();
+    QCOMPARE( hits.count(), 1 );
+    QCOMPARE( hits.first()["resource"], Node( QUrl( "http://soprano.sf.net/test#R3" ) ) );
+
+    it = m_indexModel->executeFullTextQuery( "Hello", Statement( Node(), valueY, Node() ) );
+    QCOMPARE( it.allBindings().count(), 10 );
+}
+
+
+void IndexTest::slotCancelRebuild( qint64 position, qint64 total )
+{
+    Q_UNUSED( total );
+    if ( position < 3000 ) {
+        m_indexModel->cancelIndexRebuild();
+    }
+}
+
+
+void IndexTest::testCancelAndResumeRebuild()
+{
+    // bypass the index so only a rebuild can index the data
+    addUnindexedStatements( m_model, 3000 );
+    QCOMPARE( m_index->resourceCount(), 0 );
+
+    // progress is reported every 1000 statements, cancel at the first report
+    connect( m_indexModel, SIGNAL( indexRebuildProgress( qint64, qint64 ) ),
+             this, SLOT( slotCancelRebuild( qint64, qint64 ) ), Qt::DirectConnection );
+    const qint64 position = m_indexModel->rebuildIndex( 0 );
+    disconnect( m_indexModel, SIGNAL( indexRebuildProgress( qint64, qint64 ) ),
+                this, SLOT( slotCancelRebuild( qint64, qint64 ) ) );
+    QCOMPARE( m_indexModel->lastError().code(), int( Error::ErrorNone ) );
+    QCOMPARE( position, qint64( 1000 ) );
+    QCOMPARE( m_index->resourceCount(), 1000 );
+
+    // resuming indexes the remaining statements only
+    QSignalSpy spy( m_indexModel, SIGNAL( indexRebuildProgress( qint64, qint64 ) ) );
+    QCOMPARE( m_indexModel->rebuildIndex( position ), qint64( 3000 ) );
+    QCOMPARE( m_index->resourceCount(), 3000 );
+    QVERIFY( !spy.isEmpty() );
+    QCOMPARE( spy.last().at( 0 ).toLongLong(), qint64( 3000 ) );
+    QCOMPARE( spy.last().at( 1 ).toLongLong(), qint64( 3000 ) );
+
+    QueryResultIterator it = m_indexModel->executeQuery( "Hello", Query::QueryLanguageUser, "lucene" );
+    QCOMPARE( it.allBindings().count(), 3000 );
+
+    // a rebuild from the start replaces the index instead of adding to it
+    QCOMPARE( m_indexModel->rebuildIndex( 0 ), qint64( 3000 ) );
+    QCOMPARE( m_index->resourceCount(), 3000 );
+}
+
+
+void IndexTest::testRebuildUnknownTotal()
+{
+    addUnindexedStatements( m_model, 1500 );
+
+    UnknownCountModel countModel( m_model );
+    IndexFilterModel indexModel( m_index, &countModel );
+    QSignalSpy spy( &indexModel, SIGNAL( indexRebuildProgress( qint64, qint64 ) ) );
+    QCOMPARE( indexModel.rebuildIndex( 0 ), qint64( 1500 ) );
+    QCOMPARE( m_index->resourceCount(), 1500 );
+
+    // one report after 1000 statements and a final one, both without a total
+    QCOMPARE( spy.count(), 2 );
+    QCOMPARE( spy.first().at( 0 ).toLongLong(), qint64( 1000 ) );
+    QCOMPARE( spy.last().at( 0 ).toLongLong(), qint64( 1500 ) );
+    for ( int i = 0; i < spy.count(); ++i ) {
+        QCOMPARE( spy.at( i ).at( 1 ).toLongLong(), qint64( -1 ) );
+    }
+}
+
+
 QTEST_MAIN( IndexTest )
 
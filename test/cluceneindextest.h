@@ -43,8 +43,20 @@ private Q_SLOTS:
     void testUriEncoding_data();
     void testUriEncoding();
     void testMassAddStatement();
+    void testAsynchronousIndexing();
+    void testQueryPendingChanges();
+    void testDocumentCache();
+    void testPagedSearch();
+    void testFullTextQueryWithPattern();
+    void testFullTextQueryRetriesBatchQuery();
+    void testFullTextQueryWithBlankNode();
+    void testCancelAndResumeRebuild();
+    void testRebuildUnknownTotal();
     void cleanup();
 
+public Q_SLOTS:
+    void slotCancelRebuild( qint64 position, qint64 total );
+
 private:
     Soprano::Model* m_model;
     Soprano::Index::IndexFilterModel* m_indexModel;
@@ -0,0 +1,364 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "dbusexportmodeltest.h"
+#include "../server/dbus/dbusexportmodel.h"
+#include "../server/dbus/dbusoperators.h"
+#include "../client/dbus/dbusmodel.h"
+#include "../client/dbus/dbusqueryresultiterator.h"
+
+#include "soprano.h"
+
+#include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+#include <QtDBus/QDBusConnection>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusMetaType>
+#include <QtCore/QStringList>
+#include <QtCore/QSet>
+
+using namespace Soprano;
+
+namespace {
+    const char* s_objectPath = "/org/soprano/Test/DBusExportModel";
+    const char* s_interface = "org.soprano.Model";
+    const char* s_legacyIteratorPath = "/org/soprano/Test/LegacyQueryResultIterator";
+
+    // more than two batches of DBus::DefaultBatchSize rows
+    const int s_batchTestCount = 250;
+
+    Statement testStatement( int i )
+    {
+        return Statement( QUrl( QString::fromLatin1( "http://soprano.org/test#A%1" ).arg( i ) ),
+                          QUrl( QLatin1String( "http://soprano.org/test#p" ) ),
+                          LiteralValue( i ) );
+    }
+
+    QStringList changeSignalNames()
+    {
+        return QStringList() << QLatin1String( "statementAdded" )
+                             << QLatin1String( "statementRemoved" )
+                             << QLatin1String( "statementsAdded" )
+                             << QLatin1String( "statementsRemoved" )
+                             << QLatin1String( "statementsAddedBatch" )
+                             << QLatin1String( "statementsRemovedBatch" )
+                             << QLatin1String( "statementsChanged" );
+    }
+}
+
+
+LegacyQueryResultIterator::LegacyQueryResultIterator( const QList<BindingSet>& rows )
+    : QObject(),
+      m_rows( rows ),
+      m_pos( -1 )
+{
+}
+
+
+bool LegacyQueryResultIterator::next()
+{
+    return ++m_pos < m_rows.count();
+}
+
+
+BindingSet LegacyQueryResultIterator::current()
+{
+    return m_rows.value( m_pos );
+}
+
+
+Statement LegacyQueryResultIterator::currentStatement()
+{
+    return Statement();
+}
+
+
+Node LegacyQueryResultIterator::bindingByName( const QString& name )
+{
+    return current()[name];
+}
+
+
+Node LegacyQueryResultIterator::bindingByIndex( int offset )
+{
+    return current()[offset];
+}
+
+
+int LegacyQueryResultIterator::bindingCount()
+{
+    return bindingNames().count();
+}
+
+
+QStringList LegacyQueryResultIterator::bindingNames()
+{
+    return m_rows.isEmpty() ? QStringList() : m_rows.first().bindingNames();
+}
+
+
+bool LegacyQueryResultIterator::isGraph()
+{
+    return false;
+}
+
+
+bool LegacyQueryResultIterator::isBinding()
+{
+    return true;
+}
+
+
+bool LegacyQueryResultIterator::isBool()
+{
+    return false;
+}
+
+
+bool LegacyQueryResultIterator::boolValue()
+{
+    return false;
+}
+
+
+void LegacyQueryResultIterator::close()
+{
+    m_pos = m_rows.count();
+}
+
+
+void DBusExportModelTest::slotSignal( const QDBusMessage& msg )
+{
+    ++m_signalCounts[msg.member()];
+    if ( msg.member() == QLatin1String( "statementsChanged" ) ) {
+        m_lastSummary = msg.arguments();
+    }
+}
+
+
+void DBusExportModelTest::waitForSignals( const QString& name, int count )
+{
+    for ( int i = 0; i < 100 && m_signalCounts.value( name ) < count; ++i ) {
+        QTest::qWait( 50 );
+    }
+    // give surplus signals the chance to arrive
+    QTest::qWait( 200 );
+}
+
+
+void DBusExportModelTest::initTestCase()
+{
+    QVERIFY( QDBusConnection::sessionBus().isConnected() );
+
+    // we listen to the signals on the bus, not to the ones of the Qt objects
+    Q_FOREACH( const QString& name, changeSignalNames() ) {
+        QVERIFY( QDBusConnection::sessionBus().connect( QString(), QLatin1String( s_objectPath ), QLatin1String( s_interface ),
+                                                        name, this, SLOT(slotSignal(QDBusMessage)) ) );
+    }
+
+    qDBusRegisterMetaType<Soprano::Node>();
+    qDBusRegisterMetaType<Soprano::Statement>();
+    qDBusRegisterMetaType<Soprano::BindingSet>();
+}
+
+
+void DBusExportModelTest::init()
+{
+    QList<BackendSetting> settings;
+    settings.append( BackendSetting( BackendOptionStorageMemory ) );
+    m_model = createModel( settings );
+    QVERIFY( m_model != 0 );
+
+    m_exportModel = new Server::DBusExportModel( m_model );
+    QVERIFY( m_exportModel->registerModel( QLatin1String( s_objectPath ) ) );
+
+    m_signalCounts.clear();
+    m_lastSummary.clear();
+}
+
+
+void DBusExportModelTest::cleanup()
+{
+    delete m_exportModel;
+    delete m_model;
+}
+
+
+void DBusExportModelTest::testSingleAdd()
+{
+    // the defaults only publish the signals earlier versions did
+    QCOMPARE( m_exportModel->addStatement( testStatement( 0 ) ), Error::ErrorNone );
+    waitForSignals( QLatin1String( "statementsAdded" ), 1 );
+
+    QCOMPARE( m_signalCounts.value( QLatin1String( "statementAdded" ) ), 1 );
+    QCOMPARE( m_signalCounts.value( QLatin1String( "statementsAdded" ) ), 1 );
+    QCOMPARE( m_signalCounts.value( QLatin1String( "statementsAddedBatch" ) ), 0 );
+    QCOMPARE( m_signalCounts.value( QLatin1String( "statementsChanged" ) ), 0 );
+}
+
+
+void DBusExportModelTest::testSingleAddWithSummary()
+{
+    m_exportModel->setChangeSignals( Server::DBusExportModel::SummarySignals );
+
+    // the per-statement signal and the summary signal of the parent model
+    // must not result in two notifications, one of them without counts
+    QCOMPARE( m_exportModel->addStatement( testStatement( 0 ) ), Error::ErrorNone );
+    waitForSignals( QLatin1String( "statementsAdded" ), 1 );
+
+    QCOMPARE( m_signalCounts.value( QLatin1String( "statementAdded" ) ), 0 );
+    QCOMPARE( m_signalCounts.value( QLatin1String( "statementsAdded" ) ), 1 );
+    QCOMPARE( m_signalCounts.value( QLatin1String( "statementsChanged" ) ), 1 );
+    QCOMPARE( m_lastSummary.count(), 2 );
+    QCOMPARE( m_lastSummary[0].toInt(), 1 );
+    QCOMPARE( m_lastSummary[1].toInt(), 0 );
+}
+
+
+void DBusExportModelTest::testBatchedAdd()
+{
+    m_exportModel->setChangeSignals( Server::DBusExportModel::StatementBatchSignals|Server::DBusExportModel::SummarySignals );
+    m_exportModel->setSignalCacheTime( 100 );
+
+    QList<Statement> statements;
+    for ( int i = 0; i < 3; ++i ) {
+        statements.append( testStatement( i ) );
+    }
+    QCOMPARE( m_exportModel->addStatements( statements ), Error::ErrorNone );
+    waitForSignals( QLatin1String( "statementsAdded" ), 1 );
+
+    // all changes are coalesced into one notification of each enabled form
+    QCOMPARE( m_signalCounts.value( QLatin1String( "statementAdded" ) ), 0 );
+    QCOMPARE( m_signalCounts.value( QLatin1String( "statementsAdded" ) ), 1 );
+    QCOMPARE( m_signalCounts.value( QLatin1String( "statementsAddedBatch" ) ), 1 );
+    QCOMPARE( m_signalCounts.value( QLatin1String( "statementsChanged" ) ), 1 );
+    QCOMPARE( m_lastSummary[0].toInt(), 3 );
+    QCOMPARE( m_lastSummary[1].toInt(), 0 );
+}
+
+
+void DBusExportModelTest::testClientSignals()
+{
+    m_exportModel->setChangeSignals( Server::DBusExportModel::StatementBatchSignals|Server::DBusExportModel::SummarySignals );
+
+    // the client forwards the coalesced signals once they are connected to
+    Client::DBusModel client( QDBusConnection::sessionBus().baseService(), QLatin1String( s_objectPath ) );
+    QSignalSpy batchSpy( &client, SIGNAL(statementsAddedBatch(QList<Soprano::Statement>)) );
+    QSignalSpy summarySpy( &client, SIGNAL(statementsChanged(int,int)) );
+
+    QCOMPARE( m_exportModel->addStatement( testStatement( 0 ) ), Error::ErrorNone );
+    waitForSignals( QLatin1String( "statementsChanged" ), 1 );
+
+    QCOMPARE( batchSpy.count(), 1 );
+    QCOMPARE( summarySpy.count(), 1 );
+    QCOMPARE( summarySpy.first()[0].toInt(), 1 );
+    QCOMPARE( summarySpy.first()[1].toInt(), 0 );
+}
+
+
+void DBusExportModelTest::testQueryResultBatches()
+{
+    QSet<Node> subjects;
+    for ( int i = 0; i < s_batchTestCount; ++i ) {
+        QCOMPARE( m_model->addStatement( testStatement( i ) ), Error::ErrorNone );
+        subjects.insert( testStatement( i ).subject() );
+    }
+
+    Client::DBusModel client( QDBusConnection::sessionBus().baseService(), QLatin1String( s_objectPath ) );
+
+    // binding results are read via nextBatch
+    QueryResultIterator it = client.executeQuery( QLatin1String( "select ?s ?o where { ?s ?p ?o . }" ), Query::QueryLanguageSparql );
+    QVERIFY( it.isValid() );
+    QSet<Node> seen;
+    while ( it.next() ) {
+        QCOMPARE( it.binding( QLatin1String( "o" ) ).literal().toInt(),
+                  it.binding( 0 ).uri().fragment().mid( 1 ).toInt() );
+        seen.insert( it.binding( 0 ) );
+    }
+    QVERIFY( !it.lastError() );
+    QVERIFY( seen == subjects );
+
+    // graph results via nextStatementBatch
+    it = client.executeQuery( QLatin1String( "construct { ?s ?p ?o . } where { ?s ?p ?o . }" ), Query::QueryLanguageSparql );
+    QVERIFY( it.isValid() );
+    QCOMPARE( it.iterateStatements().allStatements().count(), s_batchTestCount );
+
+    // and statement iterators
+    QCOMPARE( client.listStatements().allStatements().count(), s_batchTestCount );
+}
+
+
+void DBusExportModelTest::testQueryResultClose()
+{
+    for ( int i = 0; i < s_batchTestCount; ++i ) {
+        QCOMPARE( m_model->addStatement( testStatement( i ) ), Error::ErrorNone );
+    }
+
+    Client::DBusModel client( QDBusConnection::sessionBus().baseService(), QLatin1String( s_objectPath ) );
+
+    // the first batch has been fetched, the remaining rows must not show up after closing
+    QueryResultIterator it = client.executeQuery( QLatin1String( "select ?s where { ?s ?p ?o . }" ), Query::QueryLanguageSparql );
+    QVERIFY( it.next() );
+    it.close();
+    QVERIFY( !it.next() );
+
+    StatementIterator sit = client.listStatements();
+    QVERIFY( sit.next() );
+    sit.close();
+    QVERIFY( !sit.next() );
+}
+
+
+void DBusExportModelTest::testQueryResultFallback()
+{
+    QList<BindingSet> rows;
+    for ( int i = 0; i < 3; ++i ) {
+        BindingSet set;
+        set.insert( QLatin1String( "s" ), testStatement( i ).subject() );
+        set.insert( QLatin1String( "o" ), testStatement( i ).object() );
+        rows.append( set );
+    }
+
+    LegacyQueryResultIterator legacyIterator( rows );
+    QVERIFY( QDBusConnection::sessionBus().registerObject( QLatin1String( s_legacyIteratorPath ), &legacyIterator,
+                                                           QDBusConnection::ExportAllSlots ) );
+
+    // the server does not know nextBatch, the client has to fall back to single rows
+    Client::DBusQueryResultIterator it( QDBusConnection::sessionBus().baseService(), QLatin1String( s_legacyIteratorPath ) );
+    QList<BindingSet> result;
+    while ( it.next() ) {
+        QVERIFY( !it.lastError() );
+        result.append( it.current() );
+        QCOMPARE( it.binding( QLatin1String( "s" ) ), result.last()[QLatin1String( "s" )] );
+    }
+    QVERIFY( !it.lastError() );
+
+    QDBusConnection::sessionBus().unregisterObject( QLatin1String( s_legacyIteratorPath ) );
+
+    QCOMPARE( result.count(), rows.count() );
+    for ( int i = 0; i < rows.count(); ++i ) {
+        QCOMPARE( result[i][QLatin1String( "s" )], rows[i][QLatin1String( "s" )] );
+        QCOMPARE( result[i][QLatin1String( "o" )], rows[i][QLatin1String( "o" )] );
+    }
+}
+
+QTEST_MAIN( DBusExportModelTest )
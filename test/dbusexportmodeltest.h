@@ -0,0 +1,104 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef _DBUS_EXPORT_MODEL_TEST_H_
+#define _DBUS_EXPORT_MODEL_TEST_H_
+
+#include <QtCore/QObject>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <QtCore/QStringList>
+
+#include "bindingset.h"
+#include "statement.h"
+
+class QDBusMessage;
+
+namespace Soprano {
+    class Model;
+    namespace Server {
+        class DBusExportModel;
+    }
+}
+
+/**
+ * A query result iterator as exported by servers which
+ * do not support the batch methods yet.
+ */
+class LegacyQueryResultIterator : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "D-Bus Interface", "org.soprano.QueryResultIterator" )
+
+public:
+    LegacyQueryResultIterator( const QList<Soprano::BindingSet>& rows );
+
+public Q_SLOTS:
+    bool next();
+    Soprano::BindingSet current();
+    Soprano::Statement currentStatement();
+    Soprano::Node bindingByName( const QString& name );
+    Soprano::Node bindingByIndex( int offset );
+    int bindingCount();
+    QStringList bindingNames();
+    bool isGraph();
+    bool isBinding();
+    bool isBool();
+    bool boolValue();
+    void close();
+
+private:
+    QList<Soprano::BindingSet> m_rows;
+    int m_pos;
+};
+
+class DBusExportModelTest : public QObject
+{
+    Q_OBJECT
+
+public Q_SLOTS:
+    void slotSignal( const QDBusMessage& msg );
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void testSingleAdd();
+    void testSingleAddWithSummary();
+    void testBatchedAdd();
+    void testClientSignals();
+    void testQueryResultBatches();
+    void testQueryResultClose();
+    void testQueryResultFallback();
+
+private:
+    void waitForSignals( const QString& name, int count );
+
+    Soprano::Model* m_model;
+    Soprano::Server::DBusExportModel* m_exportModel;
+    QHash<QString, int> m_signalCounts;
+    QList<QVariant> m_lastSummary;
+};
+
+#endif
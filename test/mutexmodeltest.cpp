@@ -0,0 +1,100 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "mutexmodeltest.h"
+
+#include <QtTest/QTest>
+#include <QtCore/QDebug>
+
+#include "../soprano/soprano.h"
+#include "../soprano/util/mutexmodel.h"
+
+using namespace Soprano;
+
+namespace {
+    QUrl testUri( const char* name ) {
+        return QUrl( QLatin1String( "http://soprano.org/test#" ) + QLatin1String( name ) );
+    }
+}
+
+
+void MutexModelTest::init()
+{
+    QList<BackendSetting> settings;
+    settings.append( BackendSetting( BackendOptionStorageMemory ) );
+    m_model = createModel( settings );
+    QVERIFY( m_model != 0 );
+
+    m_model->addStatement( testUri( "A" ), testUri( "p" ), LiteralValue( "a" ), testUri( "g1" ) );
+    m_model->addStatement( testUri( "B" ), testUri( "p" ), LiteralValue( "b" ), testUri( "g2" ) );
+}
+
+
+void MutexModelTest::cleanup()
+{
+    delete m_model;
+}
+
+
+void MutexModelTest::testSnapshotListStatements()
+{
+    Util::MutexModel mutexModel( Util::MutexModel::SnapshotMultiThreading, m_model );
+
+    // writing while an iterator is open does not block
+    StatementIterator it = mutexModel.listStatements();
+    QVERIFY( it.next() );
+    QVERIFY( mutexModel.addStatement( testUri( "C" ), testUri( "p" ), LiteralValue( "c" ) ) == Error::ErrorNone );
+
+    // the iterator sees the state at the time it was created
+    int cnt = 1;
+    while ( it.next() ) {
+        ++cnt;
+    }
+    QCOMPARE( cnt, 2 );
+    QCOMPARE( mutexModel.listStatements().allStatements().count(), 3 );
+}
+
+
+void MutexModelTest::testSnapshotExecuteQuery()
+{
+    Util::MutexModel mutexModel( Util::MutexModel::SnapshotMultiThreading, m_model );
+
+    QueryResultIterator it = mutexModel.executeQuery( QString::fromLatin1( "select ?r where { ?r %1 ?o . }" )
+                                                      .arg( Node::resourceToN3( testUri( "p" ) ) ),
+                                                      Query::QueryLanguageSparql );
+    QVERIFY( it.isValid() );
+    QVERIFY( it.isBinding() );
+    QVERIFY( mutexModel.removeAllStatements( testUri( "A" ), Node(), Node() ) == Error::ErrorNone );
+    QCOMPARE( it.allBindings().count(), 2 );
+}
+
+
+void MutexModelTest::testSnapshotListContexts()
+{
+    Util::MutexModel mutexModel( Util::MutexModel::SnapshotMultiThreading, m_model );
+
+    NodeIterator it = mutexModel.listContexts();
+    QVERIFY( mutexModel.addStatement( testUri( "C" ), testUri( "p" ), LiteralValue( "c" ), testUri( "g3" ) ) == Error::ErrorNone );
+    QCOMPARE( it.allNodes().count(), 2 );
+    QCOMPARE( mutexModel.listContexts().allNodes().count(), 3 );
+}
+
+QTEST_MAIN( MutexModelTest )
@@ -31,6 +31,23 @@
 
 using namespace Soprano;
 
+namespace {
+    /// Swallows all signals of its parent like Virtuoso with noStatementSignals
+    class SilentModel : public FilterModel
+    {
+    public:
+        SilentModel( Model* parent )
+            : FilterModel( parent ) {
+        }
+
+    protected:
+        void parentStatementsAdded() {}
+        void parentStatementsRemoved() {}
+        void parentStatementAdded( const Statement& ) {}
+        void parentStatementRemoved( const Statement& ) {}
+    };
+}
+
 
 void NRLModelTest::init()
 {
@@ -80,5 +97,66 @@ void NRLModelTest::testAddStatement()
     m_nrlModel->addStatement( s3 );
 }
 
+
+void NRLModelTest::testCardinalityCache()
+{
+    Statement s1( QUrl( "http://soprano.org/test#A" ),
+                  QUrl( "http://soprano.org/test#prop2" ),
+                  QUrl( "http://soprano.org/test#B" ) );
+    Statement s2( QUrl( "http://soprano.org/test#A" ),
+                  QUrl( "http://soprano.org/test#prop2" ),
+                  QUrl( "http://soprano.org/test#C" ) );
+
+    // no restrictions yet
+    QCOMPARE( m_nrlModel->addNrlStatement( s1 ), Error::ErrorNone );
+    QCOMPARE( m_nrlModel->addNrlStatement( s2 ), Error::ErrorNone );
+    QVERIFY( m_model->containsStatement( s1 ) );
+    QVERIFY( m_model->containsStatement( s2 ) );
+
+    // adding a restriction to the parent model needs to invalidate the cache
+    m_model->addStatement( Statement( s1.predicate(), Vocabulary::NRL::maxCardinality(), LiteralValue( 1 ) ) );
+
+    QCOMPARE( m_nrlModel->addNrlStatement( s1 ), Error::ErrorNone );
+    QVERIFY( m_model->containsStatement( s1 ) );
+    QVERIFY( !m_model->containsStatement( s2 ) );
+
+    // and removing it again, too
+    m_model->removeAllStatements( Statement( s1.predicate(), Vocabulary::NRL::maxCardinality(), Node() ) );
+
+    QCOMPARE( m_nrlModel->addNrlStatement( s2 ), Error::ErrorNone );
+    QVERIFY( m_model->containsStatement( s1 ) );
+    QVERIFY( m_model->containsStatement( s2 ) );
+}
+
+void NRLModelTest::testCardinalityCacheWithoutSignals()
+{
+    Statement s1( QUrl( "http://soprano.org/test#A" ),
+                  QUrl( "http://soprano.org/test#prop3" ),
+                  QUrl( "http://soprano.org/test#B" ) );
+    Statement s2( QUrl( "http://soprano.org/test#A" ),
+                  QUrl( "http://soprano.org/test#prop3" ),
+                  QUrl( "http://soprano.org/test#C" ) );
+
+    SilentModel silentModel( m_model );
+    NRLModel nrlModel( &silentModel );
+
+    QCOMPARE( nrlModel.addNrlStatement( s1 ), Error::ErrorNone );
+    QCOMPARE( nrlModel.addNrlStatement( s2 ), Error::ErrorNone );
+    QVERIFY( m_model->containsStatement( s2 ) );
+
+    // restrictions written through the NRLModel itself invalidate the cache without any signal
+    QCOMPARE( nrlModel.addStatement( Statement( s1.predicate(), Vocabulary::NRL::maxCardinality(), LiteralValue( 1 ) ) ), Error::ErrorNone );
+
+    QCOMPARE( nrlModel.addNrlStatement( s1 ), Error::ErrorNone );
+    QVERIFY( m_model->containsStatement( s1 ) );
+    QVERIFY( !m_model->containsStatement( s2 ) );
+
+    QCOMPARE( nrlModel.removeAllStatements( Statement( s1.predicate(), Vocabulary::NRL::maxCardinality(), Node() ) ), Error::ErrorNone );
+
+    QCOMPARE( nrlModel.addNrlStatement( s2 ), Error::ErrorNone );
+    QVERIFY( m_model->containsStatement( s1 ) );
+    QVERIFY( m_model->containsStatement( s2 ) );
+}
+
 QTEST_MAIN( NRLModelTest )
 
@@ -36,6 +36,8 @@ class NRLModelTest: public QObject
 private Q_SLOTS:
     void init();
     void testAddStatement();
+    void testCardinalityCache();
+    void testCardinalityCacheWithoutSignals();
     void cleanup();
 
 private:
@@ -0,0 +1,146 @@
+/* 
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "rdfschemamodeltest.h"
+
+#include <QtTest/QTest>
+#include <QtCore/QDebug>
+
+#include "../soprano/soprano.h"
+#include "../soprano/rdfschemamodel.h"
+
+using namespace Soprano;
+
+namespace {
+    QUrl testUri( const char* name ) {
+        return QUrl( QLatin1String( "http://soprano.org/test#" ) + QLatin1String( name ) );
+    }
+
+    /// Swallows all signals of its parent like Virtuoso with noStatementSignals
+    class SilentModel : public FilterModel
+    {
+    public:
+        SilentModel( Model* parent )
+            : FilterModel( parent ) {
+        }
+
+    protected:
+        void parentStatementsAdded() {}
+        void parentStatementsRemoved() {}
+        void parentStatementAdded( const Statement& ) {}
+        void parentStatementRemoved( const Statement& ) {}
+    };
+}
+
+
+void RdfSchemaModelTest::init()
+{
+    QList<BackendSetting> settings;
+    settings.append( BackendSetting( BackendOptionStorageMemory ) );
+    m_model = createModel( settings );
+    QVERIFY( m_model != 0 );
+
+    m_rdfsModel = new RdfSchemaModel( m_model );
+
+    // A -> B -> C, D -> C
+    m_model->addStatement( testUri( "A" ), Vocabulary::RDFS::subClassOf(), testUri( "B" ) );
+    m_model->addStatement( testUri( "B" ), Vocabulary::RDFS::subClassOf(), testUri( "C" ) );
+    m_model->addStatement( testUri( "D" ), Vocabulary::RDFS::subClassOf(), testUri( "C" ) );
+
+    // p1 -> p2 -> p3
+    m_model->addStatement( testUri( "p1" ), Vocabulary::RDFS::subPropertyOf(), testUri( "p2" ) );
+    m_model->addStatement( testUri( "p2" ), Vocabulary::RDFS::subPropertyOf(), testUri( "p3" ) );
+}
+
+
+void RdfSchemaModelTest::cleanup()
+{
+    delete m_rdfsModel;
+    delete m_model;
+}
+
+
+void RdfSchemaModelTest::testSubClassOf()
+{
+    QVERIFY( m_rdfsModel->isSubClassOf( testUri( "A" ), testUri( "B" ) ) );
+    QVERIFY( m_rdfsModel->isSubClassOf( testUri( "A" ), testUri( "C" ) ) );
+    QVERIFY( m_rdfsModel->isSubClassOf( testUri( "D" ), testUri( "C" ) ) );
+    QVERIFY( !m_rdfsModel->isSubClassOf( testUri( "C" ), testUri( "A" ) ) );
+    QVERIFY( !m_rdfsModel->isSubClassOf( testUri( "D" ), testUri( "B" ) ) );
+
+    QCOMPARE( m_rdfsModel->subClassOf( testUri( "A" ) ).allStatements().count(), 2 );
+    QCOMPARE( m_rdfsModel->subClassOf( Node(), testUri( "C" ) ).allStatements().count(), 3 );
+    QCOMPARE( m_rdfsModel->subClassOf( Node(), Node() ).allStatements().count(), 4 );
+}
+
+
+void RdfSchemaModelTest::testSubPropertyOf()
+{
+    QVERIFY( m_rdfsModel->isSubPropertyOf( testUri( "p1" ), testUri( "p3" ) ) );
+    QVERIFY( !m_rdfsModel->isSubPropertyOf( testUri( "p3" ), testUri( "p1" ) ) );
+    QCOMPARE( m_rdfsModel->subPropertyOf( testUri( "p1" ) ).allStatements().count(), 2 );
+}
+
+
+void RdfSchemaModelTest::testType()
+{
+    m_model->addStatement( testUri( "x" ), Vocabulary::RDF::type(), testUri( "A" ) );
+    m_model->addStatement( testUri( "y" ), Vocabulary::RDF::type(), testUri( "D" ) );
+
+    QVERIFY( m_rdfsModel->isType( testUri( "x" ), testUri( "C" ) ) );
+    QVERIFY( m_rdfsModel->isType( testUri( "y" ), testUri( "C" ) ) );
+    QVERIFY( !m_rdfsModel->isType( testUri( "y" ), testUri( "B" ) ) );
+
+    QCOMPARE( m_rdfsModel->type( testUri( "x" ), Node() ).allStatements().count(), 3 );
+    QCOMPARE( m_rdfsModel->type( Node(), testUri( "C" ) ).allStatements().count(), 2 );
+}
+
+
+void RdfSchemaModelTest::testInvalidation()
+{
+    QVERIFY( !m_rdfsModel->isSubClassOf( testUri( "C" ), testUri( "E" ) ) );
+
+    m_model->addStatement( testUri( "C" ), Vocabulary::RDFS::subClassOf(), testUri( "E" ) );
+    QVERIFY( m_rdfsModel->isSubClassOf( testUri( "A" ), testUri( "E" ) ) );
+
+    m_model->removeStatement( testUri( "B" ), Vocabulary::RDFS::subClassOf(), testUri( "C" ) );
+    QVERIFY( !m_rdfsModel->isSubClassOf( testUri( "A" ), testUri( "E" ) ) );
+    QVERIFY( m_rdfsModel->isSubClassOf( testUri( "D" ), testUri( "E" ) ) );
+}
+
+void RdfSchemaModelTest::testInvalidationWithoutSignals()
+{
+    SilentModel silentModel( m_model );
+    RdfSchemaModel rdfsModel( &silentModel );
+    QVERIFY( !rdfsModel.isSubClassOf( testUri( "C" ), testUri( "E" ) ) );
+
+    // schema changes written through the model itself invalidate the hierarchies without any signal
+    QCOMPARE( rdfsModel.addStatement( testUri( "C" ), Vocabulary::RDFS::subClassOf(), testUri( "E" ) ), Error::ErrorNone );
+    QVERIFY( rdfsModel.isSubClassOf( testUri( "A" ), testUri( "E" ) ) );
+
+    QCOMPARE( rdfsModel.removeStatement( testUri( "B" ), Vocabulary::RDFS::subClassOf(), testUri( "C" ) ), Error::ErrorNone );
+    QVERIFY( !rdfsModel.isSubClassOf( testUri( "A" ), testUri( "E" ) ) );
+
+    QCOMPARE( rdfsModel.removeAllStatements( testUri( "D" ), Node(), Node() ), Error::ErrorNone );
+    QVERIFY( !rdfsModel.isSubClassOf( testUri( "D" ), testUri( "E" ) ) );
+}
+
+QTEST_MAIN( RdfSchemaModelTest )
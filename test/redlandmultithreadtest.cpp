@@ -24,10 +24,114 @@
 #include <soprano.h>
 
 #include <QtTest/QtTest>
+#include <QtTest/QSignalSpy>
+#include <QtCore/QThread>
 
 using namespace Soprano;
 
 
+namespace {
+    const int s_readThreadStatementCount = 1000;
+    const int s_writeThreadStatementCount = 200;
+
+    Statement readTestStatement( int i )
+    {
+        return Statement( QUrl( QString::fromLatin1( "http://soprano.org/test#R%1" ).arg( i % 100 ) ),
+                          QUrl( QString::fromLatin1( "http://soprano.org/test#p%1" ).arg( i % 10 ) ),
+                          LiteralValue( i ) );
+    }
+
+    /**
+     * Lists all statements and checks the existence of each of them a number of times.
+     */
+    class ReadThread : public QThread
+    {
+    public:
+        ReadThread( Model* model, int rounds, int statementCount = s_readThreadStatementCount )
+            : m_model( model ),
+              m_rounds( rounds ),
+              m_statementCount( statementCount ),
+              m_success( false ) {
+        }
+
+        bool success() const {
+            return m_success;
+        }
+
+    protected:
+        void run() {
+            m_success = true;
+            for ( int round = 0; round < m_rounds; ++round ) {
+                int cnt = 0;
+                StatementIterator it = m_model->listStatements();
+                while ( it.next() ) {
+                    // ignore the statements of a concurrent WriteThread
+                    if ( it.current().context().isEmpty() ) {
+                        ++cnt;
+                    }
+                }
+                if ( cnt != m_statementCount ) {
+                    qDebug() << "Invalid count:" << cnt;
+                    m_success = false;
+                }
+                for ( int i = 0; i < m_statementCount; i += 10 ) {
+                    if ( !m_model->containsAnyStatement( readTestStatement( i ) ) ) {
+                        m_success = false;
+                    }
+                }
+            }
+        }
+
+    private:
+        Model* m_model;
+        int m_rounds;
+        int m_statementCount;
+        bool m_success;
+    };
+
+    Statement writeTestStatement( int i )
+    {
+        return Statement( QUrl( QString::fromLatin1( "http://soprano.org/test#W%1" ).arg( i ) ),
+                          QUrl( QLatin1String( "http://soprano.org/test#w" ) ),
+                          LiteralValue( i ),
+                          QUrl( QLatin1String( "http://soprano.org/test#writeGraph" ) ) );
+    }
+
+    /**
+     * Adds a number of statements one by one and removes them all again.
+     */
+    class WriteThread : public QThread
+    {
+    public:
+        WriteThread( Model* model )
+            : m_model( model ),
+              m_success( false ) {
+        }
+
+        bool success() const {
+            return m_success;
+        }
+
+    protected:
+        void run() {
+            m_success = true;
+            for ( int i = 0; i < s_writeThreadStatementCount; ++i ) {
+                if ( m_model->addStatement( writeTestStatement( i ) ) != Error::ErrorNone ) {
+                    m_success = false;
+                }
+            }
+            if ( m_model->removeAllStatements( Node(), QUrl( QLatin1String( "http://soprano.org/test#w" ) ), Node() ) != Error::ErrorNone ) {
+                m_success = false;
+            }
+        }
+
+    private:
+        Model* m_model;
+        bool m_success;
+    };
+}
+
+
 Soprano::Model* RedlandMultiThreadTest::createModel()
 {
     const Soprano::Backend* b = Soprano::discoverBackendByName( "redland" );
@@ -38,5 +142,124 @@ Soprano::Model* RedlandMultiThreadTest::createModel()
 }
 
 
+void RedlandMultiThreadTest::testConcurrentIterators()
+{
+    Model* model = createModel();
+    QVERIFY( model );
+    model->addStatement( readTestStatement( 0 ) );
+    model->addStatement( readTestStatement( 1 ) );
+
+    // an open iterator in one thread must not block reading in another one
+    StatementIterator it = model->listStatements();
+    QVERIFY( it.next() );
+
+    ReadThread* reader = new ReadThread( model, 1, 2 );
+    reader->start();
+    QVERIFY( reader->wait( 2000 ) );
+    QVERIFY( reader->success() );
+    delete reader;
+
+    QueryResultIterator qit = model->executeQuery( "select * where { ?s ?p ?o . }", Query::QueryLanguageSparql );
+    QVERIFY( qit.next() );
+    qit.close();
+
+    it.close();
+    delete model;
+}
+
+
+void RedlandMultiThreadTest::testConcurrentReadsAndWrites()
+{
+    Model* model = createModel();
+    QVERIFY( model );
+    for ( int i = 0; i < s_readThreadStatementCount; ++i ) {
+        QCOMPARE( model->addStatement( readTestStatement( i ) ), Error::ErrorNone );
+    }
+
+    qRegisterMetaType<Soprano::Statement>( "Soprano::Statement" );
+    QSignalSpy addedSpy( model, SIGNAL(statementAdded(Soprano::Statement)) );
+    QSignalSpy statementsAddedSpy( model, SIGNAL(statementsAdded()) );
+    QSignalSpy removedSpy( model, SIGNAL(statementRemoved(Soprano::Statement)) );
+    QSignalSpy statementsRemovedSpy( model, SIGNAL(statementsRemoved()) );
+
+    QList<QThread*> threads;
+    QList<ReadThread*> readers;
+    for ( int i = 0; i < qMax( 2, QThread::idealThreadCount() ); ++i ) {
+        ReadThread* reader = new ReadThread( model, 5 );
+        readers.append( reader );
+        threads.append( reader );
+    }
+    WriteThread* writer = new WriteThread( model );
+    threads.append( writer );
+
+    Q_FOREACH( QThread* t, threads ) {
+        t->start();
+    }
+    Q_FOREACH( QThread* t, threads ) {
+        QVERIFY( t->wait( 60000 ) );
+    }
+
+    Q_FOREACH( ReadThread* t, readers ) {
+        QVERIFY( t->success() );
+    }
+    QVERIFY( writer->success() );
+    qDeleteAll( threads );
+
+    // all written statements have been removed again
+    QCOMPARE( model->statementCount(), s_readThreadStatementCount );
+
+    // one signal per statement and one summary per call, readers do not emit anything
+    QCOMPARE( addedSpy.count(), s_writeThreadStatementCount );
+    QCOMPARE( statementsAddedSpy.count(), s_writeThreadStatementCount );
+    QCOMPARE( removedSpy.count(), s_writeThreadStatementCount );
+    QCOMPARE( statementsRemovedSpy.count(), 1 );
+
+    delete model;
+}
+
+
+void RedlandMultiThreadTest::benchmarkConcurrentReads_data()
+{
+    QTest::addColumn<int>( "threads" );
+
+    // each thread does the same amount of work, thus with concurrent reads
+    // the time should not grow with the number of threads
+    QTest::newRow( "1 reader" ) << 1;
+    const int threads = qMax( 2, QThread::idealThreadCount() );
+    QTest::newRow( QString::fromLatin1( "%1 readers" ).arg( threads ).toLatin1().data() ) << threads;
+}
+
+
+void RedlandMultiThreadTest::benchmarkConcurrentReads()
+{
+    QFETCH( int, threads );
+
+    Model* model = createModel();
+    QVERIFY( model );
+    for ( int i = 0; i < s_readThreadStatementCount; ++i ) {
+        QCOMPARE( model->addStatement( readTestStatement( i ) ), Error::ErrorNone );
+    }
+
+    bool success = true;
+    QBENCHMARK {
+        QList<ReadThread*> readers;
+        for ( int i = 0; i < threads; ++i ) {
+            readers.append( new ReadThread( model, 5 ) );
+        }
+        Q_FOREACH( ReadThread* t, readers ) {
+            t->start();
+        }
+        Q_FOREACH( ReadThread* t, readers ) {
+            t->wait();
+            success = success && t->success();
+        }
+        qDeleteAll( readers );
+    }
+    QVERIFY( success );
+
+    delete model;
+}
+
+
 QTEST_MAIN( RedlandMultiThreadTest )
 
@@ -32,6 +32,12 @@ class RedlandMultiThreadTest : public MultiThreadingTest
 {
     Q_OBJECT
 
+private Q_SLOTS:
+    void testConcurrentIterators();
+    void testConcurrentReadsAndWrites();
+    void benchmarkConcurrentReads_data();
+    void benchmarkConcurrentReads();
+
 protected:
     virtual Soprano::Model* createModel();
 };
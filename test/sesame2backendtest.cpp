@@ -55,5 +55,50 @@ void Sesame2BackendTest::testIteratorClose()
     QVERIFY( m_model->removeStatement( m_st2 ) == Error::ErrorNone );
 }
 
+
+void Sesame2BackendTest::testBulkTransfer()
+{
+    QVERIFY( m_model->removeAllStatements() == Error::ErrorNone );
+
+    // characters outside the BMP take two UTF-16 code units which the encoding has to count correctly
+    const QString nonBmp = QString::fromUtf8( "smile \xF0\x9F\x98\x80 and \xF0\x9D\x84\x9E clef" );
+
+    // more than one block in both directions
+    QList<Statement> statements;
+    for ( int i = 0; i < 1200; ++i ) {
+        Node object;
+        switch( i % 4 ) {
+        case 0:
+            object = LiteralValue( i );
+            break;
+        case 1:
+            object = LiteralValue::createPlainLiteral( nonBmp + QString::number( i ), QLatin1String( "en" ) );
+            break;
+        case 2:
+            object = LiteralValue( QString::fromLatin1( "colon: 12:34 %1" ).arg( i ) );
+            break;
+        default:
+            object = QUrl( QString::fromLatin1( "http://soprano.sf.net/test#object%1" ).arg( i ) );
+            break;
+        }
+        statements.append( Statement( QUrl( QString::fromLatin1( "http://soprano.sf.net/test#subject%1" ).arg( i % 50 ) ),
+                                      QUrl( "http://soprano.sf.net/test#predicate" ),
+                                      object,
+                                      i % 2 ? Node() : Node( QUrl( "http://soprano.sf.net/test#graph" ) ) ) );
+    }
+
+    Error::ErrorCode r = Error::ErrorUnknown;
+    QVERIFY( QMetaObject::invokeMethod( m_model, "addStatements", Qt::DirectConnection,
+                                        Q_RETURN_ARG( Soprano::Error::ErrorCode, r ),
+                                        Q_ARG( QList<Soprano::Statement>, statements ) ) );
+    QCOMPARE( r, Error::ErrorNone );
+
+    StatementIterator it = m_model->listStatements();
+    QList<Statement> listed = it.allStatements();
+    QVERIFY( !it.lastError() );
+    QCOMPARE( listed.count(), statements.count() );
+    QCOMPARE( listed.toSet(), statements.toSet() );
+}
+
 QTEST_MAIN( Sesame2BackendTest )
 
@@ -40,6 +40,12 @@ private Q_SLOTS:
      */
     void testIteratorClose();
 
+    /**
+     * Statements are transferred to and from Java in blocks of
+     * encoded strings. Make sure nothing is lost on the way.
+     */
+    void testBulkTransfer();
+
 protected:
     virtual Soprano::Model* createModel();
 };
@@ -0,0 +1,356 @@
+/*
+ * This file is part of Soprano Project.
+ *
+ * Copyright (C) 2026 The Soprano developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "sparqlresultparsertest.h"
+
+#include <QtTest/QTest>
+#include <QtCore/QDebug>
+
+#include "../client/sparql/sparqlxmlresultparser.h"
+#include "../client/sparql/sparqljsonresultparser.h"
+#include "../client/sparql/sparqltsvresultparser.h"
+#include "../soprano/vocabulary/xsd.h"
+
+using namespace Soprano::Client::SparqlParser;
+
+namespace {
+    /**
+     * Hands out the data in chunks of a fixed size to simulate a
+     * response which is still being received.
+     */
+    class ChunkedDataSource : public StreamReader::DataSource
+    {
+    public:
+        ChunkedDataSource( const QByteArray& data, int chunkSize )
+            : m_data( data ),
+              m_chunkSize( chunkSize ) {
+        }
+
+        QByteArray waitForData() {
+            QByteArray chunk = m_data.left( m_chunkSize );
+            m_data.remove( 0, chunk.size() );
+            return chunk;
+        }
+
+    private:
+        QByteArray m_data;
+        int m_chunkSize;
+    };
+
+    QList<Result> readResults( StreamReader* reader )
+    {
+        QList<Result> results;
+        Result result;
+        while ( reader->readResult( &result ) ) {
+            results.append( result );
+        }
+        return results;
+    }
+
+    Binding binding( const Result& result, const QString& name )
+    {
+        Q_FOREACH( const Binding& b, result.bindingList() ) {
+            if ( b.name() == name ) {
+                return b;
+            }
+        }
+        return Binding();
+    }
+
+    QStringList variables( const StreamReader* reader )
+    {
+        QStringList names;
+        Q_FOREACH( const Variable& v, reader->head().variableList() ) {
+            names << v.name();
+        }
+        return names;
+    }
+
+    void addChunkSizes()
+    {
+        QTest::addColumn<int>( "chunkSize" );
+
+        // a chunk size of 1 splits every token and multi-byte character
+        QTest::newRow( "single bytes" ) << 1;
+        QTest::newRow( "small chunks" ) << 7;
+        QTest::newRow( "all at once" ) << 100000;
+    }
+}
+
+
+void SparqlResultParserTest::testJsonResults_data()
+{
+    addChunkSizes();
+}
+
+
+void SparqlResultParserTest::testJsonResults()
+{
+    QFETCH( int, chunkSize );
+
+    const QByteArray data =
+        "{ \"head\": { \"link\": [], \"vars\": [ \"s\", \"o\", \"x\" ] },\n"
+        "  \"results\": { \"distinct\": false, \"bindings\": [\n"
+        "    { \"s\": { \"type\": \"uri\", \"value\": \"http://soprano.org/test#A\" },\n"
+        "      \"o\": { \"type\": \"literal\", \"xml:lang\": \"fr\", \"value\": \"caf\xc3\xa9 \\\"quoted\\\" \\\\ a\\/b\\n\\u00e9 \\ud83d\\ude00\" } },\n"
+        "    { \"s\": { \"type\": \"bnode\", \"value\": \"b0\" },\n"
+        "      \"o\": { \"type\": \"literal\", \"datatype\": \"http://www.w3.org/2001/XMLSchema#integer\", \"value\": \"42\" },\n"
+        "      \"x\": { \"type\": \"typed-literal\", \"datatype\": \"http://www.w3.org/2001/XMLSchema#boolean\", \"value\": \"true\" } }\n"
+        "  ] } }\n";
+
+    JsonStreamReader reader( new ChunkedDataSource( data, chunkSize ) );
+    QVERIFY( reader.readHead() );
+    QCOMPARE( variables( &reader ), QStringList() << "s" << "o" << "x" );
+
+    QList<Result> results = readResults( &reader );
+    QVERIFY( !reader.hasError() );
+    QCOMPARE( results.count(), 2 );
+
+    QCOMPARE( binding( results[0], "s" ).type(), Binding::URI );
+    QCOMPARE( binding( results[0], "s" ).uri().uri(), QUrl( "http://soprano.org/test#A" ) );
+    QCOMPARE( binding( results[0], "o" ).type(), Binding::LITERAL );
+    QCOMPARE( binding( results[0], "o" ).literal().xml_lang(), QString( "fr" ) );
+    QCOMPARE( binding( results[0], "o" ).literal().data(),
+              QString::fromUtf8( "caf\xc3\xa9 \"quoted\" \\ a/b\n\xc3\xa9 \xf0\x9f\x98\x80" ) );
+
+    // optional values are simply missing
+    QCOMPARE( binding( results[0], "x" ).type(), Binding::NONE );
+
+    QCOMPARE( binding( results[1], "s" ).type(), Binding::BNODE );
+    QCOMPARE( binding( results[1], "s" ).bnode().id(), QString( "b0" ) );
+    QCOMPARE( binding( results[1], "o" ).literal().datatype(), Soprano::Vocabulary::XMLSchema::integer().toString() );
+    QCOMPARE( binding( results[1], "o" ).literal().data(), QString( "42" ) );
+    QCOMPARE( binding( results[1], "x" ).literal().datatype(), Soprano::Vocabulary::XMLSchema::boolean().toString() );
+}
+
+
+void SparqlResultParserTest::testJsonHeadAfterResults()
+{
+    // JSON does not define the order of object members
+    const QByteArray data =
+        "{ \"results\": { \"bindings\": [\n"
+        "    { \"s\": { \"type\": \"uri\", \"value\": \"http://soprano.org/test#A\" } },\n"
+        "    { \"s\": { \"type\": \"uri\", \"value\": \"http://soprano.org/test#B\" } }\n"
+        "  ] },\n"
+        "  \"head\": { \"vars\": [ \"s\" ] } }\n";
+
+    JsonStreamReader reader( new ChunkedDataSource( data, 5 ) );
+    QVERIFY( reader.readHead() );
+    QCOMPARE( variables( &reader ), QStringList() << "s" );
+
+    QList<Result> results = readResults( &reader );
+    QVERIFY( !reader.hasError() );
+    QCOMPARE( results.count(), 2 );
+    QCOMPARE( binding( results[1], "s" ).uri().uri(), QUrl( "http://soprano.org/test#B" ) );
+}
+
+
+void SparqlResultParserTest::testJsonBoolean()
+{
+    JsonStreamReader reader( new ChunkedDataSource( "{ \"head\": {}, \"boolean\": true }", 3 ) );
+    QVERIFY( reader.readHead() );
+    QVERIFY( reader.boolean().isValid() );
+    QVERIFY( reader.boolean().value() );
+
+    Result result;
+    QVERIFY( !reader.readResult( &result ) );
+}
+
+
+void SparqlResultParserTest::testJsonErrors()
+{
+    // results without a head cannot be used
+    JsonStreamReader noHead( new ChunkedDataSource( "{ \"results\": { \"bindings\": [] } }", 100 ) );
+    QVERIFY( !noHead.readHead() );
+    QVERIFY( noHead.hasError() );
+
+    // invalid escape sequence in a result
+    JsonStreamReader badEscape( new ChunkedDataSource( "{ \"head\": { \"vars\": [ \"o\" ] }, \"results\": { \"bindings\": [ "
+                                                       "{ \"o\": { \"type\": \"literal\", \"value\": \"\\x\" } } ] } }", 100 ) );
+    QVERIFY( badEscape.readHead() );
+    QVERIFY( readResults( &badEscape ).isEmpty() );
+    QVERIFY( badEscape.hasError() );
+
+    // truncated data
+    JsonStreamReader truncated( new ChunkedDataSource( "{ \"head\": { \"vars\": [ \"o\" ] }, \"results\": { \"bindings\": [ "
+                                                       "{ \"o\": { \"type\": \"literal\", \"value\": \"trunc", 100 ) );
+    QVERIFY( truncated.readHead() );
+    QVERIFY( readResults( &truncated ).isEmpty() );
+    QVERIFY( truncated.hasError() );
+}
+
+
+void SparqlResultParserTest::testTsvResults_data()
+{
+    addChunkSizes();
+}
+
+
+void SparqlResultParserTest::testTsvResults()
+{
+    QFETCH( int, chunkSize );
+
+    const QByteArray data =
+        "?s\t?o\t?x\n"
+        "<http://soprano.org/test#A>\t\"say \\\"caf\xc3\xa9\\\"\\nbye\"@fr\t\n"
+        "_:b0\t\"5\"^^<http://www.w3.org/2001/XMLSchema#int>\t42\r\n"
+        "<http://soprano.org/test#B>\ttrue\t1.5\n";
+
+    TsvStreamReader reader( new ChunkedDataSource( data, chunkSize ) );
+    QVERIFY( reader.readHead() );
+    QCOMPARE( variables( &reader ), QStringList() << "s" << "o" << "x" );
+
+    QList<Result> results = readResults( &reader );
+    QVERIFY( !reader.hasError() );
+    QCOMPARE( results.count(), 3 );
+
+    QCOMPARE( binding( results[0], "s" ).uri().uri(), QUrl( "http://soprano.org/test#A" ) );
+    QCOMPARE( binding( results[0], "o" ).literal().data(), QString::fromUtf8( "say \"caf\xc3\xa9\"\nbye" ) );
+    QCOMPARE( binding( results[0], "o" ).literal().xml_lang(), QString( "fr" ) );
+    QCOMPARE( binding( results[0], "x" ).type(), Binding::NONE );
+
+    QCOMPARE( binding( results[1], "s" ).bnode().id(), QString( "b0" ) );
+    QCOMPARE( binding( results[1], "o" ).literal().datatype(), Soprano::Vocabulary::XMLSchema::xsdInt().toString() );
+    QCOMPARE( binding( results[1], "o" ).literal().data(), QString( "5" ) );
+    QCOMPARE( binding( results[1], "x" ).literal().datatype(), Soprano::Vocabulary::XMLSchema::integer().toString() );
+
+    QCOMPARE( binding( results[2], "o" ).literal().datatype(), Soprano::Vocabulary::XMLSchema::boolean().toString() );
+    QCOMPARE( binding( results[2], "x" ).literal().datatype(), Soprano::Vocabulary::XMLSchema::decimal().toString() );
+}
+
+
+void SparqlResultParserTest::testTsvFieldCount()
+{
+    TsvStreamReader reader( new ChunkedDataSource( "?s\t?o\n<http://soprano.org/test#A>\t1\n<http://soprano.org/test#B>\n", 4 ) );
+    QVERIFY( reader.readHead() );
+
+    Result result;
+    QVERIFY( reader.readResult( &result ) );
+    QVERIFY( !reader.readResult( &result ) );
+    QVERIFY( reader.hasError() );
+
+    // no variables in the first line: not a TSV result
+    TsvStreamReader noHead( new ChunkedDataSource( "<http://soprano.org/test#A>\t1\n", 4 ) );
+    QVERIFY( !noHead.readHead() );
+}
+
+
+void SparqlResultParserTest::testXmlFallback()
+{
+    // graph results are handed to the RDF parsers in full
+    const QByteArray data =
+        "<?xml version=\"1.0\"?>\n"
+        "<rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\" xmlns:t=\"http://soprano.org/test#\">\n"
+        "  <rdf:Description rdf:about=\"http://soprano.org/test#A\"><t:p>caf\xc3\xa9</t:p></rdf:Description>\n"
+        "</rdf:RDF>\n";
+
+    XmlStreamReader reader( new ChunkedDataSource( data, 16 ) );
+    QVERIFY( !reader.readHead() );
+    QCOMPARE( reader.readAll(), data );
+}
+
+
+void SparqlResultParserTest::testXmlResults_data()
+{
+    addChunkSizes();
+}
+
+
+void SparqlResultParserTest::testXmlResults()
+{
+    QFETCH( int, chunkSize );
+
+    const QByteArray data =
+        "<?xml version=\"1.0\"?>\n"
+        "<sparql xmlns=\"http://www.w3.org/2005/sparql-results#\">\n"
+        "  <head><variable name=\"s\"/><variable name=\"o\"/><variable name=\"x\"/><link href=\"meta\"/></head>\n"
+        "  <results>\n"
+        "    <result>\n"
+        "      <binding name=\"s\"><uri>http://soprano.org/test#A</uri></binding>\n"
+        "      <binding name=\"o\"><literal xml:lang=\"fr\">caf\xc3\xa9 &amp; &lt;\xf0\x9f\x98\x80&gt;</literal></binding>\n"
+        "    </result>\n"
+        "    <result>\n"
+        "      <binding name=\"s\"><bnode>b0</bnode></binding>\n"
+        "      <binding name=\"o\"><literal datatype=\"http://www.w3.org/2001/XMLSchema#integer\">42</literal></binding>\n"
+        "      <binding name=\"x\"><unbound/></binding>\n"
+        "    </result>\n"
+        "  </results>\n"
+        "</sparql>\n";
+
+    XmlStreamReader reader( new ChunkedDataSource( data, chunkSize ) );
+    QVERIFY( reader.readHead() );
+    QCOMPARE( variables( &reader ), QStringList() << "s" << "o" << "x" );
+
+    QList<Result> results = readResults( &reader );
+    QVERIFY( !reader.hasError() );
+    QCOMPARE( results.count(), 2 );
+
+    QCOMPARE( binding( results[0], "s" ).uri().uri(), QUrl( "http://soprano.org/test#A" ) );
+    QCOMPARE( binding( results[0], "o" ).literal().xml_lang(), QString( "fr" ) );
+    QCOMPARE( binding( results[0], "o" ).literal().data(), QString::fromUtf8( "caf\xc3\xa9 & <\xf0\x9f\x98\x80>" ) );
+    QCOMPARE( binding( results[0], "x" ).type(), Binding::NONE );
+
+    QCOMPARE( binding( results[1], "s" ).bnode().id(), QString( "b0" ) );
+    QCOMPARE( binding( results[1], "o" ).literal().datatype(), Soprano::Vocabulary::XMLSchema::integer().toString() );
+    QCOMPARE( binding( results[1], "o" ).literal().data(), QString( "42" ) );
+    QCOMPARE( binding( results[1], "x" ).type(), Binding::UNBOUND );
+}
+
+
+void SparqlResultParserTest::testXmlBoolean()
+{
+    const QByteArray data =
+        "<?xml version=\"1.0\"?>\n"
+        "<sparql xmlns=\"http://www.w3.org/2005/sparql-results#\"><head/><boolean> true </boolean></sparql>";
+
+    XmlStreamReader reader( new ChunkedDataSource( data, 3 ) );
+    QVERIFY( reader.readHead() );
+    QVERIFY( !reader.hasError() );
+    QVERIFY( reader.boolean().isValid() );
+    QVERIFY( reader.boolean().value() );
+
+    Result result;
+    QVERIFY( !reader.readResult( &result ) );
+}
+
+
+void SparqlResultParserTest::testXmlErrors()
+{
+    // mismatched tags in a result
+    const QByteArray data =
+        "<sparql xmlns=\"http://www.w3.org/2005/sparql-results#\"><head><variable name=\"s\"/></head><results>"
+        "<result><binding name=\"s\"><uri>http://soprano.org/test#A</uri></binding></result>"
+        "<result><binding name=\"s\"><uri>http://soprano.org/test#B</bnode></binding></result>"
+        "</results></sparql>";
+
+    XmlStreamReader reader( new ChunkedDataSource( data, 10 ) );
+    QVERIFY( reader.readHead() );
+    QCOMPARE( readResults( &reader ).count(), 1 );
+    QVERIFY( reader.hasError() );
+
+    // no XML at all
+    XmlStreamReader noXml( new ChunkedDataSource( "{ \"head\": {} }", 10 ) );
+    QVERIFY( !noXml.readHead() );
+    QVERIFY( noXml.hasError() );
+}
+
+QTEST_MAIN( SparqlResultParserTest )
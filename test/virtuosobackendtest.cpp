@@ -24,6 +24,54 @@
 #include <soprano.h>
 
 #include <QtTest/QtTest>
+#include <QtCore/QThread>
+#include <QtCore/QSemaphore>
+#include <QtCore/QTime>
+
+namespace {
+    /**
+     * Runs one query in its own thread, ie. with its own connection,
+     * and optionally keeps the connection until released.
+     */
+    class ConnectionUser : public QThread
+    {
+    public:
+        ConnectionUser( Soprano::Model* model, bool hold )
+            : m_model( model ),
+              m_hold( hold ) {
+        }
+
+        bool waitForQuery() {
+            return m_queried.tryAcquire( 1, 10000 );
+        }
+
+        void release() {
+            m_release.release();
+        }
+
+        Soprano::Error::Error error() const {
+            return m_error;
+        }
+
+    protected:
+        void run() {
+            m_model->containsAnyStatement( Soprano::Statement() );
+            m_error = m_model->lastError();
+            m_queried.release();
+            if ( m_hold ) {
+                m_release.acquire();
+            }
+        }
+
+    private:
+        Soprano::Model* m_model;
+        bool m_hold;
+        Soprano::Error::Error m_error;
+        QSemaphore m_queried;
+        QSemaphore m_release;
+    };
+}
+
 
 Soprano::VirtuosoBackendTest::VirtuosoBackendTest()
     : m_modelCnt( 0 )
@@ -32,6 +80,12 @@ Soprano::VirtuosoBackendTest::VirtuosoBackendTest()
 
 
 Soprano::Model* Soprano::VirtuosoBackendTest::createModel()
+{
+    return createModel( BackendSettings() );
+}
+
+
+Soprano::Model* Soprano::VirtuosoBackendTest::createModel( const BackendSettings& userSettings )
 {
     const Soprano::Backend* b = Soprano::discoverBackendByName( "virtuosobackend" );
     if ( b ) {
@@ -47,6 +101,7 @@ Soprano::Model* Soprano::VirtuosoBackendTest::createModel()
 //         settings << BackendSetting( BackendOptionPort, 1111 );
 //         settings << BackendSetting( BackendOptionUsername, "dba" );
 //         settings << BackendSetting( BackendOptionPassword, "dba" );
+        settings << userSettings;
         Model* m = b->createModel( settings );
         m_settingsHash.insert( m, settings );
         return m;
@@ -71,5 +126,120 @@ void Soprano::VirtuosoBackendTest::deleteModel( Soprano::Model* m )
     }
 }
 
+
+void Soprano::VirtuosoBackendTest::testBatchAddStatements()
+{
+    QList<Statement> statements;
+    for ( int i = 0; i < 1200; ++i ) {
+        statements.append( Statement( QUrl( QString( "http://soprano.sf.net/test#batch%1" ).arg( i ) ),
+                                      QUrl( "http://soprano.sf.net/test#predicate" ),
+                                      LiteralValue( i ),
+                                      QUrl( "http://soprano.sf.net/test#graph" ) ) );
+    }
+    // blank nodes result in a different command
+    statements.insert( 600, Statement( m_model->createBlankNode(),
+                                       QUrl( "http://soprano.sf.net/test#predicate" ),
+                                       LiteralValue( "blank" ),
+                                       QUrl( "http://soprano.sf.net/test#graph" ) ) );
+
+    Error::ErrorCode r = Error::ErrorUnknown;
+    QVERIFY( QMetaObject::invokeMethod( m_model, "addStatements", Qt::DirectConnection,
+                                        Q_RETURN_ARG( Soprano::Error::ErrorCode, r ),
+                                        Q_ARG( QList<Soprano::Statement>, statements ) ) );
+    QCOMPARE( r, Error::ErrorNone );
+
+    Q_FOREACH( const Statement& s, statements ) {
+        QVERIFY( m_model->containsStatement( s ) );
+    }
+
+    // the invalid statement stops the batch
+    QList<Statement> invalid;
+    invalid << Statement( QUrl( "http://soprano.sf.net/test#a" ), QUrl( "http://soprano.sf.net/test#b" ), LiteralValue( "c" ) )
+            << Statement()
+            << Statement( QUrl( "http://soprano.sf.net/test#d" ), QUrl( "http://soprano.sf.net/test#e" ), LiteralValue( "f" ) );
+    QVERIFY( QMetaObject::invokeMethod( m_model, "addStatements", Qt::DirectConnection,
+                                        Q_RETURN_ARG( Soprano::Error::ErrorCode, r ),
+                                        Q_ARG( QList<Soprano::Statement>, invalid ) ) );
+    QCOMPARE( r, Error::ErrorInvalidArgument );
+    QVERIFY( m_model->containsAnyStatement( invalid[0] ) );
+    QVERIFY( !m_model->containsAnyStatement( invalid[2] ) );
+}
+
+
+void Soprano::VirtuosoBackendTest::testConnectionWaitTimeout()
+{
+    BackendSettings settings;
+    settings << BackendSetting( "maxConnections", 2 )
+             << BackendSetting( "connectionWaitTimeout", 500 );
+    Model* model = createModel( settings );
+    QVERIFY( model );
+
+    // the main thread keeps its connection until the end of the test
+    model->statementCount();
+    QVERIFY( !model->lastError() );
+
+    ConnectionUser holder( model, true );
+    holder.start();
+    QVERIFY( holder.waitForQuery() );
+    QVERIFY( !holder.error() );
+
+    // both connections are taken
+    ConnectionUser waiter( model, false );
+    QTime time;
+    time.start();
+    waiter.start();
+    QVERIFY( waiter.wait( 10000 ) );
+    QVERIFY( waiter.error() );
+    QVERIFY( time.elapsed() >= 400 );
+
+    QVariantMap stats;
+    QVERIFY( QMetaObject::invokeMethod( model, "connectionPoolStatistics", Qt::DirectConnection,
+                                        Q_RETURN_ARG( QVariantMap, stats ) ) );
+    QCOMPARE( stats[QLatin1String( "connectionWaits" )].toLongLong(), qint64( 1 ) );
+    QCOMPARE( stats[QLatin1String( "connectionWaitTimeouts" )].toLongLong(), qint64( 1 ) );
+
+    holder.release();
+    QVERIFY( holder.wait( 10000 ) );
+    deleteModel( model );
+}
+
+
+void Soprano::VirtuosoBackendTest::testConnectionWait()
+{
+    BackendSettings settings;
+    settings << BackendSetting( "maxConnections", 2 )
+             << BackendSetting( "connectionWaitTimeout", 10000 );
+    Model* model = createModel( settings );
+    QVERIFY( model );
+
+    model->statementCount();
+    QVERIFY( !model->lastError() );
+
+    ConnectionUser holder( model, true );
+    holder.start();
+    QVERIFY( holder.waitForQuery() );
+
+    // the waiting thread gets the connection of the finished one
+    ConnectionUser waiter( model, false );
+    waiter.start();
+    QTest::qWait( 200 );
+    QVERIFY( waiter.isRunning() );
+    holder.release();
+    QVERIFY( holder.wait( 10000 ) );
+    QVERIFY( waiter.wait( 10000 ) );
+    QVERIFY( !waiter.error() );
+
+    // the connection of the holder was reused instead of opening a third one
+    QVariantMap stats;
+    QVERIFY( QMetaObject::invokeMethod( model, "connectionPoolStatistics", Qt::DirectConnection,
+                                        Q_RETURN_ARG( QVariantMap, stats ) ) );
+    QCOMPARE( stats[QLatin1String( "connectionsCreated" )].toLongLong(), qint64( 2 ) );
+    QCOMPARE( stats[QLatin1String( "connectionsReused" )].toLongLong(), qint64( 1 ) );
+    QCOMPARE( stats[QLatin1String( "connectionWaits" )].toLongLong(), qint64( 1 ) );
+    QCOMPARE( stats[QLatin1String( "connectionWaitTimeouts" )].toLongLong(), qint64( 0 ) );
+
+    deleteModel( model );
+}
+
 QTEST_MAIN( Soprano::VirtuosoBackendTest )
 
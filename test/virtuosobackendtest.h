@@ -38,11 +38,18 @@ namespace Soprano {
     public:
         VirtuosoBackendTest();
 
+    private Q_SLOTS:
+        void testBatchAddStatements();
+        void testConnectionWaitTimeout();
+        void testConnectionWait();
+
     protected:
         virtual Soprano::Model* createModel();
         void deleteModel( Soprano::Model* m );
 
     private:
+        Soprano::Model* createModel( const Soprano::BackendSettings& userSettings );
+
         int m_modelCnt;
         QHash<Soprano::Model*, Soprano::BackendSettings> m_settingsHash;
     };
@@ -39,6 +39,8 @@
 #include "../soprano/parser.h"
 #include "../soprano/serializer.h"
 #include "../soprano/storagemodel.h"
+#include "../soprano/filtermodel.h"
+#include "../soprano/backend.h"
 #include "../soprano/vocabulary.h"
 #define USING_SOPRANO_NRLMODEL_UNSTABLE_API
 #include "../soprano/nrlmodel.h"
@@ -359,6 +361,89 @@ namespace {
     }
 
 
+    /**
+     * Bulk imports into persistent storages are a lot faster if the backend
+     * does not sync after each statement. Backends supporting the "batchWrites"
+     * user feature allow to defer that.
+     *
+     * \return The model to call startBatch() and commitBatch() on or 0 if not supported.
+     */
+    Soprano::Model* findBatchModel( Soprano::Model* model )
+    {
+        while ( Soprano::FilterModel* filterModel = qobject_cast<Soprano::FilterModel*>( model ) ) {
+            model = filterModel->parentModel();
+        }
+        Soprano::StorageModel* storageModel = qobject_cast<Soprano::StorageModel*>( model );
+        if ( storageModel &&
+             storageModel->backend() &&
+             storageModel->backend()->supportedUserFeatures().contains( QLatin1String( "batchWrites" ) ) ) {
+            return storageModel;
+        }
+        return 0;
+    }
+
+
+    /**
+     * Backends supporting the "bulkAdd" user feature (Virtuoso and Sesame2) add lists
+     * of statements with far fewer round trips or transactions via their invokable
+     * addStatements() method.
+     *
+     * The method bypasses filter models like the index which thus have to be
+     * fed statement by statement.
+     *
+     * \return The model to call addStatements() on or 0 if not supported.
+     */
+    Soprano::Model* findBulkAddModel( Soprano::Model* model )
+    {
+        Soprano::StorageModel* storageModel = qobject_cast<Soprano::StorageModel*>( model );
+        if ( storageModel &&
+             storageModel->backend() &&
+             storageModel->backend()->supportedUserFeatures().contains( QLatin1String( "bulkAdd" ) ) ) {
+            return storageModel;
+        }
+        return 0;
+    }
+
+
+    /// the number of statements handed to the backend at once in bulk mode
+    const int s_bulkAddSize = 1000;
+
+
+    bool bulkAddStatements( Soprano::Model* model, const QList<Soprano::Statement>& statements )
+    {
+        Soprano::Error::ErrorCode r = Soprano::Error::ErrorUnknown;
+        if ( !QMetaObject::invokeMethod( model, "addStatements", Qt::DirectConnection,
+                                         Q_RETURN_ARG( Soprano::Error::ErrorCode, r ),
+                                         Q_ARG( QList<Soprano::Statement>, statements ) ) ||
+             r != Soprano::Error::ErrorNone ) {
+            QTextStream s( stderr );
+            s << "Failed to import " << statements.count() << " statements: " << model->lastError() << endl;
+            return false;
+        }
+        return true;
+    }
+
+
+    class BatchLocker
+    {
+    public:
+        BatchLocker( Soprano::Model* model )
+            : m_model( findBatchModel( model ) ) {
+            if ( m_model ) {
+                QMetaObject::invokeMethod( m_model, "startBatch", Qt::DirectConnection );
+            }
+        }
+        ~BatchLocker() {
+            if ( m_model ) {
+                QMetaObject::invokeMethod( m_model, "commitBatch", Qt::DirectConnection );
+            }
+        }
+
+    private:
+        Soprano::Model* m_model;
+    };
+
+
     int importFile( Soprano::Model* model, const QString& fileName, const QString& serialization )
     {
         Soprano::NRLModel* nrlModel = qobject_cast<Soprano::NRLModel*>( model );
@@ -378,6 +463,10 @@ namespace {
                 return 2;
             }
 
+            BatchLocker batchLocker( model );
+            Soprano::Model* bulkModel = findBulkAddModel( model );
+            QList<Statement> bulk;
+
             int cnt = 0;
             while ( it.next() ) {
                 //
@@ -394,7 +483,17 @@ namespace {
                     statement.setContext( graph );
                 }
 
-                if ( model->addStatement( statement ) == Soprano::Error::ErrorNone ) {
+                if ( bulkModel ) {
+                    bulk.append( statement );
+                    if ( bulk.count() >= s_bulkAddSize ) {
+                        if ( !bulkAddStatements( bulkModel, bulk ) ) {
+                            return 2;
+                        }
+                        cnt += bulk.count();
+                        bulk.clear();
+                    }
+                }
+                else if ( model->addStatement( statement ) == Soprano::Error::ErrorNone ) {
                     ++cnt;
                 }
                 else {
@@ -404,6 +503,13 @@ namespace {
                 }
             }
 
+            if ( !bulk.isEmpty() ) {
+                if ( !bulkAddStatements( bulkModel, bulk ) ) {
+                    return 2;
+                }
+                cnt += bulk.count();
+            }
+
             QTextStream s( stderr );
             s << "Imported " << cnt << " statements." << endl;
             return 0;